@@ -0,0 +1,854 @@
+// implus_bench drives scripted frames through ImPlus widgets in a headless
+// ImGui context (no host window, no GPU) and reports the cost of a frame as
+// JSON:
+//
+//     implus_bench [--frames N] [--warmup N] [scenario...]
+//
+// For each scenario and item count the output has the average wall time of a
+// frame (NewFrame to Render), the heap allocations per frame split by the
+// allocation tracker scopes and the draw list counts of the last frame. No
+// renderer runs, est_upload_bytes and est_state_changes are estimated from the
+// draw data: the size of its vertices and indices, and the texture binds and
+// scissor changes left after eliding the ones that repeat the previous draw
+// command, as the GL3 streaming path does.
+//
+// With --alloc-budget N the exit code is 1 when a frame after the warmup
+// allocates more than N times. With --check-draw-calls the exit code is 1 when
+// the draw calls of a batched scenario grow with the item count. The icons
+// scenario draws icons of the raster cache, baked into the font atlas after
+// a first frame.
+//
+// With --advance-tables the bench instead compares glyph advance lookups of
+// the two-level advance table with a flat array indexed by codepoint, like
+// ImFont::IndexAdvanceX, for CJK and icon font glyph sets, and reports the
+// time per lookup and the memory of both layouts.
+//
+// With --sdf-diff FONT the bench instead renders the ASCII glyphs of the font
+// file at several zoom levels from the bitmap atlas and from the distance
+// field atlas (see Font::SetDistanceFieldAtlas), rasterized by the software
+// renderer, and reports the Setup time of both and how much the images
+// differ. With --max-diff N the exit code is 1 when the mean difference of a
+// zoom level exceeds N (of 255) or no distance field atlas was built, with
+// --diff-images DIR the images and their difference are written as PGM files.
+
+#define IMGUI_DEFINE_MATH_OPERATORS
+#include <imgui.h>
+#include <imgui_internal.h>
+
+#include <implus/alloc-tracker.hpp>
+#include <implus/buttonbar.hpp>
+#include <implus/dlg.hpp>
+#include <implus/flow.hpp>
+#include <implus/font.hpp>
+#include <implus/icon.hpp>
+#include <implus/listbox.hpp>
+#include <implus/menu.hpp>
+#include <implus/splitter.hpp>
+#include <implus/toolbar.hpp>
+
+#include "internal/advance-table.hpp"
+#include "internal/distance-field.hpp"
+#include "internal/raster.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using namespace ImPlus;
+
+struct scenario {
+    char const* name;
+    std::function<void(int items)> frame;
+    bool batched = false; // draw calls must not depend on the item count
+    bool bakes_icons = false; // the atlas is rebuilt with the icons of a first frame
+};
+
+struct result {
+    std::string name;
+    int items = 0;
+    int frames = 0;
+    double ns_per_frame = 0.0;
+    double allocs_per_frame = 0.0;
+    double bytes_per_frame = 0.0;
+    std::size_t max_allocs_per_frame = 0;
+    std::vector<std::pair<char const*, double>> alloc_scopes; // allocations per frame
+    int vertices = 0;
+    int indices = 0;
+    int draw_calls = 0;
+    std::size_t est_upload_bytes = 0; // estimated from the draw data
+    int est_state_changes = 0;        // estimated from the draw data
+};
+
+auto labels = std::vector<std::string>{};
+
+auto label(int i) -> std::string const& { return labels[std::size_t(i) % labels.size()]; }
+
+void begin_host_window()
+{
+    auto const& io = ImGui::GetIO();
+    ImGui::SetNextWindowPos({0, 0});
+    ImGui::SetNextWindowSize(io.DisplaySize);
+    ImGui::Begin("##bench", nullptr,
+        ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoMove |
+            ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoBringToFrontOnFocus);
+}
+
+void toolbar_frame(int items)
+{
+    begin_host_window();
+    if (Toolbar::Begin("##toolbar", Axis::Horz)) {
+        for (auto i = 0; i < items; ++i) {
+            ImGui::PushID(i);
+            Toolbar::Button(label(i).c_str(), i == 1, i % 7 != 3);
+            ImGui::PopID();
+            if (i % 8 == 7)
+                Toolbar::Separator();
+        }
+        Toolbar::End();
+    }
+    ImGui::End();
+}
+
+void buttonbar_frame(int items)
+{
+    begin_host_window();
+    auto buttons = std::vector<Buttonbar::Button>{};
+    buttons.reserve(std::size_t(items));
+    for (auto i = 0; i < items; ++i)
+        buttons.push_back({.Content = label(i).c_str(), .Enabled = i % 5 != 4});
+    Buttonbar::Display("##buttonbar", buttons);
+    ImGui::End();
+}
+
+void listbox_boxes(std::vector<int> const& data)
+{
+    Listbox::Boxes(
+        "##listbox", data, [](int v) { return v % 10 == 0; },
+        [](int v, Listbox::BoxContent& box) {
+            box.Size = {64.0f, 48.0f};
+            box.DrawProc = [v](ImDrawList* dl, ImVec2 const& bb_min, ImVec2 const& bb_max,
+                               ColorSet const& clr) {
+                auto const& s = label(v);
+                dl->AddRect(bb_min, bb_max, ImGui::GetColorU32(clr.Content));
+                dl->AddText(bb_min + ImVec2{4.0f, 4.0f}, ImGui::GetColorU32(clr.Content), s.data(),
+                    s.data() + s.size());
+            };
+        });
+}
+
+void listbox_frame(int items)
+{
+    static auto data = std::vector<int>{};
+    data.resize(std::size_t(items));
+    for (auto i = 0; i < items; ++i)
+        data[std::size_t(i)] = i;
+
+    begin_host_window();
+    listbox_boxes(data);
+    ImGui::End();
+}
+
+// a large listbox in a child window scrolled by a few rows every frame, so
+// that the visible geometry changes each frame
+void scroll_frame(int items)
+{
+    static auto data = std::vector<int>{};
+    data.resize(std::size_t(items) * 8);
+    for (auto i = std::size_t{0}; i < data.size(); ++i)
+        data[i] = int(i);
+
+    begin_host_window();
+    if (ImGui::BeginChild("##scroll")) {
+        auto const max_y = ImGui::GetScrollMaxY();
+        auto const y = ImGui::GetScrollY() + 40.0f;
+        ImGui::SetScrollY(max_y > 0.0f && y <= max_y ? y : 0.0f);
+        listbox_boxes(data);
+    }
+    ImGui::EndChild();
+    ImGui::End();
+}
+
+void flow_frame(int items)
+{
+    begin_host_window();
+    {
+        auto flow = Flow{"##flow", 30_em};
+        for (auto i = 0; i < items; ++i) {
+            if (i % 2)
+                flow.Paragraph("The quick brown fox jumps over the lazy dog, and then it jumps "
+                               "back again to see whether the dog has noticed anything at all.");
+            else
+                flow.TextField(label(i).c_str(), label(i + 1));
+        }
+    }
+    ImGui::End();
+}
+
+void splitter_frame(int items)
+{
+    begin_host_window();
+    auto splitter = Splitter{};
+    splitter.push_back(detail::BandSize{.Desired = 12_em, .Minimum = 4_em});
+    splitter.push_back(detail::BandSize{.Desired = 20_em, .Minimum = 4_em});
+    splitter.push_back(detail::BandSize{.Desired = 12_em, .Minimum = 4_em});
+
+    // the bands share the items
+    auto content = [items](int band) {
+        return [items, band] {
+            for (auto i = band; i < items; i += 3)
+                ImGui::TextUnformatted(label(i).c_str());
+        };
+    };
+    splitter.Display({content(0), content(1), content(2)});
+    ImGui::End();
+}
+
+void menu_frame(int items)
+{
+    if (BeginMainMenuBar()) {
+        for (auto i = 0; i < std::min(items, 8); ++i) {
+            if (BeginMenu(label(i).c_str()))
+                EndMenu();
+        }
+        EndMainMenuBar();
+    }
+
+    // menu items are laid out in an always open popup
+    auto const id = ImGui::GetID("##menu-popup");
+    if (!ImGui::IsPopupOpen(id, ImGuiPopupFlags_None))
+        ImGui::OpenPopupEx(id, ImGuiPopupFlags_None);
+    ImGui::SetNextWindowPos({32, 32});
+    if (ImGui::BeginPopupEx(id, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoTitleBar |
+                                    ImGuiWindowFlags_NoSavedSettings)) {
+        for (auto i = 0; i < items; ++i)
+            MenuItem(ImGuiID(i + 1), {}, label(i), i % 4 ? "" : "Ctrl+K", i == 2, i % 9 != 8);
+        ImGui::EndPopup();
+    }
+}
+
+void dlg_frame(int items)
+{
+    auto const id = ImGui::GetID("##dlg");
+    if (!ImGui::IsPopupOpen(id, ImGuiPopupFlags_None))
+        ImGui::OpenPopup(id);
+    if (Dlg::Begin(id, {.Title = "Benchmark"})) {
+        {
+            auto flow = Flow{"##dlg-flow", 20_em};
+            for (auto i = 0; i < items; ++i)
+                flow.TextField(label(i).c_str(), label(i + 3));
+        }
+        Dlg::Buttons({"OK", "Cancel"},
+            Buttonbar::Flags::FirstIsDefault | Buttonbar::Flags::LastIsCancel);
+        Dlg::End();
+    }
+}
+
+// glyph icons with overlays next to ellipsified text, all of it shares the
+// font atlas and the clip rect of the host window
+void glyphs_frame(int items)
+{
+    static auto const icon = Icon{Glyph{"#"}} + IconOverlay{Glyph{"*"}} + IconOverlay{Glyph{"."}};
+    // text blocks refer to their text
+    static auto texts = std::vector<std::string>{};
+    static auto blocks = std::vector<TextBlock>{};
+    if (blocks.empty()) {
+        for (auto const& s : labels)
+            texts.push_back(s + " that does not fit");
+        for (auto const& s : texts)
+            blocks.emplace_back(s, ImVec2{0.0f, 0.0f},
+                Text::OverflowPolicy{.Behavior = Text::OverflowEllipsify}, 80.0f);
+    }
+
+    begin_host_window();
+    auto const dl = ImGui::GetWindowDrawList();
+    auto const clr = ImGui::GetColorU32(ImGuiCol_Text);
+    auto const icon_w = icon.Measure().x + 4.0f;
+    for (auto i = 0; i < items; ++i) {
+        auto const& block = blocks[std::size_t(i) % blocks.size()];
+        auto const pos = ImGui::GetCursorScreenPos();
+        icon.Draw(dl, pos, clr);
+        block.Render(dl, pos + ImVec2{icon_w, 0.0f}, clr);
+        ImGui::Dummy({icon_w + block.Size.x, block.Size.y});
+    }
+    ImGui::End();
+}
+
+// builtin shapes and custom icons from the raster cache next to text, the
+// baked icons are quads of the font texture like the text
+void icons_frame(int items)
+{
+    static auto const icons = std::vector<Icon>{
+        Icon{Icon::Builtin::Circle},
+        Icon{Icon::Builtin::Box},
+        Icon{Icon::Builtin::DotDotDot},
+        Icon{Icon::Placeholder(1_em, 1_em)},
+    };
+
+    begin_host_window();
+    auto const dl = ImGui::GetWindowDrawList();
+    auto const clr = ImGui::GetColorU32(ImGuiCol_Text);
+    for (auto i = 0; i < items; ++i) {
+        auto const& icon = icons[std::size_t(i) % icons.size()];
+        auto const pos = ImGui::GetCursorScreenPos();
+        auto const icon_w = icon.Measure().x + 4.0f;
+        icon.Draw(dl, pos, clr);
+        auto const& s = label(i);
+        dl->AddText(pos + ImVec2{icon_w, 0.0f}, clr, s.data(), s.data() + s.size());
+        ImGui::Dummy({icon_w + ImGui::CalcTextSize(s.c_str()).x, ImGui::GetFontSize()});
+    }
+    ImGui::End();
+}
+
+// glyph advance lookups
+
+struct lookup_result {
+    char const* glyph_set;
+    char const* layout;
+    int glyphs = 0;
+    double ns_per_lookup = 0.0;
+    std::size_t bytes = 0;
+};
+
+// glyph_set fills a font with glyphs of varying advances for the codepoints
+// [lo, hi] in steps of step
+void glyph_set(ImFont& font, unsigned lo, unsigned hi, unsigned step)
+{
+    for (auto c = lo; c <= hi; c += step) {
+        font.Glyphs.push_back(ImFontGlyph{});
+        auto& g = font.Glyphs.back();
+        g.Codepoint = c;
+        g.Visible = 1;
+        g.AdvanceX = float(8 + c % 7);
+    }
+}
+
+auto run_lookups(char const* name, ImFont const& font, int lookups)
+    -> std::pair<lookup_result, lookup_result>
+{
+    // the flat layout mirrors ImFont::BuildLookupTable, one float per
+    // codepoint up to the highest glyph
+    auto max_c = 0u;
+    for (auto const& g : font.Glyphs)
+        max_c = std::max(max_c, unsigned(g.Codepoint));
+    auto flat = std::vector<float>(std::size_t(max_c) + 1, font.FallbackAdvanceX);
+    for (auto const& g : font.Glyphs)
+        flat[g.Codepoint] = g.AdvanceX;
+    auto const table = internal::advance_table{font};
+
+    // codepoints of the set in a scattered order, a few missing ones included
+    auto codepoints = std::vector<unsigned>(4096);
+    auto seed = std::uint32_t{12345};
+    for (auto& c : codepoints) {
+        seed = seed * 1664525u + 1013904223u;
+        auto const& g = font.Glyphs[int(seed >> 8) % font.Glyphs.Size];
+        c = unsigned(g.Codepoint) + (seed & 0x1f ? 0 : 1);
+    }
+
+    using clock = std::chrono::steady_clock;
+    auto measure = [&](auto&& lookup) {
+        auto sum = 0.0f;
+        auto const t0 = clock::now();
+        for (auto i = 0; i < lookups; ++i)
+            sum += lookup(codepoints[std::size_t(i) & (codepoints.size() - 1)]);
+        auto const ns = std::chrono::duration<double, std::nano>(clock::now() - t0).count();
+        // keeps the loop from being optimized away
+        if (sum < 0.0f)
+            std::fprintf(stderr, "%f\n", sum);
+        return ns / lookups;
+    };
+
+    auto const fallback = font.FallbackAdvanceX;
+    auto flat_ns = measure([&](unsigned c) { return c < flat.size() ? flat[c] : fallback; });
+    auto table_ns = measure([&](unsigned c) { return table(c); });
+
+    return {
+        {name, "flat", font.Glyphs.Size, flat_ns, flat.size() * sizeof(float)},
+        {name, "table", font.Glyphs.Size, table_ns, table.memory_usage()},
+    };
+}
+
+auto run_advance_tables(int lookups) -> std::vector<lookup_result>
+{
+    auto ret = std::vector<lookup_result>{};
+    auto add = [&](char const* name, auto&& fill) {
+        auto font = ImFont{};
+        font.FallbackAdvanceX = 8.0f;
+        glyph_set(font, 0x20, 0x7e, 1); // every set has ASCII
+        fill(font);
+        auto [flat, table] = run_lookups(name, font, lookups);
+        ret.push_back(flat);
+        ret.push_back(table);
+    };
+
+    // CJK unified ideographs with kana and fullwidth forms
+    add("cjk", [](ImFont& f) {
+        glyph_set(f, 0x3040, 0x30ff, 1);
+        glyph_set(f, 0x4e00, 0x9fff, 1);
+        glyph_set(f, 0xff00, 0xffef, 1);
+    });
+    // an icon font in the private use area of the BMP, sparsely populated
+    add("icons-bmp", [](ImFont& f) { glyph_set(f, 0xe000, 0xf8ff, 3); });
+    // an icon font in a supplementary private use plane
+    add("icons-plane15", [](ImFont& f) { glyph_set(f, 0xf0000, 0xf1af0, 1); });
+    return ret;
+}
+
+void print(std::vector<lookup_result> const& results)
+{
+    std::printf("[\n");
+    for (auto i = std::size_t{0}; i < results.size(); ++i) {
+        auto const& r = results[i];
+        std::printf("  {\"glyph_set\": \"%s\", \"layout\": \"%s\", \"glyphs\": %d, "
+                    "\"ns_per_lookup\": %.3f, \"bytes\": %zu}%s\n",
+            r.glyph_set, r.layout, r.glyphs, r.ns_per_lookup, r.bytes,
+            i + 1 < results.size() ? "," : "");
+    }
+    std::printf("]\n");
+}
+
+// distance field atlas against the bitmap atlas
+
+struct sdf_diff_result {
+    int zoom = 0; // percent of 96 DPI
+    float pixel_size = 0.0f;
+    double bitmap_setup_ms = 0.0;
+    double sdf_setup_ms = 0.0;
+    bool distance_field = false; // Setup built or kept a distance field atlas
+    bool rescaled = false;       // the distance field atlas was only rescaled
+    double mean_diff = 0.0;      // of 255, over all pixels
+    int max_diff = 0;
+    std::size_t differing_pixels = 0; // differences above 64
+    std::size_t pixels = 0;
+};
+
+// the atlas sampled by render_glyph_grid, texture ids are not looked at
+auto grid_texture = internal::rgba_texture{};
+
+// render_glyph_grid draws the printable ASCII glyphs of font white on black
+// in a grid of 16 columns, returns the red channel; the pen positions depend
+// on the font size only, so that the images of both atlases line up
+auto render_glyph_grid(ImFont& font, int& width, int& height) -> std::vector<std::uint8_t>
+{
+    auto& io = ImGui::GetIO();
+    unsigned char* pixels = nullptr;
+    auto tex_w = 0;
+    auto tex_h = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &tex_w, &tex_h);
+    io.Fonts->SetTexID(ImTextureID(std::intptr_t(1)));
+    grid_texture = {tex_w, tex_h, pixels, tex_w * 4, Font::DistanceFieldAtlas()};
+
+    auto const size = font.FontSize * font.Scale;
+    auto const cell = std::ceil(size * 1.5f);
+    width = int(cell) * 16;
+    height = int(cell) * 6;
+
+    auto dl = ImDrawList{ImGui::GetDrawListSharedData()};
+    dl._ResetForNewFrame();
+    dl.PushClipRect({0, 0}, {float(width), float(height)});
+    dl.PushTextureID(io.Fonts->TexID);
+    for (auto c = 0x20; c < 0x80; ++c) {
+        auto const k = c - 0x20;
+        auto const pos = ImVec2{float(k % 16), float(k / 16)} * cell;
+        font.RenderChar(&dl, size, pos + ImVec2{std::floor(cell / 4), 0.0f}, IM_COL32_WHITE,
+            ImWchar(c));
+    }
+
+    auto rgba = std::vector<std::uint8_t>(std::size_t(width) * height * 4);
+    for (std::size_t i = 3; i < rgba.size(); i += 4)
+        rgba[i] = 255;
+    internal::rasterize_rgba(dl, {0, 0}, {1, 1}, width, height, rgba.data(), width * 4,
+        [](ImTextureID) { return grid_texture; });
+    dl._ClearFreeMemory();
+
+    auto red = std::vector<std::uint8_t>(std::size_t(width) * height);
+    for (std::size_t i = 0; i < red.size(); ++i)
+        red[i] = rgba[i * 4];
+    return red;
+}
+
+// write_pgm writes a grayscale image for --diff-images
+void write_pgm(std::string const& path, int width, int height, std::uint8_t const* pixels)
+{
+    auto f = std::fopen(path.c_str(), "wb");
+    if (!f)
+        return;
+    std::fprintf(f, "P5\n%d %d\n255\n", width, height);
+    std::fwrite(pixels, 1, std::size_t(width) * height, f);
+    std::fclose(f);
+}
+
+// run_sdf_diff renders the same glyphs from a bitmap atlas rebuilt for each
+// zoom and from a distance field atlas built once and rescaled, and compares
+// the images; both are rasterized by the software renderer
+auto run_sdf_diff(char const* filename, char const* image_dir) -> std::vector<sdf_diff_result>
+{
+    auto ret = std::vector<sdf_diff_result>{};
+    auto const res = Font::Load(Font::FileInfo{filename}, {{0x20, 0x7e}}, 12.0f);
+    if (!res)
+        return ret;
+
+    // the software renderer draws distance fields, see host-render-null.cpp
+    internal::distance_field_renderer = true;
+
+    using clock = std::chrono::steady_clock;
+    auto const zooms = {100, 125, 150, 200, 300};
+    auto images = std::vector<std::vector<std::uint8_t>>{};
+    for (auto const sdf : {false, true}) {
+        Font::SetDistanceFieldAtlas(sdf);
+        auto i = std::size_t{0};
+        for (auto zoom : zooms) {
+            auto const t0 = clock::now();
+            Font::Setup(96.0f * float(zoom) / 100.0f, 1.0f);
+            auto const ms = std::chrono::duration<double, std::milli>(clock::now() - t0).count();
+
+            auto w = 0;
+            auto h = 0;
+            auto image = render_glyph_grid(*res.imfont(), w, h);
+            if (!sdf) {
+                auto& r = ret.emplace_back();
+                r.zoom = zoom;
+                r.pixel_size = res.imfont()->FontSize;
+                r.bitmap_setup_ms = ms;
+                r.pixels = image.size();
+                images.push_back(std::move(image));
+                continue;
+            }
+
+            auto& r = ret[i];
+            auto const& bitmap = images[i++];
+            r.sdf_setup_ms = ms;
+            r.distance_field = Font::DistanceFieldAtlas();
+            r.rescaled = Font::GetSetupTimings().Rescaled;
+            if (image.size() != bitmap.size())
+                continue; // the pixel sizes differ, nothing to compare
+
+            auto diff = std::vector<std::uint8_t>(image.size());
+            auto sum = 0.0;
+            for (std::size_t p = 0; p < image.size(); ++p) {
+                auto const d = std::abs(int(image[p]) - int(bitmap[p]));
+                diff[p] = std::uint8_t(d);
+                sum += d;
+                r.max_diff = std::max(r.max_diff, d);
+                r.differing_pixels += d > 64 ? 1 : 0;
+            }
+            r.mean_diff = sum / double(image.size());
+
+            if (image_dir) {
+                auto const base = std::string{image_dir} + "/sdf-diff-" + std::to_string(zoom);
+                write_pgm(base + "-bitmap.pgm", w, h, bitmap.data());
+                write_pgm(base + "-sdf.pgm", w, h, image.data());
+                write_pgm(base + "-diff.pgm", w, h, diff.data());
+            }
+        }
+    }
+
+    internal::distance_field_renderer = false;
+    Font::SetDistanceFieldAtlas(false);
+    return ret;
+}
+
+void print(std::vector<sdf_diff_result> const& results)
+{
+    std::printf("[\n");
+    for (auto i = std::size_t{0}; i < results.size(); ++i) {
+        auto const& r = results[i];
+        std::printf("  {\"zoom\": %d, \"pixel_size\": %.0f, \"bitmap_setup_ms\": %.3f, "
+                    "\"sdf_setup_ms\": %.3f, \"distance_field\": %s, \"rescaled\": %s, "
+                    "\"mean_diff\": %.3f, \"max_diff\": %d, \"differing_pixels\": %zu, "
+                    "\"pixels\": %zu}%s\n",
+            r.zoom, r.pixel_size, r.bitmap_setup_ms, r.sdf_setup_ms,
+            r.distance_field ? "true" : "false", r.rescaled ? "true" : "false", r.mean_diff,
+            r.max_diff, r.differing_pixels, r.pixels, i + 1 < results.size() ? "," : "");
+    }
+    std::printf("]\n");
+}
+
+// build_atlas builds the font atlas with the hooks of Font::Setup, so that
+// the icon raster cache bakes the icons it has seen, the texture is never
+// uploaded
+void build_atlas()
+{
+    auto& io = ImGui::GetIO();
+    io.Fonts->Clear();
+    io.Fonts->AddFontDefault();
+    for (auto&& cb : Font::OnAtlasPrepare)
+        cb(*io.Fonts);
+    io.Fonts->Build();
+    for (auto&& cb : Font::OnAtlasBuilt)
+        cb(*io.Fonts);
+
+    unsigned char* pixels = nullptr;
+    auto w = 0;
+    auto h = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &w, &h);
+    io.Fonts->SetTexID(ImTextureID(std::intptr_t(1)));
+    ResettableResource::ResetAll();
+}
+
+void setup_context()
+{
+    ImGui::CreateContext();
+    auto& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.LogFilename = nullptr;
+    io.DisplaySize = {1280.0f, 800.0f};
+    io.DeltaTime = 1.0f / 60.0f;
+
+    Icon::EnableRasterCache();
+    build_atlas();
+
+    for (auto i = 0; i < 64; ++i)
+        labels.push_back("Item " + std::to_string(i) + (i % 3 ? "" : " with a longer caption"));
+}
+
+auto run(scenario const& s, int items, int warmup, int frames) -> result
+{
+    auto frame = [&] {
+        ImGui::NewFrame();
+        s.frame(items);
+        ImGui::Render();
+    };
+
+    // nothing below allocates between the frames, so that the tracker counts
+    // the frames alone
+    using clock = std::chrono::steady_clock;
+    auto ret = result{.name = s.name, .items = items, .frames = frames};
+    auto elapsed = clock::duration{};
+    auto bytes = std::size_t{0};
+    auto scope_allocs = std::vector<std::size_t>{};
+    scope_allocs.reserve(64); // the tracker's scope limit
+
+    if (s.bakes_icons) {
+        frame();
+        build_atlas();
+    }
+
+    for (auto i = 0; i < warmup; ++i) {
+        frame();
+        AllocTracker::EndFrame();
+    }
+
+    for (auto i = 0; i < frames; ++i) {
+        auto const t0 = clock::now();
+        frame();
+        elapsed += clock::now() - t0;
+
+        AllocTracker::EndFrame();
+        auto const counts = AllocTracker::LastFrame();
+        ret.allocs_per_frame += double(counts.Allocations);
+        ret.max_allocs_per_frame = std::max(ret.max_allocs_per_frame, counts.Allocations);
+        bytes += counts.Bytes;
+
+        scope_allocs.resize(std::size_t(AllocTracker::ScopeCount()));
+        for (auto k = std::size_t{0}; k < scope_allocs.size(); ++k)
+            scope_allocs[k] += AllocTracker::LastFrame(int(k)).Allocations;
+    }
+
+    ret.ns_per_frame = std::chrono::duration<double, std::nano>(elapsed).count() / frames;
+    ret.allocs_per_frame /= frames;
+    ret.bytes_per_frame = double(bytes) / frames;
+    for (auto k = std::size_t{0}; k < scope_allocs.size(); ++k) {
+        if (scope_allocs[k])
+            ret.alloc_scopes.emplace_back(
+                AllocTracker::ScopeName(int(k)), double(scope_allocs[k]) / frames);
+    }
+
+    auto const dd = ImGui::GetDrawData();
+    if (dd && dd->Valid) {
+        ret.vertices = dd->TotalVtxCount;
+        ret.indices = dd->TotalIdxCount;
+        ret.est_upload_bytes = std::size_t(dd->TotalVtxCount) * sizeof(ImDrawVert) +
+                           std::size_t(dd->TotalIdxCount) * sizeof(ImDrawIdx);
+
+        // state changes a renderer that skips repeated texture binds and clip
+        // rects would make, the draw data doesn't know the actual GL state
+        auto known = false;
+        auto tex = ImTextureID{};
+        auto clip = ImVec4{};
+        for (auto i = 0; i < dd->CmdListsCount; ++i) {
+            for (auto const& cmd : dd->CmdLists[i]->CmdBuffer) {
+                if (cmd.ElemCount || cmd.UserCallback)
+                    ++ret.draw_calls;
+                if (cmd.UserCallback) {
+                    known = false;
+                    continue;
+                }
+                if (!cmd.ElemCount)
+                    continue;
+                if (!known || cmd.TextureId != tex)
+                    ++ret.est_state_changes;
+                if (!known || std::memcmp(&cmd.ClipRect, &clip, sizeof(clip)) != 0)
+                    ++ret.est_state_changes;
+                tex = cmd.TextureId;
+                clip = cmd.ClipRect;
+                known = true;
+            }
+        }
+    }
+    return ret;
+}
+
+void print(std::vector<result> const& results)
+{
+    std::printf("[\n");
+    for (auto i = std::size_t{0}; i < results.size(); ++i) {
+        auto const& r = results[i];
+        std::printf("  {\"name\": \"%s\", \"items\": %d, \"frames\": %d, \"ns_per_frame\": %.0f, "
+                    "\"allocs_per_frame\": %.2f, \"max_allocs_per_frame\": %zu, "
+                    "\"bytes_per_frame\": %.0f, \"alloc_scopes\": {",
+            r.name.c_str(), r.items, r.frames, r.ns_per_frame, r.allocs_per_frame,
+            r.max_allocs_per_frame, r.bytes_per_frame);
+        for (auto k = std::size_t{0}; k < r.alloc_scopes.size(); ++k) {
+            std::printf("%s\"%s\": %.2f", k ? ", " : "", r.alloc_scopes[k].first,
+                r.alloc_scopes[k].second);
+        }
+        std::printf("}, \"vertices\": %d, \"indices\": %d, \"draw_calls\": %d, "
+                    "\"est_upload_bytes\": %zu, \"est_state_changes\": %d}%s\n",
+            r.vertices, r.indices, r.draw_calls, r.est_upload_bytes, r.est_state_changes,
+            i + 1 < results.size() ? "," : "");
+    }
+    std::printf("]\n");
+}
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int
+{
+    auto frames = 300;
+    auto warmup = 30;
+    auto alloc_budget = std::optional<std::size_t>{};
+    auto check_draw_calls = false;
+    auto advance_tables = false;
+    auto sdf_font = static_cast<char const*>(nullptr);
+    auto max_diff = std::optional<double>{};
+    auto diff_images = static_cast<char const*>(nullptr);
+    auto filter = std::vector<std::string_view>{};
+
+    for (auto i = 1; i < argc; ++i) {
+        auto arg = std::string_view{argv[i]};
+        if (arg == "--frames" && i + 1 < argc)
+            frames = std::max(std::atoi(argv[++i]), 1);
+        else if (arg == "--warmup" && i + 1 < argc)
+            warmup = std::max(std::atoi(argv[++i]), 0);
+        else if (arg == "--alloc-budget" && i + 1 < argc)
+            alloc_budget = std::size_t(std::max(std::atoi(argv[++i]), 0));
+        else if (arg == "--check-draw-calls")
+            check_draw_calls = true;
+        else if (arg == "--advance-tables")
+            advance_tables = true;
+        else if (arg == "--sdf-diff" && i + 1 < argc)
+            sdf_font = argv[++i];
+        else if (arg == "--max-diff" && i + 1 < argc)
+            max_diff = std::max(std::atof(argv[++i]), 0.0);
+        else if (arg == "--diff-images" && i + 1 < argc)
+            diff_images = argv[++i];
+        else if (arg.starts_with("-")) {
+            std::fprintf(stderr,
+                "usage: %s [--frames N] [--warmup N] [--alloc-budget N] [--check-draw-calls] "
+                "[--advance-tables] [--sdf-diff FONT [--max-diff N] [--diff-images DIR]] "
+                "[scenario...]\n",
+                argv[0]);
+            return 2;
+        }
+        else
+            filter.push_back(arg);
+    }
+
+    auto const scenarios = std::vector<scenario>{
+        {"toolbar", toolbar_frame},
+        {"buttonbar", buttonbar_frame},
+        {"listbox", listbox_frame},
+        {"scroll", scroll_frame},
+        {"flow", flow_frame},
+        {"splitter", splitter_frame},
+        {"menu", menu_frame},
+        {"dlg", dlg_frame},
+        {"glyphs", glyphs_frame, true},
+        {"icons", icons_frame, true, true},
+    };
+
+    setup_context();
+
+    if (advance_tables) {
+        auto const lookups = run_advance_tables(10'000'000);
+        ImGui::DestroyContext();
+        print(lookups);
+        return 0;
+    }
+
+    if (sdf_font) {
+        auto const diffs = run_sdf_diff(sdf_font, diff_images);
+        ImGui::DestroyContext();
+        if (diffs.empty()) {
+            std::fprintf(stderr, "%s: the font could not be loaded\n", sdf_font);
+            return 2;
+        }
+        print(diffs);
+
+        auto over = false;
+        for (auto const& r : diffs) {
+            if (!max_diff || (r.distance_field && r.mean_diff <= *max_diff))
+                continue;
+            if (!r.distance_field)
+                std::fprintf(stderr, "%d%%: no distance field atlas was built\n", r.zoom);
+            else
+                std::fprintf(stderr, "%d%%: mean difference %.3f exceeds %.3f\n", r.zoom,
+                    r.mean_diff, *max_diff);
+            over = true;
+        }
+        return over ? 1 : 0;
+    }
+
+    auto results = std::vector<result>{};
+    auto draw_calls_grew = false;
+    for (auto const& s : scenarios) {
+        if (!filter.empty() && std::find(filter.begin(), filter.end(), s.name) == filter.end())
+            continue;
+        auto const first = results.size();
+        for (auto items : {8, 64, 512})
+            results.push_back(run(s, items, warmup, frames));
+
+        if (!s.batched)
+            continue;
+        for (auto i = first + 1; i < results.size(); ++i) {
+            if (results[i].draw_calls <= results[first].draw_calls)
+                continue;
+            std::fprintf(stderr, "%s/%d: %d draw calls, %d with %d items\n", s.name,
+                results[i].items, results[i].draw_calls, results[first].draw_calls,
+                results[first].items);
+            draw_calls_grew = true;
+        }
+    }
+
+    ImGui::DestroyContext();
+    print(results);
+
+    if (check_draw_calls && draw_calls_grew)
+        return 1;
+
+    if (alloc_budget) {
+        auto over = false;
+        for (auto const& r : results) {
+            if (r.max_allocs_per_frame <= *alloc_budget)
+                continue;
+            std::fprintf(stderr, "%s/%d: %zu allocations per frame exceed the budget of %zu\n",
+                r.name.c_str(), r.items, r.max_allocs_per_frame, *alloc_budget);
+            over = true;
+        }
+        if (over)
+            return 1;
+    }
+    return 0;
+}
@@ -6,6 +6,7 @@
 #   - WIN32
 #   - SDL2
 #   - SDL3
+#   - NULL offscreen host without windows or events
 #
 #
 # IMGUI_RENDER_IMPL renderer backend
@@ -13,6 +14,8 @@
 #   - GL3
 #   - VULKAN
 #   - DX11
+#   - NULL discards the draw data (NULL host only)
+#   - SOFTWARE rasterizes into an in-memory RGBA buffer (NULL host only)
 #
 # IMGUI_ENABLE_FREETYPE
 #
@@ -28,7 +31,7 @@ endif()
 if(WIN32)
     # choose between WIN32/DIRECTX or GLFW/GL3
     set(IMGUI_HOST_IMPL "WIN32" CACHE STRING "ImGui host implementation")
-    set_property(CACHE IMGUI_HOST_IMPL PROPERTY STRINGS "WIN32" "GLFW" "SDL2" "SDL3")
+    set_property(CACHE IMGUI_HOST_IMPL PROPERTY STRINGS "WIN32" "GLFW" "SDL2" "SDL3" "NULL")
     if(IMGUI_HOST_IMPL STREQUAL "WIN32")
         set(IMGUI_DEFAULT_RENDER_IMPL "DX11")
     elseif(IMGUI_HOST_IMPL STREQUAL "GLFW")
@@ -37,6 +40,8 @@ if(WIN32)
         set(IMGUI_DEFAULT_RENDER_IMPL "GL3")
     elseif(IMGUI_HOST_IMPL STREQUAL "SDL3")
         set(IMGUI_DEFAULT_RENDER_IMPL "GL3")
+    elseif(IMGUI_HOST_IMPL STREQUAL "NULL")
+        set(IMGUI_DEFAULT_RENDER_IMPL "NULL")
     else()
         message(FATAL_ERROR "Unsupported ImGui host implementation")
     endif()
@@ -50,13 +55,25 @@ elseif(ANDROID)
 else()
     # choose between GLFW or SDL2 or SDL3, default to GLFW
     set(IMGUI_HOST_IMPL "GLFW" CACHE STRING "ImGui host implementation")
-    set_property(CACHE IMGUI_HOST_IMPL PROPERTY STRINGS "GLFW" "SDL2" "SDL3")
-    set(IMGUI_DEFAULT_RENDER_IMPL "GL3")
+    set_property(CACHE IMGUI_HOST_IMPL PROPERTY STRINGS "GLFW" "SDL2" "SDL3" "NULL")
+    if(IMGUI_HOST_IMPL STREQUAL "NULL")
+        set(IMGUI_DEFAULT_RENDER_IMPL "NULL")
+    else()
+        set(IMGUI_DEFAULT_RENDER_IMPL "GL3")
+    endif()
 
 endif()
 
 set(IMGUI_RENDER_IMPL "${IMGUI_DEFAULT_RENDER_IMPL}" CACHE STRING "ImGui render implementation")
-set_property(CACHE IMGUI_RENDER_IMPL PROPERTY STRINGS "DX11" "GL3" "VULKAN")
+set_property(CACHE IMGUI_RENDER_IMPL PROPERTY STRINGS "DX11" "GL3" "VULKAN" "NULL" "SOFTWARE")
+
+if(IMGUI_HOST_IMPL STREQUAL "NULL")
+    if(NOT IMGUI_RENDER_IMPL STREQUAL "NULL" AND NOT IMGUI_RENDER_IMPL STREQUAL "SOFTWARE")
+        message(FATAL_ERROR "ImGui -- NULL host requires the NULL or SOFTWARE renderer")
+    endif()
+elseif(IMGUI_RENDER_IMPL STREQUAL "NULL" OR IMGUI_RENDER_IMPL STREQUAL "SOFTWARE")
+    message(FATAL_ERROR "ImGui -- ${IMGUI_RENDER_IMPL} renderer requires the NULL host")
+endif()
 
 if(IMGUI_RENDER_IMPL STREQUAL "GL3")
     set(IMGUI_GL_LOADER_IMPL "GLAD" CACHE STRING "ImGui OpenGL loader implementation")
@@ -95,6 +112,9 @@ elseif(IMGUI_HOST_IMPL STREQUAL "SDL3")
 elseif(IMGUI_HOST_IMPL STREQUAL "WIN32")
     target_sources(imgui PUBLIC "${IMGUI_DIR}/backends/imgui_impl_win32.cpp")
 
+elseif(IMGUI_HOST_IMPL STREQUAL "NULL")
+    # implemented by ImPlus, no ImGui platform backend
+
 endif()
    
 message(STATUS "ImGui -- Render implementation: ${IMGUI_RENDER_IMPL}")
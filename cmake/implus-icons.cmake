@@ -0,0 +1,183 @@
+#
+#
+# implus_add_icon_set(<target>
+#     CODEPOINTS <file>     codepoint list, one "<name> <hex codepoint>" per line
+#     HEADER <path>         header to generate, as included by the target
+#     NAMESPACE <ns>        C++ namespace of the generated glyphs
+#     FONT_TAG <tag>        GlyphInfo::FontTag of the icon font (1-255)
+# )
+#
+#   Generates a header with a constexpr ImPlus::GlyphInfo for each codepoint,
+#   a Glyphs table sorted by name and a constexpr Find(name) lookup. Names are
+#   turned into C identifiers, names that map to the same identifier are an
+#   error. The header
+#   is written at configure time (and rewritten when the codepoint list
+#   changes), its directory is added to the include directories of the target.
+#
+#   The font itself is bound at runtime:
+#
+#     ImPlus::GlyphInfo::RegisterFontTag(ns::FontTag, font);
+#
+#
+
+function(_implus_icon_identifier name out)
+    string(MAKE_C_IDENTIFIER "${name}" ident)
+    set(keywords and auto bool break case catch char class const continue default delete do
+        double else enum export float for friend goto if inline int namespace new not operator
+        or private protected public register return short signed sizeof static struct switch
+        template this throw try typedef union unsigned using virtual void volatile while xor)
+    if(ident IN_LIST keywords)
+        string(APPEND ident "_")
+    endif()
+    set(${out} "${ident}" PARENT_SCOPE)
+endfunction()
+
+function(_implus_utf8_literal hex out)
+    math(EXPR cp "0x${hex}")
+    if(cp LESS 128)
+        set(bytes "${cp}")
+    elseif(cp LESS 2048)
+        math(EXPR b0 "0xC0 | (${cp} >> 6)")
+        math(EXPR b1 "0x80 | (${cp} & 0x3F)")
+        set(bytes ${b0} ${b1})
+    elseif(cp LESS 65536)
+        math(EXPR b0 "0xE0 | (${cp} >> 12)")
+        math(EXPR b1 "0x80 | ((${cp} >> 6) & 0x3F)")
+        math(EXPR b2 "0x80 | (${cp} & 0x3F)")
+        set(bytes ${b0} ${b1} ${b2})
+    else()
+        math(EXPR b0 "0xF0 | (${cp} >> 18)")
+        math(EXPR b1 "0x80 | ((${cp} >> 12) & 0x3F)")
+        math(EXPR b2 "0x80 | ((${cp} >> 6) & 0x3F)")
+        math(EXPR b3 "0x80 | (${cp} & 0x3F)")
+        set(bytes ${b0} ${b1} ${b2} ${b3})
+    endif()
+
+    set(literal "")
+    foreach(b IN LISTS bytes)
+        math(EXPR h "${b}" OUTPUT_FORMAT HEXADECIMAL)
+        string(SUBSTRING "${h}" 2 -1 h)
+        string(LENGTH "${h}" len)
+        if(len LESS 2)
+            set(h "0${h}")
+        endif()
+        string(APPEND literal "\\x${h}")
+    endforeach()
+    set(${out} "${literal}" PARENT_SCOPE)
+endfunction()
+
+function(implus_add_icon_set target)
+    cmake_parse_arguments(ARG "" "CODEPOINTS;HEADER;NAMESPACE;FONT_TAG" "" ${ARGN})
+    foreach(arg CODEPOINTS HEADER NAMESPACE FONT_TAG)
+        if(NOT DEFINED ARG_${arg})
+            message(FATAL_ERROR "implus_add_icon_set: missing ${arg}")
+        endif()
+    endforeach()
+    if(NOT ARG_FONT_TAG MATCHES "^[0-9]+$" OR ARG_FONT_TAG LESS 1 OR ARG_FONT_TAG GREATER 255)
+        message(FATAL_ERROR "implus_add_icon_set: FONT_TAG must be between 1 and 255")
+    endif()
+
+    get_filename_component(codepoints "${ARG_CODEPOINTS}" ABSOLUTE)
+    set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS "${codepoints}")
+
+    # parse first, then sort the "<name>\t<hex>" entries: the tab sorts before
+    # any character of a name, so the order is the byte order of the names
+    # that Find relies on
+    file(STRINGS "${codepoints}" lines)
+    set(entries "")
+    foreach(line IN LISTS lines)
+        string(STRIP "${line}" line)
+        if(line STREQUAL "" OR line MATCHES "^#")
+            continue()
+        endif()
+        if(NOT line MATCHES "^([^][ \t;]+)[ \t]+(0[xX])?([0-9a-fA-F]+)$")
+            message(WARNING "implus_add_icon_set: skipping '${line}' in ${codepoints}")
+            continue()
+        endif()
+        list(APPEND entries "${CMAKE_MATCH_1}\t${CMAKE_MATCH_3}")
+    endforeach()
+    list(SORT entries)
+
+    set(constants "")
+    set(table "")
+    set(count 0)
+    set(last_name "")
+    set(idents FontTag Entry Glyphs Find) # declared by the header itself
+    foreach(entry IN LISTS entries)
+        string(FIND "${entry}" "\t" tab REVERSE)
+        string(SUBSTRING "${entry}" 0 ${tab} name)
+        math(EXPR hex_start "${tab} + 1")
+        string(SUBSTRING "${entry}" ${hex_start} -1 hex)
+        if(name STREQUAL last_name)
+            message(WARNING "implus_add_icon_set: duplicate '${name}' in ${codepoints}")
+            continue() # duplicates are adjacent after sorting
+        endif()
+        set(last_name "${name}")
+
+        _implus_icon_identifier("${name}" ident)
+        if(ident IN_LIST idents)
+            message(FATAL_ERROR
+                "implus_add_icon_set: '${name}' in ${codepoints} maps to the identifier "
+                "'${ident}' of another name")
+        endif()
+        list(APPEND idents "${ident}")
+
+        _implus_utf8_literal("${hex}" literal)
+        string(REPLACE "\\" "\\\\" escaped "${name}")
+        string(REPLACE "\"" "\\\"" escaped "${escaped}")
+        string(APPEND constants
+            "inline constexpr auto ${ident} = ImPlus::GlyphInfo{\"${literal}\", FontTag};\n")
+        string(APPEND table "    Entry{\"${escaped}\", ${ident}},\n")
+        math(EXPR count "${count} + 1")
+    endforeach()
+
+    set(include_dir "${CMAKE_CURRENT_BINARY_DIR}/implus-icons")
+    file(CONFIGURE OUTPUT "${include_dir}/${ARG_HEADER}" CONTENT
+"// generated by implus_add_icon_set from ${ARG_CODEPOINTS}, do not edit
+#pragma once
+
+#include <implus/icon.hpp>
+
+#include <array>
+#include <string_view>
+
+namespace ${ARG_NAMESPACE} {
+
+inline constexpr int FontTag = ${ARG_FONT_TAG};
+
+${constants}
+struct Entry {
+    std::string_view Name;
+    ImPlus::GlyphInfo Glyph;
+};
+
+// Glyphs is sorted by name
+inline constexpr auto Glyphs = std::array<Entry, ${count}>{{
+${table}}};
+
+// Find looks up a glyph by its name in the codepoint list, returns an empty
+// GlyphInfo if the name is unknown
+constexpr auto Find(std::string_view name) -> ImPlus::GlyphInfo
+{
+    auto lo = std::size_t{0};
+    auto hi = Glyphs.size();
+    while (lo < hi) {
+        auto const mid = lo + (hi - lo) / 2;
+        if (Glyphs[mid].Name < name)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo < Glyphs.size() && Glyphs[lo].Name == name ? Glyphs[lo].Glyph : ImPlus::GlyphInfo{};
+}
+
+} // namespace ${ARG_NAMESPACE}
+" @ONLY)
+
+    get_target_property(type ${target} TYPE)
+    if(type STREQUAL "INTERFACE_LIBRARY")
+        target_include_directories(${target} INTERFACE "${include_dir}")
+    else()
+        target_include_directories(${target} PUBLIC "${include_dir}")
+    endif()
+endfunction()
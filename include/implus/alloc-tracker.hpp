@@ -0,0 +1,98 @@
+#pragma once
+
+// Heap allocation tracker
+//
+// A replacement of the global operator new and the ImGui allocator functions
+// (ImGui::SetAllocatorFunctions, used by ImVector and ImDrawList) count
+// allocations and bytes, the counts of the UI thread are closed per frame and
+// attributed to the innermost tagged scope (text blocks, overridable stacks,
+// draw callbacks, toolbar state). The tracker window (DBGW::ImPlusAllocations)
+// shows the counts of recent frames.
+//
+//     AllocTracker::SetFrameBudget(0); // steady-state frames must not allocate
+//
+// A frame is in steady state after a number of frames without input, frames
+// exceeding the budget trigger IM_ASSERT.
+//
+// Tracking is compiled only with IMPLUS_ENABLE_ALLOC_TRACKING, otherwise the
+// macros expand to nothing and operator new is not replaced.
+
+#ifdef IMPLUS_ENABLE_ALLOC_TRACKING
+
+#include <cstddef>
+
+namespace ImPlus::AllocTracker {
+
+struct Counts {
+    std::size_t Allocations = 0;
+    std::size_t Bytes = 0;
+};
+
+// RegisterScope returns the index of a named scope, the name must outlive the
+// tracker (a string literal), scopes registered with the same name share the
+// index
+auto RegisterScope(char const* name) -> int;
+
+// ScopeCount returns the number of scopes including the untagged scope 0
+auto ScopeCount() -> int;
+auto ScopeName(int scope) -> char const*;
+
+// EnterScope makes the scope current for the calling thread, returns the
+// previous scope to be restored by LeaveScope
+auto EnterScope(int scope) -> int;
+void LeaveScope(int previous);
+
+// Totals returns the counts of all threads since the start of the process
+auto Totals() -> Counts;
+
+// LastFrame returns the counts of the UI thread in the last closed frame
+auto LastFrame() -> Counts;
+auto LastFrame(int scope) -> Counts;
+
+// EndFrame closes the counts of the current frame, called by
+// Application::Base::Run after RenderFrame, the calling thread is the UI thread
+void EndFrame();
+
+// SetFrameBudget sets the number of allocations allowed per frame once no
+// input was received for settle_frames frames
+void SetFrameBudget(std::size_t allocations, int settle_frames = 10);
+void ClearFrameBudget();
+
+void Reset();
+
+// ShowWindow displays the tracker window
+void ShowWindow(bool* p_open = nullptr);
+
+class ScopeTag {
+public:
+    explicit ScopeTag(int scope)
+        : previous_{EnterScope(scope)}
+    {
+    }
+    ScopeTag(ScopeTag const&) = delete;
+    auto operator=(ScopeTag const&) -> ScopeTag& = delete;
+    ~ScopeTag() { LeaveScope(previous_); }
+
+private:
+    int previous_;
+};
+
+} // namespace ImPlus::AllocTracker
+
+#define IMPLUS_ALLOC_CONCAT_(a, b) a##b
+#define IMPLUS_ALLOC_CONCAT(a, b) IMPLUS_ALLOC_CONCAT_(a, b)
+#define IMPLUS_ALLOC_SCOPE(name)                                                                   \
+    static int const IMPLUS_ALLOC_CONCAT(implus_alloc_scope_, __LINE__) =                          \
+        ::ImPlus::AllocTracker::RegisterScope(name);                                               \
+    ::ImPlus::AllocTracker::ScopeTag const IMPLUS_ALLOC_CONCAT(implus_alloc_tag_, __LINE__)        \
+    {                                                                                              \
+        IMPLUS_ALLOC_CONCAT(implus_alloc_scope_, __LINE__)                                         \
+    }
+#define IMPLUS_ALLOC_FRAME() ::ImPlus::AllocTracker::EndFrame()
+
+#else
+
+#define IMPLUS_ALLOC_SCOPE(name) static_cast<void>(0)
+#define IMPLUS_ALLOC_FRAME() static_cast<void>(0)
+
+#endif
@@ -7,6 +7,7 @@
 #include <stdexcept>
 #include <concepts>
 #include <functional>
+#include <optional>
 #include <vector>
 
 namespace ImPlus::Application {
@@ -64,6 +65,46 @@ inline void Base::InitTheme()
     Visuals::Theme::Setup(ImPlus::Visuals::Theme::Dark);
 }
 
+// RequestAnimationFrame asks for a frame no later than `time` (in
+// ImGui::GetTime() seconds), animated content calls it each frame it is drawn
+// so the loop does not have to redraw continuously to keep it moving
+void RequestAnimationFrame(double time);
+inline void RequestAnimationFrameIn(double seconds)
+{
+    RequestAnimationFrame(ImGui::GetTime() + seconds);
+}
+
+// TakeAnimationFrame returns the earliest time requested since the last call
+// and clears the request, called by the loop after each frame
+auto TakeAnimationFrame() -> std::optional<double>;
+
+// IdleMode selects how Base::Run paces frames
+enum class IdleMode {
+    Continuous,  // render every frame, paced by vsync
+    PowerSaving, // wait for events while nothing changes
+};
+
+// SetIdleMode, in PowerSaving mode the loop renders frames_after_input frames
+// after each input so that ImGui can settle, then waits for input,
+// RequestRedraw, requested animation frames or posts from other threads
+void SetIdleMode(IdleMode mode, int frames_after_input = 3);
+auto GetIdleMode() -> IdleMode;
+
+// RequestRedraw asks for a new frame, may be called from any thread
+void RequestRedraw();
+
+// Post queues a task that runs on the UI thread at the start of a frame and
+// wakes the loop, may be called from any thread
+void Post(std::function<void()> task);
+
+// SetPostBudget limits the time spent on posted tasks per frame (in seconds),
+// the remaining tasks run in the following frames; zero runs all tasks
+void SetPostBudget(double seconds);
+
+// RunPostedTasks runs the posted tasks within the budget, called by Base::Run
+// after NewFrame; custom loops call it once per frame
+void RunPostedTasks();
+
 namespace Callbacks {
     using collection_type = std::vector<std::function<void()>>;
     inline collection_type BeforeFrame;
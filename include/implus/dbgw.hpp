@@ -27,5 +27,8 @@ protected:
 extern wnd ImGuiMetrics;
 extern wnd ImGuiDemo;
 extern wnd ImPlusDemo;
+extern wnd ImPlusProfiler;    // requires IMPLUS_ENABLE_PROFILER
+extern wnd ImPlusAllocations; // requires IMPLUS_ENABLE_ALLOC_TRACKING
+extern wnd ImPlusDrawStats;   // requires IMPLUS_ENABLE_DRAW_STATS
 
 } // namespace ImPlus::DBGW
\ No newline at end of file
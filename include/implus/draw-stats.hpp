@@ -0,0 +1,80 @@
+#pragma once
+
+// Draw list statistics
+//
+// Scoped markers attribute the vertices, indices and draw commands appended
+// to a draw list to the widget that produced them (buttons, selectable boxes,
+// text blocks, icons, toolbar buttons and menus). The counts are exclusive,
+// the growth of nested markers on the same draw list is attributed to the
+// inner marker only.
+//
+//     void Render(ImDrawList* dl) const
+//     {
+//         IMPLUS_DRAW_SCOPE("my.widget", dl);
+//         ...
+//     }
+//
+// The statistics window (DBGW::ImPlusDrawStats) shows the counts of the last
+// frame and an overdraw heatmap of the main viewport, rendered by the
+// software rasterizer from the draw data of the last frame.
+//
+// Markers are compiled only with IMPLUS_ENABLE_DRAW_STATS, otherwise the macro
+// expands to nothing. Markers are recorded on the UI thread only.
+
+#ifdef IMPLUS_ENABLE_DRAW_STATS
+
+#include <imgui.h>
+
+namespace ImPlus::DrawStats {
+
+struct Counts {
+    int Calls = 0;
+    int Vertices = 0;
+    int Indices = 0;
+    int Commands = 0; // negative when the widget merged draw commands
+};
+
+// RegisterScope returns the index of a named scope, the name must outlive the
+// statistics (a string literal), scopes registered with the same name share
+// the index
+auto RegisterScope(char const* name) -> int;
+
+auto ScopeCount() -> int;
+auto ScopeName(int scope) -> char const*;
+
+// LastFrame returns the counts of a scope in the last completed frame
+auto LastFrame(int scope) -> Counts;
+
+// Enter starts the attribution of the growth of a draw list to a scope,
+// Leave closes the innermost marker
+void Enter(int scope, ImDrawList const* dl);
+void Leave();
+
+// ShowWindow displays the statistics window
+void ShowWindow(bool* p_open = nullptr);
+
+class ScopeMarker {
+public:
+    ScopeMarker(int scope, ImDrawList const* dl) { Enter(scope, dl); }
+    ScopeMarker(ScopeMarker const&) = delete;
+    auto operator=(ScopeMarker const&) -> ScopeMarker& = delete;
+    ~ScopeMarker() { Leave(); }
+};
+
+} // namespace ImPlus::DrawStats
+
+#define IMPLUS_DRAW_CONCAT_(a, b) a##b
+#define IMPLUS_DRAW_CONCAT(a, b) IMPLUS_DRAW_CONCAT_(a, b)
+#define IMPLUS_DRAW_SCOPE(name, dl)                                                                \
+    static int const IMPLUS_DRAW_CONCAT(implus_draw_scope_, __LINE__) =                            \
+        ::ImPlus::DrawStats::RegisterScope(name);                                                  \
+    ::ImPlus::DrawStats::ScopeMarker const IMPLUS_DRAW_CONCAT(implus_draw_marker_, __LINE__)       \
+    {                                                                                              \
+        IMPLUS_DRAW_CONCAT(implus_draw_scope_, __LINE__), dl                                       \
+    }
+
+#else
+
+#define IMPLUS_DRAW_SCOPE(name, dl) static_cast<void>(0)
+
+#endif
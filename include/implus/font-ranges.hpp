@@ -4,13 +4,16 @@
 #include <charconv>
 #include <concepts>
 #include <cstdint>
+#include <imgui.h>
 #include <initializer_list>
 #include <string_view>
 
 namespace ImPlus::Font {
 
+// range is a span of codepoints, codepoints above U+FFFF require
+// IMGUI_USE_WCHAR32 like ImWchar
 struct range {
-    using codepoint = uint16_t;
+    using codepoint = ImWchar;
     codepoint lo; // inclusive
     codepoint hi; // inclusive
     constexpr range(codepoint lo, codepoint hi)
@@ -61,9 +64,9 @@ auto decode_ranges(
             skip_white();
         }
 
-        if (hi >= lo && lo <= 0xffff) {
-            if (hi > 0xffff)
-                hi = 0xffff;
+        if (hi >= lo && lo <= IM_UNICODE_CODEPOINT_MAX) {
+            if (hi > IM_UNICODE_CODEPOINT_MAX)
+                hi = IM_UNICODE_CODEPOINT_MAX;
             proc(lo, hi);
         }
 
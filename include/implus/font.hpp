@@ -3,12 +3,15 @@
 #include "font-ranges.hpp"
 #include <cstddef>
 #include <filesystem>
+#include <functional>
 #include <imgui.h>
 #include <initializer_list>
 #include <span>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 namespace ImPlus::Font {
 
@@ -36,6 +39,33 @@ inline auto Adjust = std::unordered_map<std::string, Adjustment>{};
 
 void SetBuilderFlags(unsigned int flags);
 
+// SetParallelRasterization makes Setup() rasterize glyphs on worker threads,
+// each with its own FT_Library, ahead of the atlas build; only packing and
+// blitting stay serial
+//
+// - FreeType builds only, enabled by default
+// - fonts with color or bitmap glyphs are left to the atlas builder
+//
+void SetParallelRasterization(bool enable);
+
+// SetDistanceFieldAtlas makes Setup() bake signed distance fields rather
+// than coverage bitmaps: glyphs are rasterized once, at 192 DPI, and DPI or
+// zoom changes rescale the fonts instead of rebuilding the atlas
+//
+// - disabled by default, the bitmap atlas stays the default
+// - FreeType builds only, the renderer must draw distance fields (GL3 with
+//   the streaming path, Vulkan, SOFTWARE), Setup() builds a bitmap atlas
+//   otherwise and when a font loads color or bitmap glyphs
+// - glyphs are unhinted, lines of the atlas are not baked and ImGui draws
+//   them as geometry
+//
+void SetDistanceFieldAtlas(bool enable);
+
+// DistanceFieldAtlas tells whether io.Fonts holds a distance field atlas
+// built by Setup(), the renderers draw the commands that sample its texture
+// with their distance field shader
+auto DistanceFieldAtlas() -> bool;
+
 struct NameInfo {
     std::string Name;
     float PointSize;
@@ -67,6 +97,27 @@ struct BlobInfo {
 
 auto GetDataBlob(char const* facename) -> BlobInfo;
 
+#ifdef IMPLUS_USE_FONTCONFIG
+// GetFileInfo resolves a fontconfig pattern, such as "Noto Sans:bold", to a
+// font file
+//
+// - uses a single process-wide FcConfig
+// - results are memoized by pattern string
+//
+auto GetFileInfo(char const* facename) -> FileInfo;
+
+// GetFallbackFileInfos returns an ordered list of faces that together cover
+// the requested codepoint ranges as completely as the installed fonts allow.
+// Each returned face adds coverage that is not provided by the preceding
+// entries.
+//
+// - facename is the PostScript or full name of a loaded face, its family,
+//   weight and slant select the fallbacks
+// - codepoints above U+FFFF require IMGUI_USE_WCHAR32, like range::codepoint
+auto GetFallbackFileInfos(char const* facename, std::span<range const> ranges)
+    -> std::vector<FileInfo>;
+#endif
+
 inline auto Regular = Resource{};
 
 // LoadDefaults tries to load host's default GUI font
@@ -82,6 +133,27 @@ auto Load(BlobInfo const&, std::initializer_list<range> ranges, float point_size
 auto CreateScaled(Resource h, float scale_factor, std::initializer_list<range> ranges = {})
     -> Resource;
 
+#ifdef IMPLUS_USE_FONTCONFIG
+// LoadFallbacks builds a fallback chain for glyphs that are missing from the
+// base font resource (and overlays already merged into it)
+//
+// - required glyphs are specified either as a text corpus (UTF-8) or as a
+//   list of unicode script ranges, see Font::Ranges
+// - fallback faces are chosen by fontconfig, each face is loaded with only
+//   the ranges it contributes, and merged into the base even if other
+//   resources were loaded after it; a merged base stands for the resource
+//   it is merged into
+// - codepoints above U+FFFF are covered only with IMGUI_USE_WCHAR32
+// - uncovered receives the required codepoints that are left without a
+//   glyph, either because no installed face provides them or because
+//   ImWchar can't hold them
+//
+auto LoadFallbacks(Resource base, std::string_view corpus,
+    std::vector<char32_t>* uncovered = nullptr) -> std::vector<Resource>;
+auto LoadFallbacks(Resource base, std::span<range const> scripts,
+    std::vector<char32_t>* uncovered = nullptr) -> std::vector<Resource>;
+#endif
+
 // SetMergeMode indicates that the font needs to be merged with the previously
 // loaded handle (this effectively implements as glyph fallback)
 void SetMergeMode(Resource h, bool mergeWithPrev = true);
@@ -90,4 +162,49 @@ void SetMergeMode(Resource h, bool mergeWithPrev = true);
 // the specified DPI
 auto Setup(float dpi, float oversample) -> bool;
 
+// OnAtlasPrepare and OnAtlasBuilt allow adding custom content to the font
+// atlas during Setup(): rectangles are reserved in OnAtlasPrepare (see
+// ImFontAtlas::AddCustomRectRegular) and populated in OnAtlasBuilt
+inline std::vector<std::function<void(ImFontAtlas&)>> OnAtlasPrepare;
+inline std::vector<std::function<void(ImFontAtlas&)>> OnAtlasBuilt;
+
+// RequestRebuild makes the next Setup() call rebuild the atlas even if the
+// DPI did not change
+void RequestRebuild();
+
+// Generation is incremented each time Setup() installs a different atlas,
+// it can be used to invalidate cached glyph measurements
+auto Generation() -> std::size_t;
+
+// SetupTimings is a breakdown of the most recent atlas rebuild performed
+// by Setup(), all durations are in seconds
+//
+// - Coverage: glyph coverage scans for resources loaded without explicit
+//   ranges, unique faces are scanned concurrently by at most
+//   hardware_concurrency threads
+// - Rasterize: glyphs rasterized ahead of the build by RasterThreads
+//   threads, see SetParallelRasterization
+// - Configure: scaling and registering resources with the atlas
+// - Build: packing, and rasterization of the remaining glyphs within the
+//   atlas builder
+// - Blit: copying RasterizedGlyphs prerendered glyphs into the atlas
+// - Rescaled: only the fonts of the distance field atlas were rescaled, the
+//   atlas and its texture are unchanged
+//
+struct SetupTimings {
+    double Coverage = 0.0;
+    double Rasterize = 0.0;
+    double Configure = 0.0;
+    double Build = 0.0;
+    double Blit = 0.0;
+    double Total = 0.0;
+    std::size_t Views = 0;
+    std::size_t CoverageScans = 0;
+    std::size_t RasterizedGlyphs = 0;
+    std::size_t RasterThreads = 0;
+    bool Rescaled = false;
+};
+
+auto GetSetupTimings() -> SetupTimings;
+
 } // namespace ImPlus::Font
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include <functional>
 #include <imgui.h>
+#include <memory>
 #include <optional>
 #include <string>
 #include <variant>
@@ -121,6 +122,19 @@ struct Window {
 
     ImVec4 Background = ImVec4{0.45f, 0.55f, 0.60f, 1.00f};
 
+    // SkipUnchangedFrames (opt-in) skips GPU submission and present in
+    // RenderFrame when the draw data, texture ids and background match the
+    // last presented frame, frames are never skipped while OnBeforeDraw or
+    // OnAfterDraw are set. Texture contents aren't compared: an application
+    // that updates its own textures in place (a video or camera feed) must call
+    // InvalidateFrame after each update or its frames are not presented.
+    bool SkipUnchangedFrames = false;
+
+    // InvalidateFrame makes the next RenderFrame submit and present its frame,
+    // for example when the window contents were damaged by the system or a
+    // texture was updated in place
+    void InvalidateFrame();
+
     std::function<void()> OnRefresh;
     std::function<void(Size const& sz)> OnFramebufferSize;
     std::function<void()> OnBeforeDraw; // called before ImGui calls RenderDrawData
@@ -135,6 +149,11 @@ private:
     std::optional<Location> pending_locate_;
     bool pending_constrain_ = false;
 
+    struct frame_state;
+    std::shared_ptr<frame_state> frame_;
+    auto begin_present(bool will_present) -> bool;
+    void pace_skipped_frame();
+
     mutable Bounds regular_bounds = {};
     bool fullscreen = false;
 
@@ -168,6 +187,21 @@ void InvalidateDeviceObjects();
 // NewFrame...RenderFrame scope
 auto WithinFrame() -> bool;
 
+// WaitEvents blocks until an event arrives or the timeout (in seconds)
+// expires, a negative timeout waits indefinitely; the events are processed by
+// the next NewFrame
+void WaitEvents(double timeout);
+
+// PostEmptyEvent wakes WaitEvents, may be called from any thread
+void PostEmptyEvent();
+
+#if defined(IMPLUS_HOST_NULL)
+// SetFrameTimeStep makes the offscreen host advance the ImGui clock by a fixed
+// step per frame, WaitEvents then returns immediately; nullopt restores the
+// wall clock
+void SetFrameTimeStep(std::optional<double> seconds);
+#endif
+
 enum class NativeHandleType {
     UNKNOWN_HANDLE_TYPE,
     WIN32_HWND,      // Win32 HWND
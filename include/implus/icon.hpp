@@ -43,6 +43,14 @@ struct GraphicalResource : public SizableResource {
     virtual void Render(ImDrawList*, ImVec2 const& xy, ImU32 clr) {};
 };
 
+// GlyphInfo is a symbol of an icon font, referenced by a font tag so that
+// tables of glyphs can be constexpr (see implus_add_icon_set in CMake)
+//
+// - FontTag zero uses the current font, any other tag is bound to a font with
+//   RegisterFontTag; tags 1-255 (as generated by implus_add_icon_set) are
+//   looked up in a dense array, other tags in a short list
+// - a Glyph constructed from a GlyphInfo with an unregistered tag is empty
+//
 struct GlyphInfo {
     std::string_view Symbol = {};
     int FontTag = 0;
@@ -83,6 +91,25 @@ struct Glyph {
         ret.FontScale *= scale;
         return ret;
     }
+
+    // Measure returns the unscaled size of the symbol rendered with the glyph's
+    // font (or the current font)
+    //
+    // - the result is cached within the glyph (and its copies) until the font
+    //   atlas is rebuilt or the current font changes
+    // - modifying Symbol after the glyph has been measured is not detected
+    //
+    auto Measure() const -> ImVec2;
+
+private:
+    struct measurement {
+        std::size_t generation = 0;
+        ImFont const* current_font = nullptr;
+        float current_size = 0.0f;
+        std::size_t font_id = 0;
+        ImVec2 size = {0, 0};
+    };
+    mutable std::optional<measurement> measured_;
 };
 
 struct IconBadge {
@@ -100,6 +127,14 @@ struct CustomIconData {
     length width = 0_em; // auto-size
     length height = 1_em;
     std::function<void(ImDrawList*, ImVec2 const& bb_min, ImVec2 const& bb_max, ImU32 clr)> on_draw;
+
+    // cache_id identifies the drawing for the raster cache (see
+    // Icon::EnableRasterCache), zero disables caching for this icon
+    //
+    // - on_draw must produce the same shape for the same id and size
+    // - on_draw must use the provided color, baked icons are tinted
+    //
+    std::size_t cache_id = 0;
 };
 
 struct Icon {
@@ -114,6 +149,23 @@ public:
 
     static auto Placeholder(length const& width, length const& height) -> CustomIconData;
 
+    // EnableRasterCache enables baking of static builtin shapes and custom
+    // icons with a non-zero cache_id into the font atlas
+    //
+    // - baked icons are drawn as a single quad of the font texture with its
+    //   origin on the framebuffer pixel grid, they batch with text and add
+    //   no draw commands
+    // - icons are baked into custom rects at their framebuffer pixel size
+    //   while the atlas is rebuilt (see Font::OnAtlasPrepare), the texture is
+    //   never updated during a frame
+    // - new icons are drawn as geometry, once no new icons were seen for a
+    //   while the cache requests one atlas rebuild, which resets resources
+    //   like a change of DPI
+    // - icons not drawn between two rebuilds are evicted
+    // - the animated Builtin::Spinner is never cached
+    //
+    static void EnableRasterCache(bool enable = true);
+
 private:
     struct builtin_content {
         Builtin shape = Builtin::Box;
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <imgui.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <implus/icon.hpp>
+#include <implus/length.hpp>
+
+namespace ImPlus {
+
+namespace internal {
+struct texture_image;
+}
+
+// TextureImage is a bitmap image (thumbnail, avatar, preview) for icons
+//
+// - images are decoded on a worker thread and uploaded to a renderer texture
+//   when first drawn, a placeholder is drawn until the texture is ready
+// - the most recently requested images are decoded first, uploads are
+//   spread over frames to keep scrolling smooth
+// - textures are limited by SetTextureBudget, the least recently drawn images
+//   are evicted first and decoded again when they are drawn next time
+// - textures share the lifetime of the renderer: without one images are kept
+//   decoded, when it shuts down they are dropped and decoded again on demand
+// - width or height set to zero follow the aspect ratio of the image (a
+//   square until the image is decoded)
+//
+struct TextureImage : public GraphicalResource {
+    struct Pixels {
+        int Width = 0;
+        int Height = 0;
+        std::vector<std::uint8_t> RGBA; // straight alpha, tightly packed
+    };
+
+    // Decoder converts an encoded image (PNG, JPEG, ...) into pixels, called on
+    // worker threads; an empty result or an exception marks the image as
+    // failed
+    using Decoder = std::function<Pixels(std::span<std::uint8_t const> encoded)>;
+
+    // loads the encoded image from a file, on the worker thread
+    explicit TextureImage(std::string path, length width = 0_em, length height = 1_em);
+
+    // decodes an encoded image held in memory
+    explicit TextureImage(
+        std::vector<std::uint8_t> encoded, length width = 0_em, length height = 1_em);
+
+    ~TextureImage() override;
+
+    TextureImage(TextureImage const&) = delete;
+    auto operator=(TextureImage const&) -> TextureImage& = delete;
+
+    auto GetSize() -> ImVec2 override;
+    void Render(ImDrawList*, ImVec2 const& xy, ImU32 clr) override;
+
+    auto IsReady() const -> bool;  // uploaded and drawable
+    auto IsFailed() const -> bool; // could not be read or decoded
+
+    // SetDecoder replaces the decoder, the default decoder uses stb_image
+    // when built with IMPLUS_ENABLE_STB_IMAGE, otherwise images fail until a
+    // decoder is set
+    static void SetDecoder(Decoder decoder);
+
+    // SetTextureBudget limits the texture memory of all images, in bytes
+    // (64 MiB by default)
+    static void SetTextureBudget(std::size_t bytes);
+    static auto TextureMemoryUsage() -> std::size_t;
+
+private:
+    std::shared_ptr<internal::texture_image> data_;
+    length width_;
+    length height_;
+};
+
+} // namespace ImPlus
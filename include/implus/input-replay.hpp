@@ -0,0 +1,89 @@
+#pragma once
+
+// Input recording and deterministic replay
+//
+// The recorder appends the input of each frame (mouse, keys, text, focus,
+// display size and content scale) to a compact binary log, captured by
+// Host::Window::NewFrame right before ImGui::NewFrame. A replay feeds the log
+// back instead of the host input with a fixed time step and traces the time
+// and heap allocations of each replayed frame:
+//
+//     InputReplay::StartRecording("session.implus-input");
+//     ...
+//     InputReplay::StartReplay("session.implus-input");
+//
+// The same is available without code changes through the environment:
+//
+//     IMPLUS_RECORD_INPUT=<log>   record the session
+//     IMPLUS_REPLAY_INPUT=<log>   replay the log and close the main window
+//     IMPLUS_REPLAY_TRACE=<csv>   write the frame trace after the replay
+//
+// Allocations are traced only with IMPLUS_ENABLE_ALLOC_TRACKING. Replay is
+// compiled only with IMPLUS_ENABLE_INPUT_REPLAY, otherwise the macros expand
+// to nothing.
+
+#ifdef IMPLUS_ENABLE_INPUT_REPLAY
+
+#include "host.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace ImPlus::InputReplay {
+
+// StartRecording truncates the log and records the following frames, throws
+// std::runtime_error if the file cannot be created
+void StartRecording(char const* path);
+void StopRecording();
+auto IsRecording() -> bool;
+
+struct ReplayOptions {
+    double TimeStep = 1.0 / 60.0; // seconds per frame, 0 uses the recorded steps
+    bool CloseWhenDone = false;   // close the main window after the last frame
+};
+
+// StartReplay loads the log, the following frames take their input from the
+// log and the host input is dropped, throws std::runtime_error if the file
+// cannot be read or is not an input log
+void StartReplay(char const* path, ReplayOptions const& opts = {});
+void StopReplay();
+auto IsReplaying() -> bool;
+
+struct FrameTrace {
+    int Frame = 0;
+    double Milliseconds = 0.0; // from NewFrame to the end of the frame
+    std::size_t Allocations = 0;
+    std::size_t Bytes = 0;
+};
+
+// Traces returns the traces of the last replay
+auto Traces() -> std::vector<FrameTrace> const&;
+
+// WriteTraces writes the traces as CSV, throws std::runtime_error if the file
+// cannot be created
+void WriteTraces(char const* path);
+
+// ContentScale returns the recorded content scale of the next replayed frame,
+// used by Application::Base::Run in place of the window scale
+auto ContentScale() -> std::optional<Host::Window::Scale>;
+
+// NewFrame records or replaces the queued input, called by
+// Host::Window::NewFrame before ImGui::NewFrame
+void NewFrame(Host::Window& w);
+
+// EndFrame closes the trace of a replayed frame, called by
+// Application::Base::Run after RenderFrame
+void EndFrame();
+
+} // namespace ImPlus::InputReplay
+
+#define IMPLUS_REPLAY_NEW_FRAME(w) ::ImPlus::InputReplay::NewFrame(w)
+#define IMPLUS_REPLAY_END_FRAME() ::ImPlus::InputReplay::EndFrame()
+
+#else
+
+#define IMPLUS_REPLAY_NEW_FRAME(w) static_cast<void>(0)
+#define IMPLUS_REPLAY_END_FRAME() static_cast<void>(0)
+
+#endif
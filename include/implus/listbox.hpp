@@ -13,6 +13,7 @@
 #include "implus/blocks.hpp"
 #include "implus/content.hpp"
 #include "implus/interact.hpp"
+#include "implus/profiler.hpp"
 #include "implus/selbox.hpp"
 
 #ifndef IMPLUS_APPLE_CLANG_RANGES
@@ -106,6 +107,8 @@ template <typename R, typename Selector, typename Content>
 requires(detail::input<R> && detail::selector<R, Selector> && detail::boxmaker<R, Content>)
 auto Boxes(ImID id, R&& items, Selector&& is_selected, Content&& on_item) -> InteractResult
 {
+    IMPLUS_PROFILE_SCOPE("listbox.boxes");
+
     using iterator_t = typename std::ranges::iterator_t<R>;
 
     auto item_flags = ImGuiSelectableFlags_(1 << 24); // ImGuiSelectableFlags_SpanAvailWidth;
@@ -1,9 +1,12 @@
 #pragma once
 
+#include "implus/alloc-tracker.hpp"
+
 #include <concepts>
 #include <functional>
 #include <stack>
 #include <type_traits>
+#include <utility>
 #include <variant>
 
 namespace ImPlus {
@@ -43,15 +46,21 @@ template <typename T> struct overridable {
 
     auto operator()() const -> value_type { return get(); }
 
-    auto push(callback_type&& f) { stk.push(std::move(f)); }
-    auto push(callback_type const& f) { stk.push(f); }
-    auto push(value_type&& v) { stk.push(std::move(v)); }
-    auto push(value_type const& v) { stk.push(v); }
+    auto push(callback_type&& f) { do_push(std::move(f)); }
+    auto push(callback_type const& f) { do_push(f); }
+    auto push(value_type&& v) { do_push(std::move(v)); }
+    auto push(value_type const& v) { do_push(v); }
     void pop() { stk.pop(); }
 
 protected:
     std::stack<entry_type> stk;
 
+    template <typename V> void do_push(V&& v)
+    {
+        IMPLUS_ALLOC_SCOPE("overridable.push");
+        stk.push(std::forward<V>(v));
+    }
+
     static auto from(entry_type const& en) -> value_type
     {
         if (auto v = std::get_if<value_type>(&en))
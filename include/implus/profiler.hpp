@@ -0,0 +1,93 @@
+#pragma once
+
+// Frame profiler
+//
+// Scoped timers accumulate the time and call count of named scopes per frame,
+// the profiler window (DBGW::ImPlusProfiler) shows rolling frame times, the
+// average and p99 of each scope, the draw data counts of recent frames and the
+// input latency.
+//
+//     void Layout()
+//     {
+//         IMPLUS_PROFILE_SCOPE("layout");
+//         ...
+//     }
+//
+// Instrumentation is compiled only with IMPLUS_ENABLE_PROFILER, otherwise the
+// macros expand to nothing. Scopes are timed on the UI thread only.
+
+#ifdef IMPLUS_ENABLE_PROFILER
+
+#include <chrono>
+#include <optional>
+
+namespace ImPlus::Profiler {
+
+using clock = std::chrono::steady_clock;
+
+// RegisterScope returns the index of a named scope, the name must outlive the
+// profiler (a string literal)
+auto RegisterScope(char const* name) -> int;
+
+// Record adds a call of a scope to the current frame
+void Record(int scope, clock::duration d);
+
+// EndFrame closes the statistics of the current frame, called by
+// Application::Base::Run after RenderFrame
+void EndFrame();
+
+void Reset();
+
+// input latency
+//
+// PollInput stamps the time the host polls input events, called by
+// Application::Base::Run before each frame. The stamp of a frame that handled
+// input is taken once with TakeInput: renderers that know when the GPU
+// finished the frame take it and call RecordLatency, otherwise EndFrame
+// records the latency once RenderFrame has returned from the present call.
+// Neither includes the compositor or the display, the latency is from input to
+// the end of rendering, not to the photons.
+void PollInput();
+auto TakeInput() -> std::optional<clock::time_point>;
+void RecordLatency(clock::duration d);
+
+// ShowWindow displays the profiler window
+void ShowWindow(bool* p_open = nullptr);
+
+class ScopeTimer {
+public:
+    explicit ScopeTimer(int scope)
+        : scope_{scope}
+        , start_{clock::now()}
+    {
+    }
+    ScopeTimer(ScopeTimer const&) = delete;
+    auto operator=(ScopeTimer const&) -> ScopeTimer& = delete;
+    ~ScopeTimer() { Record(scope_, clock::now() - start_); }
+
+private:
+    int scope_;
+    clock::time_point start_;
+};
+
+} // namespace ImPlus::Profiler
+
+#define IMPLUS_PROFILE_CONCAT_(a, b) a##b
+#define IMPLUS_PROFILE_CONCAT(a, b) IMPLUS_PROFILE_CONCAT_(a, b)
+#define IMPLUS_PROFILE_SCOPE(name)                                                                 \
+    static int const IMPLUS_PROFILE_CONCAT(implus_profile_scope_, __LINE__) =                      \
+        ::ImPlus::Profiler::RegisterScope(name);                                                   \
+    ::ImPlus::Profiler::ScopeTimer const IMPLUS_PROFILE_CONCAT(implus_profile_timer_, __LINE__)    \
+    {                                                                                              \
+        IMPLUS_PROFILE_CONCAT(implus_profile_scope_, __LINE__)                                     \
+    }
+#define IMPLUS_PROFILE_FRAME() ::ImPlus::Profiler::EndFrame()
+#define IMPLUS_PROFILE_INPUT() ::ImPlus::Profiler::PollInput()
+
+#else
+
+#define IMPLUS_PROFILE_SCOPE(name) static_cast<void>(0)
+#define IMPLUS_PROFILE_FRAME() static_cast<void>(0)
+#define IMPLUS_PROFILE_INPUT() static_cast<void>(0)
+
+#endif
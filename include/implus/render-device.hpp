@@ -3,6 +3,8 @@
 #include <functional>
 #include <cstdint>
 
+#include <imgui.h>
+
 #if defined(IMPLUS_RENDER_DX11)
 #include <d3d11.h>
 #elif defined(IMPLUS_RENDER_VULKAN)
@@ -43,12 +45,66 @@ auto GetFrameInfo() -> Render::FrameInfo;
 inline std::function<void(DeviceInfo const& info)> OnDeviceChange;
 
 // hints
-
+//
+// - Vulkan_MinImageCount is the minimum number of swap chain images requested
+//   from the surface (>= 2), the driver may create more
+// - Vulkan_PresentMode is a VkPresentModeKHR (FIFO, MAILBOX or IMMEDIATE),
+//   FIFO is used when the surface doesn't support it
+// - Vulkan_BufferReserve is the minimum size in bytes of the vertex and index
+//   buffers of each frame, set before the window is created
+// - hints that change the swap chain apply from the next frame
+//
 enum U32Hint {
     Vulkan_CombinedImageSamplerCount,
     Vulkan_DescriptorPoolMaxSets,
+    Vulkan_MinImageCount,
+    Vulkan_PresentMode,
+    Vulkan_BufferReserve,
 };
 
 void SetHint(U32Hint h, uint32_t value);
 
+// textures
+//
+// - pixels are 8-bit RGBA with straight alpha, stride is the distance between
+//   rows in bytes (0 for tightly packed rows), null pixels clear the texture
+// - CreateTexture returns a null texture when the renderer isn't set up (or
+//   was shut down) or the texture can't be created, callers must check it
+// - textures are created, updated and destroyed on the main thread, updates
+//   are visible to draw commands submitted with the next RenderDrawData
+// - textures that are still alive when the renderer shuts down are released
+//   by the backend, destroying them afterwards is a no-op
+//
+auto CreateTexture(int width, int height, void const* pixels = nullptr, int stride = 0)
+    -> ImTextureID;
+void UpdateTexture(
+    ImTextureID tex, int x, int y, int width, int height, void const* pixels, int stride = 0);
+void DestroyTexture(ImTextureID tex);
+
+#if defined(IMPLUS_RENDER_VULKAN)
+// RegisterTexture makes an image view owned by the application drawable with
+// ImGui::Image, without a cap on the number of textures; a null sampler uses
+// the linear, clamp-to-edge sampler of CreateTexture
+auto RegisterTexture(VkImageView view,
+    VkImageLayout layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+    VkSampler sampler = VK_NULL_HANDLE) -> ImTextureID;
+
+// UnregisterTexture releases the texture handle, its descriptor set is reused
+// once the frames in flight have completed; the view must stay valid until
+// then
+void UnregisterTexture(ImTextureID tex);
+#endif
+
+#if defined(IMPLUS_RENDER_SOFTWARE)
+// Framebuffer is the image of the last frame rendered by the software
+// renderer: 8-bit RGBA rows, tightly packed, valid until the next frame
+struct Framebuffer {
+    int Width = 0;
+    int Height = 0;
+    std::uint8_t const* Pixels = nullptr;
+};
+
+auto GetFramebuffer() -> Framebuffer;
+#endif
+
 } // namespace ImPlus::Render
\ No newline at end of file
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <utility>
+
+namespace ImPlus::Scheduler {
+
+// Scheduler runs deferred work on the UI thread in slices of a per-frame time
+// budget, so that expensive non-rendering work (sorting, reflowing text,
+// rebuilding caches) never causes a frame spike
+//
+// - work items run highest priority first, items of the same priority take
+//   turns in the order they were scheduled
+// - at least one step runs per frame, so that a step longer than the budget
+//   still makes progress
+// - Application::Base::Run calls RunFrameSlice before rendering the frame and
+//   keeps rendering while work is pending
+//
+// Schedule and RunFrameSlice are called from the UI thread only, use
+// Application::Post to hand work over from other threads.
+
+enum class Priority {
+    High,
+    Normal,
+    Low,
+};
+
+// Work performs one step, returns true when done or false to be called again
+using Work = std::function<bool()>;
+
+// Task is a coroutine scheduled as work, it yields steps with
+// `co_await Scheduler::Yield{};`
+struct Task {
+    struct promise_type {
+        std::exception_ptr exception;
+
+        auto get_return_object() -> Task
+        {
+            return Task{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        auto initial_suspend() noexcept -> std::suspend_always { return {}; }
+        auto final_suspend() noexcept -> std::suspend_always { return {}; }
+        void return_void() {}
+        void unhandled_exception() { exception = std::current_exception(); }
+    };
+
+    explicit Task(std::coroutine_handle<promise_type> h)
+        : handle{h}
+    {
+    }
+    Task(Task&& other) noexcept
+        : handle{std::exchange(other.handle, {})}
+    {
+    }
+    Task(Task const&) = delete;
+    auto operator=(Task const&) -> Task& = delete;
+    ~Task()
+    {
+        if (handle)
+            handle.destroy();
+    }
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+struct Yield : std::suspend_always {};
+
+void Schedule(Work work, Priority priority = Priority::Normal);
+void Schedule(Task task, Priority priority = Priority::Normal);
+
+// SetFrameBudget sets the time spent on work per frame in seconds (4 ms by
+// default)
+void SetFrameBudget(double seconds);
+auto GetFrameBudget() -> double;
+
+// Pending returns the number of scheduled work items that are not done yet
+auto Pending() -> std::size_t;
+auto Pending(Priority priority) -> std::size_t;
+
+// RunFrameSlice runs work until the frame budget is used up, exceptions thrown
+// by work items propagate to the caller
+void RunFrameSlice();
+
+} // namespace ImPlus::Scheduler
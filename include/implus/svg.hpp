@@ -0,0 +1,64 @@
+#pragma once
+
+#include <imgui.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+#include <implus/icon.hpp>
+#include <implus/length.hpp>
+
+namespace ImPlus {
+
+namespace internal::svg {
+struct document;
+}
+
+// SvgImage is a vector image for icons, parsed once and rasterized on demand
+//
+// - supports the subset of SVG used by icon sets: path, rect, circle,
+//   ellipse, line, polyline and polygon elements, groups, transforms, solid
+//   fills and strokes (round joins and caps), nonzero and evenodd fill rules
+// - gradients, text, clipping, masks, dashes and stylesheets are not
+//   supported
+// - currentColor and unspecified fills take the icon color; images with
+//   explicit colors keep them and take only the alpha of the icon color
+//
+// Rasters are cached per pixel size in a texture atlas shared by all SVG
+// images
+//
+// - the first raster of an image is produced while drawing
+// - after a zoom or DPI change the previous raster is drawn scaled while the
+//   new size is rasterized on a worker thread
+// - the atlas is limited by SetCacheBudget, least recently drawn rasters are
+//   evicted first
+//
+struct SvgImage : public GraphicalResource {
+    // width or height set to zero follow the aspect ratio of the image,
+    // throws std::runtime_error if the text is not an SVG document
+    explicit SvgImage(std::string_view svg, length width = 0_em, length height = 1_em);
+    ~SvgImage() override;
+
+    SvgImage(SvgImage const&) = delete;
+    auto operator=(SvgImage const&) -> SvgImage& = delete;
+
+    auto GetSize() -> ImVec2 override;
+    void Render(ImDrawList*, ImVec2 const& xy, ImU32 clr) override;
+
+    // SetCacheBudget limits the texture memory of the shared raster atlas, in
+    // bytes (16 MiB by default)
+    static void SetCacheBudget(std::size_t bytes);
+    static auto CacheMemoryUsage() -> std::size_t;
+
+private:
+    std::shared_ptr<internal::svg::document const> doc_;
+    std::uint64_t id_ = 0;
+    length width_;
+    length height_;
+    int shown_w_ = 0; // size of the raster drawn last
+    int shown_h_ = 0;
+};
+
+} // namespace ImPlus
@@ -0,0 +1,269 @@
+#include <implus/alloc-tracker.hpp>
+
+#include <imgui.h>
+#include <imgui_internal.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cfloat>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <utility>
+
+namespace ImPlus::AllocTracker {
+
+static constexpr auto max_scopes = 64;
+static constexpr auto history = 240; // frames
+
+// the tracker must not allocate: scopes live in fixed tables and the counters
+// of the UI thread are plain thread-locals
+static auto scope_names = std::array<char const*, max_scopes>{"(untagged)"};
+static auto scope_count = std::atomic<int>{1};
+static auto scope_mutex = std::mutex{};
+
+static auto total_allocations = std::atomic<std::size_t>{0};
+static auto total_bytes = std::atomic<std::size_t>{0};
+
+static thread_local auto current_scope = 0;
+static thread_local auto ui_thread = false;
+static thread_local auto frame_counts = std::array<Counts, max_scopes>{};
+
+struct scope_stats {
+    Counts last = {};
+    std::size_t peak_allocations = 0;
+    std::size_t sum_allocations = 0; // over the recorded frames
+};
+
+static auto scopes = std::array<scope_stats, max_scopes>{};
+static auto frame_allocations = std::array<float, history>{};
+static auto last_frame = Counts{};
+static auto head = 0;
+static auto filled = 0;
+
+static auto budget = std::size_t{0};
+static auto budget_enabled = false;
+static auto settle_frames = 10;
+static auto quiet_frames = 0;
+static auto budget_violations = 0;
+
+static void count(std::size_t n)
+{
+    total_allocations.fetch_add(1, std::memory_order_relaxed);
+    total_bytes.fetch_add(n, std::memory_order_relaxed);
+    if (ui_thread) {
+        auto& c = frame_counts[current_scope];
+        ++c.Allocations;
+        c.Bytes += n;
+    }
+}
+
+auto RegisterScope(char const* name) -> int
+{
+    auto lock = std::lock_guard{scope_mutex};
+    auto const n = scope_count.load(std::memory_order_relaxed);
+    for (auto i = 1; i < n; ++i)
+        if (std::strcmp(scope_names[i], name) == 0)
+            return i;
+    if (n == max_scopes)
+        return 0;
+    scope_names[n] = name;
+    scope_count.store(n + 1, std::memory_order_release);
+    return n;
+}
+
+auto ScopeCount() -> int { return scope_count.load(std::memory_order_acquire); }
+
+auto ScopeName(int scope) -> char const* { return scope_names[scope]; }
+
+auto EnterScope(int scope) -> int { return std::exchange(current_scope, scope); }
+
+void LeaveScope(int previous) { current_scope = previous; }
+
+auto Totals() -> Counts
+{
+    return {total_allocations.load(std::memory_order_relaxed),
+        total_bytes.load(std::memory_order_relaxed)};
+}
+
+auto LastFrame() -> Counts { return last_frame; }
+
+auto LastFrame(int scope) -> Counts { return scopes[scope].last; }
+
+void EndFrame()
+{
+    ui_thread = true;
+
+    auto frame = Counts{};
+    auto const n = ScopeCount();
+    for (auto i = 0; i < n; ++i) {
+        auto& s = scopes[i];
+        s.last = std::exchange(frame_counts[i], Counts{});
+        s.peak_allocations = std::max(s.peak_allocations, s.last.Allocations);
+        s.sum_allocations += s.last.Allocations;
+        frame.Allocations += s.last.Allocations;
+        frame.Bytes += s.last.Bytes;
+    }
+    last_frame = frame;
+    frame_allocations[head] = float(frame.Allocations);
+    head = (head + 1) % history;
+    filled = std::min(filled + 1, history);
+
+    auto const g = ImGui::GetCurrentContext();
+    auto const had_input = g && !g->InputEventsTrail.empty();
+    quiet_frames = had_input ? 0 : quiet_frames + 1;
+    if (budget_enabled && quiet_frames > settle_frames && frame.Allocations > budget) {
+        ++budget_violations;
+        IM_ASSERT(false && "steady-state frame allocation budget exceeded, "
+                           "see DBGW::ImPlusAllocations");
+    }
+}
+
+void SetFrameBudget(std::size_t allocations, int settle)
+{
+    budget = allocations;
+    budget_enabled = true;
+    settle_frames = std::max(settle, 0);
+    quiet_frames = 0;
+}
+
+void ClearFrameBudget() { budget_enabled = false; }
+
+void Reset()
+{
+    for (auto& s : scopes)
+        s = {};
+    last_frame = {};
+    head = 0;
+    filled = 0;
+    quiet_frames = 0;
+    budget_violations = 0;
+}
+
+void ShowWindow(bool* p_open)
+{
+    ImGui::SetNextWindowSize({480, 420}, ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("ImPlus Allocations##implus-allocations", p_open)) {
+        ImGui::End();
+        return;
+    }
+
+    if (ImGui::Button("Reset"))
+        Reset();
+    ImGui::SameLine();
+    ImGui::Text("%d frames", filled);
+    if (budget_enabled) {
+        ImGui::SameLine();
+        ImGui::Text("| budget %zu, %d violations", budget, budget_violations);
+    }
+
+    auto const peak = filled ? *std::max_element(frame_allocations.begin(),
+                                   frame_allocations.begin() + filled)
+                             : 0.0f;
+    char overlay[64];
+    snprintf(overlay, sizeof(overlay), "last %zu allocs, %zu bytes", last_frame.Allocations,
+        last_frame.Bytes);
+    ImGui::PlotHistogram("##frame-allocs", frame_allocations.data(), filled,
+        filled < history ? 0 : head, overlay, 0.0f, std::max(peak, 1.0f) * 1.1f,
+        ImVec2{-FLT_MIN, 80.0f});
+
+    auto const totals = Totals();
+    ImGui::Text("process: %zu allocations, %zu bytes", totals.Allocations, totals.Bytes);
+
+    auto const flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg |
+                       ImGuiTableFlags_SizingStretchProp | ImGuiTableFlags_ScrollY;
+    if (ImGui::BeginTable("##scopes", 5, flags)) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Scope", ImGuiTableColumnFlags_WidthStretch, 3.0f);
+        ImGui::TableSetupColumn("Allocs");
+        ImGui::TableSetupColumn("Bytes");
+        ImGui::TableSetupColumn("Avg");
+        ImGui::TableSetupColumn("Peak");
+        ImGui::TableHeadersRow();
+
+        auto const n = ScopeCount();
+        for (auto i = 0; i < n; ++i) {
+            auto const& s = scopes[i];
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(scope_names[i]);
+            ImGui::TableNextColumn();
+            ImGui::Text("%zu", s.last.Allocations);
+            ImGui::TableNextColumn();
+            ImGui::Text("%zu", s.last.Bytes);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", filled ? double(s.sum_allocations) / filled : 0.0);
+            ImGui::TableNextColumn();
+            ImGui::Text("%zu", s.peak_allocations);
+        }
+        ImGui::EndTable();
+    }
+
+    ImGui::End();
+}
+
+// ImGui allocates its vectors and draw lists with ImGui::MemAlloc (malloc by
+// default) rather than operator new, the tracker installs counting allocator
+// functions before any context is created; they still use malloc and free, so
+// memory allocated before or after them is released correctly
+
+static auto imgui_alloc(std::size_t n, void*) -> void*
+{
+    count(n);
+    return std::malloc(n);
+}
+
+static void imgui_free(void* p, void*) { std::free(p); }
+
+[[maybe_unused]] static auto const imgui_allocator = [] {
+    ImGui::SetAllocatorFunctions(imgui_alloc, imgui_free);
+    return true;
+}();
+
+} // namespace ImPlus::AllocTracker
+
+// replaceable allocation functions, the aligned forms keep their default
+// implementation
+
+static auto tracked_alloc(std::size_t n) -> void*
+{
+    ImPlus::AllocTracker::count(n);
+    if (n == 0)
+        n = 1;
+    for (;;) {
+        if (auto p = std::malloc(n))
+            return p;
+        auto handler = std::get_new_handler();
+        if (!handler)
+            throw std::bad_alloc{};
+        handler();
+    }
+}
+
+auto operator new(std::size_t n) -> void* { return tracked_alloc(n); }
+auto operator new[](std::size_t n) -> void* { return tracked_alloc(n); }
+
+auto operator new(std::size_t n, std::nothrow_t const&) noexcept -> void*
+{
+    try {
+        return tracked_alloc(n);
+    }
+    catch (std::bad_alloc const&) {
+        return nullptr;
+    }
+}
+
+auto operator new[](std::size_t n, std::nothrow_t const& nt) noexcept -> void*
+{
+    return operator new(n, nt);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::nothrow_t const&) noexcept { std::free(p); }
+void operator delete[](void* p, std::nothrow_t const&) noexcept { std::free(p); }
@@ -1,9 +1,18 @@
 #include <imgui_internal.h>
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <implus/application.hpp>
 #include <implus/dlg.hpp>
+#include <implus/input-replay.hpp>
+#include <implus/alloc-tracker.hpp>
+#include <implus/profiler.hpp>
+#include <implus/scheduler.hpp>
 #include <thread>
+#include <utility>
+
+#include "internal/mpsc-queue.hpp"
 
 #ifdef __EMSCRIPTEN__
 #include <emscripten.h>
@@ -20,6 +29,104 @@ struct loop_args {
 void emscripten_loop(void*);
 #endif
 
+static std::optional<double> animation_deadline;
+
+void RequestAnimationFrame(double time)
+{
+    if (!animation_deadline || time < *animation_deadline)
+        animation_deadline = time;
+}
+
+auto TakeAnimationFrame() -> std::optional<double>
+{
+    return std::exchange(animation_deadline, std::nullopt);
+}
+
+static auto idle_mode = IdleMode::Continuous;
+static auto idle_frames_after_input = 3;
+static std::atomic<bool> redraw_requested = false;
+
+void SetIdleMode(IdleMode mode, int frames_after_input)
+{
+    idle_mode = mode;
+    idle_frames_after_input = std::max(frames_after_input, 1);
+}
+
+auto GetIdleMode() -> IdleMode { return idle_mode; }
+
+void RequestRedraw()
+{
+    redraw_requested = true;
+    Host::PostEmptyEvent();
+}
+
+static auto posted_tasks = internal::mpsc_queue<std::function<void()>>{};
+static auto post_budget = 0.0;
+
+void Post(std::function<void()> task)
+{
+    posted_tasks.push(std::move(task));
+    RequestRedraw();
+}
+
+void SetPostBudget(double seconds) { post_budget = std::max(seconds, 0.0); }
+
+void RunPostedTasks()
+{
+    using clock = std::chrono::steady_clock;
+    auto const end = clock::now() + std::chrono::duration<double>(post_budget);
+    while (auto task = posted_tasks.pop()) {
+        if (*task)
+            (*task)();
+        if (post_budget > 0.0 && clock::now() >= end) {
+            if (!posted_tasks.empty())
+                redraw_requested = true; // continue in the next frame
+            break;
+        }
+    }
+}
+
+// had_input returns true if the last frame handled input events or input is
+// held down, which needs frames for key repeat and dragging
+static auto had_input() -> bool
+{
+    auto& g = *GImGui;
+    if (g.InputEventsTrail.Size > 0 || g.MovingWindow)
+        return true;
+    for (auto down : g.IO.MouseDown)
+        if (down)
+            return true;
+    for (auto k = int(ImGuiKey_NamedKey_BEGIN); k < int(ImGuiKey_NamedKey_END); ++k)
+        if (ImGui::IsKeyDown(ImGuiKey(k)))
+            return true;
+    return false;
+}
+
+// request_imgui_frames requests the frames ImGui needs without input: a
+// blinking text cursor, delayed tooltips and the modal dimming fade
+static void request_imgui_frames()
+{
+    auto& g = *GImGui;
+    if (g.DimBgRatio > 0.0f && g.DimBgRatio < 1.0f)
+        RequestAnimationFrame(g.Time);
+    if (g.IO.WantTextInput && g.IO.ConfigInputTextCursorBlink)
+        RequestAnimationFrameIn(0.1);
+    if (g.HoverItemDelayId &&
+        g.HoverItemDelayTimer < g.Style.HoverDelaySlow + g.Style.HoverStationaryDelay)
+        RequestAnimationFrameIn(0.05);
+}
+
+// content_scale returns the window scale, or the recorded scale while an input
+// log is replayed
+static auto content_scale(Host::Window const& w) -> Host::Window::Scale
+{
+#ifdef IMPLUS_ENABLE_INPUT_REPLAY
+    if (auto s = InputReplay::ContentScale())
+        return *s;
+#endif
+    return w.ContentScale();
+}
+
 void Base::Run(std::function<void()> on_render)
 {
     auto& w = main_wnd_;
@@ -27,8 +134,13 @@ void Base::Run(std::function<void()> on_render)
     Dlg::internal::Initialize();
 
     auto render_frame = [&](bool poll_events) {
+        IMPLUS_PROFILE_SCOPE("frame");
+
+        IMPLUS_PROFILE_INPUT();
         w.NewFrame(poll_events);
 
+        RunPostedTasks();
+
         for (auto&& cb : Callbacks::BeforeFrame)
             cb();
 
@@ -38,6 +150,8 @@ void Base::Run(std::function<void()> on_render)
         for (auto&& cb : Callbacks::RenderFrame)
             cb();
 
+        Scheduler::RunFrameSlice();
+
         w.RenderFrame();
 
         // execute callbacks scheduled at the end of each frame
@@ -50,11 +164,18 @@ void Base::Run(std::function<void()> on_render)
         Callbacks::AfterThisFrame.clear();
     };
 
-    w.OnRefresh = [&]() { render_frame(false); };
+    w.OnRefresh = [&]() {
+        // the system asks to repaint the window, never skip this frame
+        w.InvalidateFrame();
+        render_frame(false);
+        IMPLUS_PROFILE_FRAME();
+        IMPLUS_ALLOC_FRAME();
+        IMPLUS_REPLAY_END_FRAME();
+    };
 
     // To avoid initial flicker, pre-render first frame before the
     // window is shown
-    ImPlus::Visuals::SetupFrame(w.ContentScale());
+    ImPlus::Visuals::SetupFrame(content_scale(w));
 #ifndef __EMSCRIPTEN__
     render_frame(false);
     w.Show();
@@ -65,8 +186,24 @@ void Base::Run(std::function<void()> on_render)
     emscripten_set_main_loop_arg(emscripten_loop, &args, 0, true);
 
 #else
+    using clock = std::chrono::steady_clock;
+    auto frame_start = clock::now();
+    auto frames_left = idle_frames_after_input; // frames to render before waiting
+    auto deadline = std::optional<double>{};
+    auto display_size = ImVec2{};
+
     while (!w.ShouldClose()) {
-        if (ImPlus::Visuals::SetupFrame(w.ContentScale())) {
+        if (idle_mode == IdleMode::PowerSaving && frames_left <= 0 && !redraw_requested) {
+            auto timeout = -1.0;
+            if (deadline) {
+                auto const elapsed = std::chrono::duration<double>(clock::now() - frame_start);
+                timeout = std::max(0.0, *deadline - ImGui::GetTime() - elapsed.count());
+            }
+            Host::WaitEvents(timeout);
+        }
+        redraw_requested = false;
+
+        if (ImPlus::Visuals::SetupFrame(content_scale(w))) {
             // SetupFrame returns true if one of the following has changed:
             // - Visuals::Zoom
             // - window.Scale
@@ -76,7 +213,23 @@ void Base::Run(std::function<void()> on_render)
             // update or invalidate those here
         }
 
+        frame_start = clock::now();
         render_frame(true);
+        IMPLUS_PROFILE_FRAME();
+        IMPLUS_ALLOC_FRAME();
+        IMPLUS_REPLAY_END_FRAME();
+
+        request_imgui_frames();
+        deadline = TakeAnimationFrame();
+        auto const& io = ImGui::GetIO();
+        if (had_input() || io.DisplaySize.x != display_size.x ||
+            io.DisplaySize.y != display_size.y) {
+            frames_left = idle_frames_after_input;
+            display_size = io.DisplaySize;
+        }
+        else {
+            --frames_left;
+        }
 
         if (w.IsMinimized())
             std::this_thread::sleep_for(std::chrono::milliseconds(20));
@@ -89,7 +242,7 @@ void emscripten_loop(void* args_ptr)
 {
     auto& args = *reinterpret_cast<loop_args*>(args_ptr);
 
-    if (ImPlus::Visuals::SetupFrame(args.w.ContentScale())) {
+    if (ImPlus::Visuals::SetupFrame(content_scale(args.w))) {
         // SetupFrame returns true if one of the following has changed:
         // - Visuals::Zoom
         // - window.Scale
@@ -99,8 +252,11 @@ void emscripten_loop(void* args_ptr)
         // update or invalidate those here
     }
 
+    IMPLUS_PROFILE_INPUT();
     args.w.NewFrame(true);
 
+    RunPostedTasks();
+
     for (auto&& cb : Callbacks::BeforeFrame)
         cb();
 
@@ -110,6 +266,8 @@ void emscripten_loop(void* args_ptr)
     for (auto&& cb : Callbacks::RenderFrame)
         cb();
 
+    Scheduler::RunFrameSlice();
+
     args.w.RenderFrame();
 
     // execute callbacks scheduled at the end of each frame
@@ -120,6 +278,10 @@ void emscripten_loop(void* args_ptr)
         cb();
 
     Callbacks::AfterThisFrame.clear();
+
+    IMPLUS_PROFILE_FRAME();
+    IMPLUS_ALLOC_FRAME();
+    IMPLUS_REPLAY_END_FRAME();
 }
 #endif
 
@@ -1,6 +1,7 @@
 #define IMGUI_DEFINE_MATH_OPERATORS
 #include <imgui_internal.h>
 
+#include "implus/application.hpp"
 #include "implus/balloontip.hpp"
 #include "implus/geometry.hpp"
 #include "implus/length.hpp"
@@ -62,6 +63,10 @@ void BalloonTip(ImID anchor_id, ImVec2 const& anchor_bb_min, ImVec2 const& ancho
     if (d > solid_duration) {
         d -= solid_duration;
         opacity *= 1.0f - (1.0f * d / fade_duration);
+        Application::RequestAnimationFrame(now);
+    }
+    else {
+        Application::RequestAnimationFrame(*show_time + solid_duration);
     }
 
     auto padding = to_pt(0.25_em);
@@ -1,8 +1,13 @@
 #define IMGUI_DEFINE_MATH_OPERATORS
 #include <imgui_internal.h>
 
+#include "implus/alloc-tracker.hpp"
 #include "implus/blocks.hpp"
+#include "implus/draw-stats.hpp"
+#include "implus/profiler.hpp"
+#include "internal/advance-table.hpp"
 #include "internal/draw-utils.hpp"
+#include "internal/glyph-batch.hpp"
 #include <cmath>
 #include <lbrk.hpp>
 
@@ -19,11 +24,6 @@ inline auto find_next_line(char const* text, char const* text_end) -> char const
     return text;
 }
 
-auto unscaled_char_width(ImFont const& font, unsigned int c) -> float
-{
-    return int(c) < font.IndexAdvanceX.Size ? font.IndexAdvanceX.Data[c] : font.FallbackAdvanceX;
-}
-
 struct calc_line_result {
     line_view line;
     char const* next;
@@ -33,6 +33,7 @@ auto calc_line_wrap(ImFont const& font, float font_size, float wrap_width, char
     char const* text_end, bool allow_emergency_break) -> calc_line_result
 {
     auto const scale = font_size / font.FontSize;
+    auto const& unscaled_char_width = internal::advance_table_of(font);
     wrap_width /= scale; // work with unscaled widths to avoid scaling every characters
 
     struct split_result {
@@ -63,7 +64,7 @@ auto calc_line_wrap(ImFont const& font, float font_size, float wrap_width, char
                     avail_advance};
 
             curr = next;
-            next_advance += unscaled_char_width(font, c);
+            next_advance += unscaled_char_width(c);
             if (first || next_advance <= avail_w) {
                 avail = curr;
                 avail_advance = next_advance;
@@ -120,6 +121,7 @@ auto calc_next_line(
     ImFont const& font, float font_size, char const* first, char const* last) -> calc_line_result
 {
     auto const scale = font_size / font.FontSize;
+    auto const& unscaled_char_width = internal::advance_table_of(font);
 
     auto line_advance = 0.0f;    // includes trailing white space
     auto content_advance = 0.0f; // excludes trailing white space
@@ -135,7 +137,7 @@ auto calc_next_line(
         if (c == '\n')
             break;
 
-        line_advance += unscaled_char_width(font, c);
+        line_advance += unscaled_char_width(c);
         if (!ImCharIsBlankW(c)) {
             content_advance = line_advance;
             content_end = curr;
@@ -154,6 +156,7 @@ void ellipsify_line(
     }
 
     auto const scale = font_size / font.FontSize;
+    auto const& unscaled_char_width = internal::advance_table_of(font);
     auto const ellipsis_width = font.EllipsisWidth * scale;
     auto const fit_w = std::max(1.0f, *avail_w - ellipsis_width);
 
@@ -175,7 +178,7 @@ void ellipsify_line(
         auto c = static_cast<unsigned int>(*curr);
         curr += ((c < 0x80) ? 1 : ImTextCharFromUtf8(&c, curr, last));
 
-        curr_advance += scale * unscaled_char_width(font, c);
+        curr_advance += scale * unscaled_char_width(c);
         if (ImCharIsBlankW(c))
             continue;
 
@@ -202,6 +205,9 @@ struct MeasureTextResult {
 auto MeasureTextEx(ImFont* fnt, float fnt_size, std::string_view s, Text::OverflowPolicy const& op,
     std::optional<float> const& ow) -> MeasureTextResult
 {
+    IMPLUS_PROFILE_SCOPE("text.measure");
+    IMPLUS_ALLOC_SCOPE("text.blocks");
+
     auto ret = MeasureTextResult{};
 
     auto& font = fnt ? *fnt : *GImGui->Font;
@@ -320,9 +326,9 @@ auto vceil(ImVec2 const& v) -> ImVec2 { return ImVec2{std::ceil(v.x), std::ceil(
 // ------ blocks --------
 
 IconBlock::IconBlock(ImPlus::Icon const& icon)
-    : icon_{icon}
+    : BlockBase{vceil(icon.Measure())} // measure the source, the copy inherits its cached glyph size
+    , icon_{icon}
 {
-    Size = vceil(icon_.Measure());
 }
 
 IconBlock::IconBlock(ImPlus::Icon&& icon)
@@ -370,12 +376,15 @@ TextBlock::TextBlock(std::string_view content, ImVec2 const& align, Text::Overfl
     , font_{font}
     , font_scale_{font_scale}
 {
+    IMPLUS_ALLOC_SCOPE("text.blocks");
+
     if (!content_.empty()) {
         auto prev = GImGui->Font;
         if (font_ && font_ != prev)
             ImGui::SetCurrentFont(font_);
-        auto t = MeasureTextEx(GImGui->Font, GImGui->Font->FontSize * font_scale_, content_,
-            overflow_policy_, overflow_width_);
+        auto const font_size = GImGui->Font->FontSize * GImGui->Font->Scale * font_scale_;
+        auto t = MeasureTextEx(
+            GImGui->Font, font_size, content_, overflow_policy_, overflow_width_);
         if (font_ && font_ != prev)
             ImGui::SetCurrentFont(prev);
         lines_ = std::move(t.lines);
@@ -392,8 +401,8 @@ void TextBlock::Reflow(std::optional<pt_length> const& ow)
     auto prev = GImGui->Font;
     if (font_ && font_ != prev)
         ImGui::SetCurrentFont(font_);
-    auto t = MeasureTextEx(GImGui->Font, GImGui->Font->FontSize * font_scale_, content_,
-        overflow_policy_, overflow_width_);
+    auto const font_size = GImGui->Font->FontSize * GImGui->Font->Scale * font_scale_;
+    auto t = MeasureTextEx(GImGui->Font, font_size, content_, overflow_policy_, overflow_width_);
     if (font_ && font_ != prev)
         ImGui::SetCurrentFont(prev);
     lines_ = std::move(t.lines);
@@ -406,6 +415,8 @@ void TextBlock::Render(
     if (content_.empty())
         return;
 
+    IMPLUS_DRAW_SCOPE("text.block", dl);
+
     auto cr = ImRect{
         dl->GetClipRectMin(),
         dl->GetClipRectMax(),
@@ -426,6 +437,9 @@ void TextBlock::Render(
 
     const float line_height = std::round(font_size);
 
+    // the dots of an ellipsis take a single reservation
+    auto dots = internal::glyph_batch{dl};
+
     for (auto&& ln : lines_) {
         if (y + line_height < cr.Min.y) {
             y += line_height;
@@ -447,9 +461,10 @@ void TextBlock::Render(
         if (ln.ellipsis) {
             x += ln.advance;
             for (std::size_t i = 0; i < font.EllipsisCharCount; ++i) {
-                font.RenderChar(dl, font_size, {x, y}, clr32, font.EllipsisChar);
+                dots.add_char(font, font_size, {x, y}, clr32, font.EllipsisChar);
                 x += ellipsis_char_w;
             }
+            dots.flush();
         }
         y += line_height;
     }
@@ -498,12 +513,14 @@ void TextBlock::Display(ImVec2 const& size_arg) const
 
 auto MakeContentDrawCallback(TextBlock const& block) -> Content::DrawCallback
 {
+    IMPLUS_ALLOC_SCOPE("draw.callback");
     return [block](ImDrawList* dl, ImVec2 const& bb_min, ImVec2 const& bb_max,
                ColorSet const& colors) { block.Render(dl, bb_min, bb_max, colors.Content); };
 }
 
 auto MakeContentDrawCallback(TextBlock&& block) -> Content::DrawCallback
 {
+    IMPLUS_ALLOC_SCOPE("draw.callback");
     return [block = std::move(block)](ImDrawList* dl, ImVec2 const& bb_min, ImVec2 const& bb_max,
                ColorSet const& colors) { block.Render(dl, bb_min, bb_max, colors.Content); };
 }
@@ -636,6 +653,8 @@ ICDBlock::ICDBlock(ICD_view const& content, Content::Layout layout, ICDOptions c
     : layout_{layout}
     , icon_block_{content.Icon}
 {
+    IMPLUS_ALLOC_SCOPE("text.blocks");
+
     if (opts.WithDropdownArrow)
         dropdown_width_ = calc_dropdown_arrow_extra();
 
@@ -845,12 +864,14 @@ void ICDBlock::Display(ImVec2 const& size_arg) const
 
 auto MakeContentDrawCallback(ICDBlock const& block) -> Content::DrawCallback
 {
+    IMPLUS_ALLOC_SCOPE("draw.callback");
     return [block](ImDrawList* dl, ImVec2 const& bb_min, ImVec2 const& bb_max,
                ColorSet const& colors) { block.Render(dl, bb_min, bb_max, colors.Content); };
 }
 
 auto MakeContentDrawCallback(ICDBlock&& block) -> Content::DrawCallback
 {
+    IMPLUS_ALLOC_SCOPE("draw.callback");
     return [block = std::move(block)](ImDrawList* dl, ImVec2 const& bb_min, ImVec2 const& bb_max,
                ColorSet const& colors) { block.Render(dl, bb_min, bb_max, colors.Content); };
 }
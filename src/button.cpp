@@ -3,9 +3,11 @@
 
 #include <optional>
 
+#include <implus/alloc-tracker.hpp>
 #include <implus/blocks.hpp>
 #include <implus/button.hpp>
 #include <implus/color.hpp>
+#include <implus/draw-stats.hpp>
 #include <implus/dropdown.hpp>
 
 namespace ImPlus {
@@ -21,6 +23,8 @@ auto CustomButton(ImID id, char const* name, ImVec2 const& size, float baseline_
     if (window->SkipItems)
         return state;
 
+    IMPLUS_DRAW_SCOPE("button.custom", window->DrawList);
+
     auto pos = window->DC.CursorPos;
     if ((flags & ImGuiButtonFlags_AlignTextBaseLine) &&
         baseline_offset < window->DC.CurrLineTextBaseOffset)
@@ -298,6 +302,7 @@ inline auto render_shaped_frame(
 auto MakeButtonDrawCallback(ButtonOptions const& opts, InteractColorSetCallback color_set,
     Content::DrawCallback&& on_content) -> ButtonDrawCallback
 {
+    IMPLUS_ALLOC_SCOPE("draw.callback");
     return [opts, color_set, on_content = std::move(on_content)](ImGuiID id, ImDrawList* dl,
                ImVec2 const& bb_min, ImVec2 const& bb_max, InteractState const& state) {
         auto const bb = ImRect{bb_min, bb_max};
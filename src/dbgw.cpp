@@ -13,6 +13,18 @@ auto showImGuiDemo = false;
 ImPlus::Demo::Window implusDemoWindow;
 auto showImPlusDemo = false;
 #endif
+#ifdef IMPLUS_ENABLE_PROFILER
+#include "implus/profiler.hpp"
+auto showImPlusProfiler = false;
+#endif
+#ifdef IMPLUS_ENABLE_ALLOC_TRACKING
+#include "implus/alloc-tracker.hpp"
+auto showImPlusAllocations = false;
+#endif
+#ifdef IMPLUS_ENABLE_DRAW_STATS
+#include "implus/draw-stats.hpp"
+auto showImPlusDrawStats = false;
+#endif
 
 namespace ImPlus::DBGW {
 
@@ -55,6 +67,27 @@ wnd ImPlusDemo = {
     nullptr
 #endif
 };
+wnd ImPlusProfiler = {
+#ifdef IMPLUS_ENABLE_PROFILER
+    &showImPlusProfiler
+#else
+    nullptr
+#endif
+};
+wnd ImPlusAllocations = {
+#ifdef IMPLUS_ENABLE_ALLOC_TRACKING
+    &showImPlusAllocations
+#else
+    nullptr
+#endif
+};
+wnd ImPlusDrawStats = {
+#ifdef IMPLUS_ENABLE_DRAW_STATS
+    &showImPlusDrawStats
+#else
+    nullptr
+#endif
+};
 
 auto PopulateMenuItems(bool wantSeparatorBefore) -> bool
 {
@@ -75,6 +108,9 @@ auto PopulateMenuItems(bool wantSeparatorBefore) -> bool
     handle(ImGuiMetrics, "ImGui Metrics##dbgw-imgui-metrics");
     handle(ImGuiDemo, "ImGui Demo##dbgw-imgui-demo");
     handle(ImPlusDemo, "ImPlus Demo##dbgw-implus-demo");
+    handle(ImPlusProfiler, "ImPlus Profiler##dbgw-implus-profiler");
+    handle(ImPlusAllocations, "ImPlus Allocations##dbgw-implus-allocations");
+    handle(ImPlusDrawStats, "ImPlus Draw Stats##dbgw-implus-draw-stats");
     return ret;
 }
 
@@ -93,6 +129,21 @@ void Display()
     if (showImPlusDemo)
         implusDemoWindow.Display(&showImPlusDemo);
 #endif
+
+#ifdef IMPLUS_ENABLE_PROFILER
+    if (showImPlusProfiler)
+        ImPlus::Profiler::ShowWindow(&showImPlusProfiler);
+#endif
+
+#ifdef IMPLUS_ENABLE_ALLOC_TRACKING
+    if (showImPlusAllocations)
+        ImPlus::AllocTracker::ShowWindow(&showImPlusAllocations);
+#endif
+
+#ifdef IMPLUS_ENABLE_DRAW_STATS
+    if (showImPlusDrawStats)
+        ImPlus::DrawStats::ShowWindow(&showImPlusDrawStats);
+#endif
 }
 
 } // namespace ImPlus::DBGW
\ No newline at end of file
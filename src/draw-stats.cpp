@@ -0,0 +1,277 @@
+#define IMGUI_DEFINE_MATH_OPERATORS
+#include <implus/draw-stats.hpp>
+
+#include <implus/application.hpp>
+#include <implus/render-device.hpp>
+
+#include "internal/raster.hpp"
+
+#include <imgui_internal.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <numeric>
+#include <vector>
+
+namespace ImPlus::DrawStats {
+
+static constexpr auto max_scopes = 64;
+static constexpr auto max_depth = 32;
+
+static auto scope_names = std::array<char const*, max_scopes>{};
+static auto scope_count = 0;
+
+static auto current = std::array<Counts, max_scopes>{};
+static auto last = std::array<Counts, max_scopes>{};
+static auto current_frame = -1;
+
+struct marker {
+    int scope;
+    ImDrawList const* dl;
+    int vtx, idx, cmd;                   // sizes of the draw list at Enter
+    int child_vtx, child_idx, child_cmd; // growth of nested markers on dl
+};
+
+static auto markers = std::array<marker, max_depth>{};
+static auto depth = 0;
+
+// roll closes the counts of the previous frame once a new frame has started
+static void roll()
+{
+    auto const frame = ImGui::GetFrameCount();
+    if (frame == current_frame)
+        return;
+    current_frame = frame;
+    last = current;
+    current.fill({});
+}
+
+auto RegisterScope(char const* name) -> int
+{
+    for (auto i = 0; i < scope_count; ++i)
+        if (std::strcmp(scope_names[i], name) == 0)
+            return i;
+    IM_ASSERT(scope_count < max_scopes && "too many draw statistics scopes");
+    scope_names[scope_count] = name;
+    return scope_count++;
+}
+
+auto ScopeCount() -> int { return scope_count; }
+
+auto ScopeName(int scope) -> char const* { return scope_names[scope]; }
+
+auto LastFrame(int scope) -> Counts { return last[scope]; }
+
+void Enter(int scope, ImDrawList const* dl)
+{
+    roll();
+    if (depth < max_depth) {
+        markers[depth] = {scope, dl, dl->VtxBuffer.Size, dl->IdxBuffer.Size, dl->CmdBuffer.Size,
+            0, 0, 0};
+    }
+    ++depth;
+}
+
+void Leave()
+{
+    --depth;
+    if (depth >= max_depth)
+        return;
+
+    auto const& m = markers[depth];
+    auto const vtx = m.dl->VtxBuffer.Size - m.vtx;
+    auto const idx = m.dl->IdxBuffer.Size - m.idx;
+    auto const cmd = m.dl->CmdBuffer.Size - m.cmd;
+
+    auto& c = current[m.scope];
+    ++c.Calls;
+    c.Vertices += vtx - m.child_vtx;
+    c.Indices += idx - m.child_idx;
+    c.Commands += cmd - m.child_cmd;
+
+    if (depth > 0 && markers[depth - 1].dl == m.dl) {
+        auto& parent = markers[depth - 1];
+        parent.child_vtx += vtx;
+        parent.child_idx += idx;
+        parent.child_cmd += cmd;
+    }
+}
+
+// overdraw heatmap of the main viewport
+
+struct heatmap {
+    bool enabled = false;
+    bool hooked = false;
+    int downsample = 2;
+    int width = 0;
+    int height = 0;
+    int max_count = 0;
+    float avg_count = 0.0f;
+    std::vector<std::uint8_t> counts;
+    std::vector<std::uint8_t> pixels;
+    ImTextureID texture = {};
+    int texture_width = 0;
+    int texture_height = 0;
+};
+
+static auto overdraw = heatmap{};
+
+// heat colors by fragment count, the last color is used for higher counts
+static constexpr ImU32 heat_colors[] = {
+    IM_COL32(0, 0, 0, 255),
+    IM_COL32(0, 0, 160, 255),
+    IM_COL32(0, 128, 255, 255),
+    IM_COL32(0, 200, 0, 255),
+    IM_COL32(255, 255, 0, 255),
+    IM_COL32(255, 128, 0, 255),
+    IM_COL32(255, 0, 0, 255),
+    IM_COL32(255, 255, 255, 255),
+};
+
+static void capture_overdraw()
+{
+    auto& h = overdraw;
+    if (!h.enabled)
+        return;
+
+    auto const dd = ImGui::GetDrawData();
+    if (!dd || !dd->Valid)
+        return;
+
+    auto const scale =
+        ImVec2{dd->FramebufferScale.x / h.downsample, dd->FramebufferScale.y / h.downsample};
+    h.width = std::max(int(dd->DisplaySize.x * scale.x), 1);
+    h.height = std::max(int(dd->DisplaySize.y * scale.y), 1);
+
+    auto const n = std::size_t(h.width) * h.height;
+    h.counts.assign(n, 0);
+    for (auto i = 0; i < dd->CmdListsCount; ++i) {
+        internal::rasterize_overdraw(
+            *dd->CmdLists[i], dd->DisplayPos, scale, h.width, h.height, h.counts.data(), h.width);
+    }
+
+    auto const sum = std::accumulate(h.counts.begin(), h.counts.end(), std::size_t{0});
+    h.max_count = *std::max_element(h.counts.begin(), h.counts.end());
+    h.avg_count = float(double(sum) / double(n));
+
+    h.pixels.resize(n * 4);
+    auto const last_color = std::size(heat_colors) - 1;
+    for (auto i = std::size_t{0}; i < n; ++i) {
+        auto const c = heat_colors[std::min<std::size_t>(h.counts[i], last_color)];
+        auto dst = h.pixels.data() + i * 4;
+        dst[0] = std::uint8_t(c >> IM_COL32_R_SHIFT);
+        dst[1] = std::uint8_t(c >> IM_COL32_G_SHIFT);
+        dst[2] = std::uint8_t(c >> IM_COL32_B_SHIFT);
+        dst[3] = std::uint8_t(c >> IM_COL32_A_SHIFT);
+    }
+
+    if (h.texture && (h.texture_width != h.width || h.texture_height != h.height)) {
+        Render::DestroyTexture(h.texture);
+        h.texture = {};
+    }
+    if (!h.texture) {
+        h.texture = Render::CreateTexture(h.width, h.height, h.pixels.data());
+        h.texture_width = h.width;
+        h.texture_height = h.height;
+    }
+    else {
+        Render::UpdateTexture(h.texture, 0, 0, h.width, h.height, h.pixels.data());
+    }
+}
+
+static void show_overdraw()
+{
+    auto& h = overdraw;
+    if (ImGui::Checkbox("Overdraw heatmap", &h.enabled) && h.enabled && !h.hooked) {
+        Application::Callbacks::AfterEachFrame.push_back(capture_overdraw);
+        h.hooked = true;
+    }
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(ImGui::GetFontSize() * 6.0f);
+    ImGui::SliderInt("Downsample", &h.downsample, 1, 8);
+    h.downsample = std::clamp(h.downsample, 1, 8);
+
+    if (!h.enabled || !h.texture)
+        return;
+
+    ImGui::Text("fragments per pixel: avg %.2f, max %d", h.avg_count, h.max_count);
+    auto const avail = ImGui::GetContentRegionAvail().x;
+    auto const aspect = float(h.texture_height) / float(h.texture_width);
+    ImGui::Image(h.texture, ImVec2{avail, avail * aspect});
+    if (ImGui::IsItemHovered() && ImGui::BeginTooltip()) {
+        auto const rel =
+            (ImGui::GetMousePos() - ImGui::GetItemRectMin()) / ImGui::GetItemRectSize();
+        auto const x = std::clamp(int(rel.x * h.texture_width), 0, h.texture_width - 1);
+        auto const y = std::clamp(int(rel.y * h.texture_height), 0, h.texture_height - 1);
+        if (std::size_t(y) * h.texture_width + x < h.counts.size())
+            ImGui::Text("%d fragments", h.counts[std::size_t(y) * h.texture_width + x]);
+        ImGui::EndTooltip();
+    }
+}
+
+void ShowWindow(bool* p_open)
+{
+    roll();
+
+    ImGui::SetNextWindowSize({480, 520}, ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("ImPlus Draw Stats##implus-draw-stats", p_open)) {
+        ImGui::End();
+        return;
+    }
+
+    // rows by vertices, the widgets producing the most geometry first
+    static auto order = std::vector<int>{};
+    order.resize(std::size_t(scope_count));
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+        [](int a, int b) { return last[a].Vertices > last[b].Vertices; });
+
+    auto total = Counts{};
+    for (auto i = 0; i < scope_count; ++i) {
+        total.Vertices += last[i].Vertices;
+        total.Indices += last[i].Indices;
+        total.Commands += last[i].Commands;
+    }
+    auto const dd = ImGui::GetDrawData();
+    auto const frame_vtx = dd && dd->Valid ? dd->TotalVtxCount : 0;
+    ImGui::Text("attributed %d of %d vertices", total.Vertices, frame_vtx);
+
+    auto const flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg |
+                       ImGuiTableFlags_SizingStretchProp | ImGuiTableFlags_ScrollY;
+    auto const table_h = ImGui::GetTextLineHeightWithSpacing() * 10.0f;
+    if (ImGui::BeginTable("##scopes", 5, flags, {0.0f, table_h})) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Scope", ImGuiTableColumnFlags_WidthStretch, 3.0f);
+        ImGui::TableSetupColumn("Calls");
+        ImGui::TableSetupColumn("Vertices");
+        ImGui::TableSetupColumn("Indices");
+        ImGui::TableSetupColumn("Commands");
+        ImGui::TableHeadersRow();
+
+        for (auto i : order) {
+            auto const& c = last[i];
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(scope_names[i]);
+            ImGui::TableNextColumn();
+            ImGui::Text("%d", c.Calls);
+            ImGui::TableNextColumn();
+            ImGui::Text("%d", c.Vertices);
+            ImGui::TableNextColumn();
+            ImGui::Text("%d", c.Indices);
+            ImGui::TableNextColumn();
+            ImGui::Text("%d", c.Commands);
+        }
+        ImGui::EndTable();
+    }
+
+    ImGui::Separator();
+    show_overdraw();
+
+    ImGui::End();
+}
+
+} // namespace ImPlus::DrawStats
@@ -334,8 +334,9 @@ void BeginMainInstructionGroup(
         auto blk = ImPlus::IconBlock{icon};
         auto save_pos = ImGui::GetCursorPosY();
         if (!main_instruction.empty()) {
-            if (auto f = GetMainInstructionFont().imfont(); f && f->FontSize > blk.Size.y) {
-                auto dy = (f->FontSize - blk.Size.y) * 0.5f;
+            auto const f = GetMainInstructionFont().imfont();
+            if (f && f->FontSize * f->Scale > blk.Size.y) {
+                auto dy = (f->FontSize * f->Scale - blk.Size.y) * 0.5f;
                 ImGui::SetCursorPosY(save_pos + dy);
             }
         }
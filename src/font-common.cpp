@@ -1,9 +1,19 @@
 #include "implus/font.hpp"
+#include "implus/profiler.hpp"
+#include "internal/distance-field.hpp"
 #include "internal/font-engine.hpp"
+#include "internal/glyph-prerender.hpp"
 
+#include <imgui_internal.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cmath>
 #include <fstream>
+#include <future>
 #include <string_view>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -67,6 +77,15 @@ struct resource_data : public ImFontConfig {
     percent bias_horz = 0.0f; // percentage, relative
     percent bias_vert = 0.0f; // percentage, relative
     ImFont* font = nullptr;
+
+    // coverage scan is deferred to Setup when no explicit ranges were
+    // specified, this allows scanning multiple faces concurrently
+    bool auto_ranges = false;
+    int face_index = 0;
+
+    // fallbacks loaded by LoadFallbacks are merged into this view (1-based),
+    // rather than into the preceding one
+    std::size_t merge_target = 0;
 };
 
 std::vector<resource_data> views;
@@ -77,9 +96,26 @@ unsigned int font_builder_flags = ImGuiFreeTypeBuilderFlags_ForceAutoHint;
 unsigned int font_builder_flags = 0;
 #endif
 
+// distance field atlas, see SetDistanceFieldAtlas
+bool distance_field_mode = false;
+constexpr auto distance_field_dpi = 192.0f;
+
+// distance_field_atlas is the atlas built by the last Setup in distance field
+// mode, its fonts are rescaled to other DPIs while atlas_rescalable is set
+ImFontAtlas* distance_field_atlas = nullptr;
+bool atlas_rescalable = false;
+
+// lines_unbaked is set while Setup keeps ImFontAtlasFlags_NoBakedLines on
+// the atlas, the baked lines are coverage and not distances
+bool lines_unbaked = false;
+
+// views_changed is called whenever the set of views changes, the atlas must
+// be built again rather than rescaled
+void views_changed() { atlas_rescalable = false; }
+
 void SetBuilderFlags(unsigned int flags) { font_builder_flags = flags; }
 
-auto range_set_from(face const& ff) -> range::codepoint*
+auto ranges_from(face const& ff) -> std::vector<range>
 {
     auto ranges = std::vector<range>{};
 
@@ -95,7 +131,7 @@ auto range_set_from(face const& ff) -> range::codepoint*
         }
     }
 
-    return make_rangeset(ranges.data(), ranges.data() + ranges.size());
+    return ranges;
 }
 
 auto calc_vert_bias(face const& ff) -> float
@@ -137,12 +173,14 @@ auto calc_vert_bias(face const& ff) -> float
     return 100.0f * (old_ratio - new_ratio) * new_height / old_height;
 }
 
-auto Load(BlobInfo const& bi, std::initializer_list<range> ranges, float point_size,
+auto load_view(BlobInfo const& bi, range const* first, range const* last, float point_size,
     Adjustment const& adj) -> Resource
 {
     auto ff = face{bi};
     auto fm = ff.get_metrics();
 
+    views_changed();
+
     auto& rv = views.emplace_back();
     rv.point_size = point_size * adj.Size / 100.0f;
     rv.bias_horz = adj.BiasHorz;
@@ -154,10 +192,11 @@ auto Load(BlobInfo const& bi, std::initializer_list<range> ranges, float point_s
 
     rv.FontNo = 0;
     rv.SizePixels = 12.0f;
-    if (ranges.size() == 0)
-        rv.GlyphRanges = range_set_from(ff);
+    rv.face_index = bi.FaceIndex;
+    if (first == last)
+        rv.auto_ranges = true;
     else
-        rv.GlyphRanges = make_rangeset(ranges.begin(), ranges.end());
+        rv.GlyphRanges = make_rangeset(first, last);
     rv.FontBuilderFlags = font_builder_flags;
     rv.PixelSnapH = 1; // snap all glyphs to pixel grid
 
@@ -168,6 +207,12 @@ auto Load(BlobInfo const& bi, std::initializer_list<range> ranges, float point_s
     return {id};
 }
 
+auto Load(BlobInfo const& bi, std::initializer_list<range> ranges, float point_size,
+    Adjustment const& adj) -> Resource
+{
+    return load_view(bi, ranges.begin(), ranges.end(), point_size, adj);
+}
+
 auto Load(FileInfo const& fi, std::initializer_list<range> ranges, float point_size,
     Adjustment const& adj) -> Resource
 {
@@ -180,9 +225,193 @@ auto Load(FileInfo const& fi, std::initializer_list<range> ranges, float point_s
     return Load(fbi, ranges, point_size, adj);
 }
 
+// chain_root returns the index of the non-merged view the view is merged into
+auto chain_root(std::size_t index) -> std::size_t
+{
+    if (views[index].merge_target)
+        return views[index].merge_target - 1;
+    while (index > 0 && views[index].MergeMode)
+        --index;
+    return index;
+}
+
+#ifdef IMPLUS_USE_FONTCONFIG
+
+// to_ranges compresses a sorted list of unique codepoints into ranges
+auto to_ranges(std::vector<range::codepoint> const& cps) -> std::vector<range>
+{
+    auto ret = std::vector<range>{};
+    for (auto cp : cps) {
+        if (!ret.empty() && ret.back().hi + 1 == cp)
+            ret.back().hi = cp;
+        else
+            ret.push_back(range{cp});
+    }
+    return ret;
+}
+
+// covered_by returns true if the view provides a glyph for the codepoint
+auto covered_by(resource_data const& v, face const& ff, char32_t cp) -> bool
+{
+    if (v.GlyphRanges) {
+        auto in_ranges = false;
+        for (auto r = v.GlyphRanges; r[0] && r[1]; r += 2)
+            if (cp >= r[0] && cp <= r[1]) {
+                in_ranges = true;
+                break;
+            }
+        if (!in_ranges)
+            return false;
+    }
+    return ff.glyph_index_of(cp) != face::nglyph;
+}
+
+auto face_of(resource_data const& v) -> face
+{
+    auto const data = static_cast<std::byte const*>(v.FontData);
+    return face{BlobInfo{std::span{data, std::size_t(v.FontDataSize)}, v.face_index}};
+}
+
+auto load_fallbacks(Resource base, std::vector<char32_t> needed, std::vector<char32_t>* uncovered)
+    -> std::vector<Resource>
+{
+    auto ret = std::vector<Resource>{};
+    if (uncovered)
+        uncovered->clear();
+    if (!base.view_id || base.view_id > views.size())
+        return ret;
+
+    std::sort(needed.begin(), needed.end());
+    needed.erase(std::unique(needed.begin(), needed.end()), needed.end());
+
+    // codepoints that ImWchar can't hold (no IMGUI_USE_WCHAR32) are reported
+    auto const wide = std::find_if(needed.begin(), needed.end(),
+        [](char32_t cp) { return cp > IM_UNICODE_CODEPOINT_MAX; });
+    if (uncovered)
+        uncovered->assign(wide, needed.end());
+    needed.erase(wide, needed.end());
+
+    // drop codepoints that are already covered by the base or its overlays
+    auto const base_index = chain_root(base.view_id - 1);
+    for (auto i = base_index; i < views.size() && !needed.empty(); ++i) {
+        auto const& v = views[i];
+        if (i != base_index && chain_root(i) != base_index)
+            continue;
+        auto const ff = face_of(v);
+        std::erase_if(needed, [&](char32_t cp) { return covered_by(v, ff, cp); });
+    }
+
+    if (!needed.empty()) {
+        auto cps = std::vector<range::codepoint>{needed.begin(), needed.end()};
+        auto const missing = to_ranges(cps);
+        auto const point_size = views[base_index].point_size;
+        auto const name = std::string{views[base_index].Name};
+
+        for (auto const& fi : GetFallbackFileInfos(name.c_str(), missing)) {
+            if (needed.empty())
+                break;
+
+            auto const b = buffer::get(fi.Filename.string());
+            if (b.empty())
+                continue;
+
+            auto const bi = BlobInfo{b, fi.FaceIndex};
+            auto const ff = face{bi};
+
+            // load only the ranges this face contributes
+            auto provided = std::vector<range::codepoint>{};
+            std::erase_if(needed, [&](char32_t cp) {
+                if (ff.glyph_index_of(cp) == face::nglyph)
+                    return false;
+                provided.push_back(range::codepoint(cp));
+                return true;
+            });
+            if (provided.empty())
+                continue;
+
+            auto const rs = to_ranges(provided);
+            if (auto r = load_view(bi, rs.data(), rs.data() + rs.size(), point_size, {})) {
+                views[r.view_id - 1].MergeMode = true;
+                views[r.view_id - 1].merge_target = base_index + 1;
+                ret.push_back(r);
+            }
+        }
+    }
+
+    if (uncovered) {
+        uncovered->insert(uncovered->end(), needed.begin(), needed.end());
+        std::sort(uncovered->begin(), uncovered->end());
+    }
+    return ret;
+}
+
+auto LoadFallbacks(Resource base, std::string_view corpus, std::vector<char32_t>* uncovered)
+    -> std::vector<Resource>
+{
+    auto needed = std::vector<char32_t>{};
+    auto curr = corpus.data();
+    auto const last = curr + corpus.size();
+    while (curr < last) {
+        auto c = static_cast<unsigned int>(static_cast<unsigned char>(*curr));
+        curr += c < 0x80 ? 1 : ImTextCharFromUtf8(&c, curr, last);
+        if (c >= 0x20)
+            needed.push_back(char32_t(c));
+    }
+    return load_fallbacks(base, std::move(needed), uncovered);
+}
+
+auto LoadFallbacks(Resource base, std::span<range const> scripts,
+    std::vector<char32_t>* uncovered) -> std::vector<Resource>
+{
+    auto needed = std::vector<char32_t>{};
+    for (auto const& r : scripts)
+        for (char32_t cp = r.lo; cp <= r.hi; ++cp)
+            needed.push_back(cp);
+    return load_fallbacks(base, std::move(needed), uncovered);
+}
+
+#endif
+
+// add_order returns the view indices in the order they are added to the atlas,
+// ImGui merges a view into the most recently added font, so fallbacks loaded
+// by LoadFallbacks are placed right after the overlays of their base
+auto add_order() -> std::vector<std::size_t>
+{
+    auto ret = std::vector<std::size_t>{};
+    ret.reserve(views.size());
+
+    auto append_fallbacks = [&](std::size_t base) {
+        for (std::size_t i = 0; i < views.size(); ++i)
+            if (views[i].merge_target == base + 1)
+                ret.push_back(i);
+    };
+
+    auto base = views.size();
+    for (std::size_t i = 0; i < views.size(); ++i) {
+        if (views[i].merge_target)
+            continue;
+        if (!views[i].MergeMode || ret.empty()) {
+            if (base != views.size())
+                append_fallbacks(base);
+            base = i;
+        }
+        ret.push_back(i);
+    }
+    if (base != views.size())
+        append_fallbacks(base);
+    return ret;
+}
+
 float lastDpi = 0.0f;
 float lastOversample = 0.0f;
 
+void RequestRebuild()
+{
+    lastDpi = 0.0f;
+    lastOversample = 0.0f;
+    views_changed();
+}
+
 auto CreateScaled(Resource h, float scale_factor, std::initializer_list<range> ranges) -> Resource
 {
     if (!h.view_id || h.view_id > views.size())
@@ -193,10 +422,14 @@ auto CreateScaled(Resource h, float scale_factor, std::initializer_list<range> r
     t.SizePixels *= scale_factor;
     t.GlyphOffset.x *= scale_factor;
     t.GlyphOffset.y *= scale_factor;
-    if (ranges.size() != 0)
+    if (ranges.size() != 0) {
         t.GlyphRanges = make_rangeset(ranges.begin(), ranges.end());
+        t.auto_ranges = false;
+    }
     t.MergeMode = false;
+    t.merge_target = 0;
 
+    views_changed();
     views.push_back(std::move(t));
     return Resource{views.size()};
 }
@@ -205,6 +438,7 @@ void SetMergeMode(Resource h, bool mergeWithPrev)
 {
     if (!h.view_id || h.view_id > views.size())
         return;
+    views_changed();
     views[h.view_id - 1].MergeMode = true;
 }
 
@@ -215,8 +449,318 @@ auto Resource::imfont() const -> ImFont*
     return views[view_id - 1].font;
 }
 
+using clock = std::chrono::steady_clock;
+
+inline auto seconds_since(clock::time_point t) -> double
+{
+    return std::chrono::duration<double>(clock::now() - t).count();
+}
+
+SetupTimings last_timings;
+std::size_t generation = 0;
+
+auto Generation() -> std::size_t { return generation; }
+
+auto GetSetupTimings() -> SetupTimings { return last_timings; }
+
+// resolve_auto_ranges scans glyph coverage for all views that were loaded
+// without explicit ranges. Unique faces are scanned by the calling thread and
+// at most hardware_concurrency - 1 workers, each face with its own face
+// instance (and, for FreeType, its own FT_Library). Rangesets are then
+// registered serially.
+auto resolve_auto_ranges() -> std::size_t
+{
+    struct job {
+        void const* data;
+        int size;
+        int face_index;
+        std::vector<range> result;
+    };
+
+    auto jobs = std::vector<job>{};
+    auto job_of = std::vector<std::size_t>(views.size(), std::size_t(-1));
+
+    for (std::size_t i = 0; i < views.size(); ++i) {
+        auto const& v = views[i];
+        if (!v.auto_ranges)
+            continue;
+        auto it = std::find_if(jobs.begin(), jobs.end(), [&](job const& j) {
+            return j.data == v.FontData && j.size == v.FontDataSize &&
+                   j.face_index == v.face_index;
+        });
+        if (it == jobs.end()) {
+            jobs.push_back({v.FontData, v.FontDataSize, v.face_index, {}});
+            it = std::prev(jobs.end());
+        }
+        job_of[i] = std::size_t(it - jobs.begin());
+    }
+
+    if (jobs.empty())
+        return 0;
+
+    auto scan = [](void const* data, int size, int face_index) {
+        auto bi = BlobInfo{std::span{static_cast<std::byte const*>(data), std::size_t(size)},
+            face_index};
+        return ranges_from(face{bi});
+    };
+
+    // workers and the calling thread take the next unscanned face
+    auto next = std::atomic<std::size_t>{0};
+    auto work = [&] {
+        for (auto i = next++; i < jobs.size(); i = next++) {
+            auto& j = jobs[i];
+            j.result = scan(j.data, j.size, j.face_index);
+        }
+    };
+    auto const threads = std::max(std::thread::hardware_concurrency(), 1u);
+    auto const workers = std::min(std::size_t(threads - 1), jobs.size() - 1);
+    auto pool = std::vector<std::future<void>>{};
+    pool.reserve(workers);
+    for (std::size_t i = 0; i < workers; ++i)
+        pool.push_back(std::async(std::launch::async, work));
+    work();
+    for (auto& f : pool)
+        f.get();
+
+    auto rangesets = std::vector<range::codepoint*>{};
+    rangesets.reserve(jobs.size());
+    for (auto const& j : jobs)
+        rangesets.push_back(make_rangeset(j.result.data(), j.result.data() + j.result.size()));
+
+    for (std::size_t i = 0; i < views.size(); ++i) {
+        if (job_of[i] == std::size_t(-1))
+            continue;
+        views[i].GlyphRanges = rangesets[job_of[i]];
+        views[i].auto_ranges = false;
+    }
+
+    return jobs.size();
+}
+
+#if defined(IMPLUS_USE_FREETYPE)
+
+bool parallel_rasterization = true;
+
+// prerendered_view is a view whose glyphs were rasterized ahead of the atlas
+// build, the glyphs are added as custom rects and blitted after the build,
+// the atlas builder is left with builder_ranges
+struct prerendered_view {
+    std::size_t view = 0;
+    ImWchar const* ranges = nullptr; // the ranges of the view
+    std::vector<ImWchar> builder_ranges;
+    internal::prerendered_font font;
+    std::vector<std::pair<std::size_t, int>> rects; // glyph, custom rect
+};
+
+// the configs of the atlas refer to the builder ranges until the next Setup
+std::vector<prerendered_view> prerendered;
+
+// prerenderable tells whether the glyphs of view i can be rasterized ahead of
+// the build, color and bitmap glyphs are left to the atlas builder
+auto prerenderable(std::size_t i, ImFontAtlas const& atlas) -> bool
+{
+    auto const flags = views[i].FontBuilderFlags | atlas.FontBuilderFlags;
+    return views[i].GlyphRanges &&
+           !(flags & (ImGuiFreeTypeBuilderFlags_LoadColor | ImGuiFreeTypeBuilderFlags_Bitmap));
+}
+
+// distance_fields_supported tells whether Setup can build a distance field
+// atlas for the views in order
+auto distance_fields_supported(std::vector<std::size_t> const& order, ImFontAtlas const& atlas)
+    -> bool
+{
+    if (!distance_field_mode || !internal::distance_field_renderer || order.empty())
+        return false;
+    if (atlas.FontBuilderIO && atlas.FontBuilderIO != ImGuiFreeType::GetBuilderForFreeType())
+        return false;
+    return std::all_of(
+        order.begin(), order.end(), [&](std::size_t i) { return prerenderable(i, atlas); });
+}
+
+// prerender_views rasterizes the glyphs of the views concurrently ahead of the
+// atlas build. Codepoints are claimed the way the atlas builder claims them
+// for merged fonts, by the first view of the font in add order that has a
+// glyph. Fonts with a view that can't be prerendered are left to the builder.
+//
+// Distance fields are always prerendered, on the calling thread alone when
+// parallel rasterization is disabled. The glyph kept for the builder is then
+// prerendered too, its custom rect glyph is added last and replaces it.
+void prerender_views(std::vector<std::size_t> const& order, ImFontAtlas const& atlas,
+    bool distance_fields, SetupTimings& timings)
+{
+    prerendered.clear();
+    if (!parallel_rasterization && !distance_fields)
+        return;
+    if (atlas.FontBuilderIO && atlas.FontBuilderIO != ImGuiFreeType::GetBuilderForFreeType())
+        return;
+
+    auto const supported = [&](std::size_t i) { return prerenderable(i, atlas); };
+
+    // the views of a font follow each other in add order
+    auto configs = std::vector<ImFontConfig const*>{};
+    for (std::size_t k = 0; k < order.size();) {
+        auto end = k + 1;
+        while (end < order.size() && views[order[end]].MergeMode)
+            ++end;
+        if (std::all_of(order.begin() + k, order.begin() + end, supported)) {
+            for (auto j = k; j < end; ++j) {
+                auto& v = views[order[j]];
+                prerendered.push_back(prerendered_view{.view = order[j], .ranges = v.GlyphRanges});
+                configs.push_back(&v);
+            }
+        }
+        k = end;
+    }
+    if (configs.empty())
+        return;
+
+    auto const t_rasterize = clock::now();
+    auto result = internal::prerender_glyphs(configs,
+        internal::prerender_options{.builder_flags = atlas.FontBuilderFlags,
+            .distance_fields = distance_fields,
+            .parallel = parallel_rasterization});
+    timings.Rasterize = seconds_since(t_rasterize);
+    timings.RasterThreads = result.threads;
+
+    auto claimed = std::vector<bool>(std::size_t(IM_UNICODE_CODEPOINT_MAX) + 1);
+    auto font_claims = std::vector<unsigned>{};
+    auto left = std::vector<unsigned>{};
+    for (std::size_t k = 0; k < prerendered.size(); ++k) {
+        auto& p = prerendered[k];
+        p.font = std::move(result.fonts[k]);
+
+        if (!views[p.view].MergeMode) {
+            for (auto cp : font_claims)
+                claimed[cp] = false;
+            font_claims.clear();
+        }
+        auto const claim = [&](unsigned cp) {
+            if (cp > IM_UNICODE_CODEPOINT_MAX || claimed[cp])
+                return false;
+            claimed[cp] = true;
+            font_claims.push_back(cp);
+            return true;
+        };
+
+        // the builder sets the font metrics up only for views with glyphs of
+        // their own, it keeps at least one glyph of each view
+        left.clear();
+        for (auto cp : p.font.deferred)
+            if (claim(cp))
+                left.push_back(cp);
+        for (std::size_t g = 0; g < p.font.glyphs.size(); ++g) {
+            auto const cp = p.font.glyphs[g].codepoint;
+            if (!claim(cp))
+                continue;
+            if (left.empty()) {
+                left.push_back(cp);
+                if (!distance_fields)
+                    continue;
+            }
+            p.rects.emplace_back(g, -1);
+        }
+
+        std::sort(left.begin(), left.end());
+        for (auto cp : left) {
+            if (!p.builder_ranges.empty() && unsigned(p.builder_ranges.back()) + 1 == cp)
+                p.builder_ranges.back() = ImWchar(cp);
+            else
+                p.builder_ranges.insert(p.builder_ranges.end(), {ImWchar(cp), ImWchar(cp)});
+        }
+        p.builder_ranges.push_back(0);
+        views[p.view].GlyphRanges = p.builder_ranges.data();
+    }
+}
+
+// add_prerendered_rects reserves a custom rect for each prerendered glyph once
+// the views are added to the atlas, and gives the views their ranges back
+void add_prerendered_rects(ImFontAtlas& atlas)
+{
+    for (auto& p : prerendered) {
+        auto& v = views[p.view];
+        v.GlyphRanges = p.ranges;
+        for (auto& [g, rect] : p.rects) {
+            auto const& glyph = p.font.glyphs[g];
+            rect = atlas.AddCustomRectFontGlyph(v.font, ImWchar(glyph.codepoint), glyph.width,
+                glyph.height, glyph.advance_x, glyph.offset);
+        }
+    }
+}
+
+// blit_prerendered copies the prerendered glyphs into their packed rects and
+// moves them down by the ascent of their font, as the builder places glyphs
+auto blit_prerendered(ImFontAtlas& atlas) -> std::size_t
+{
+    auto count = std::size_t{0};
+    if (!atlas.TexPixelsAlpha8 && !atlas.TexPixelsRGBA32)
+        return count;
+
+    for (auto const& p : prerendered) {
+        auto const font = views[p.view].font;
+        auto const ascent = IM_ROUND(font->Ascent);
+        for (auto const& [g, rect] : p.rects) {
+            auto const r = rect >= 0 ? atlas.GetCustomRectByIndex(rect) : nullptr;
+            if (!r || !r->IsPacked())
+                continue;
+
+            auto const& glyph = p.font.glyphs[g];
+            auto src = p.font.pixels.data() + glyph.pixels;
+            for (auto y = 0; y < glyph.height; ++y, src += glyph.width) {
+                auto const offset = std::size_t(r->Y + y) * atlas.TexWidth + r->X;
+                if (atlas.TexPixelsAlpha8)
+                    std::copy(src, src + glyph.width, atlas.TexPixelsAlpha8 + offset);
+                if (atlas.TexPixelsRGBA32)
+                    for (auto x = 0; x < glyph.width; ++x)
+                        atlas.TexPixelsRGBA32[offset + x] = IM_COL32(255, 255, 255, src[x]);
+            }
+
+            auto const found = font->FindGlyphNoFallback(ImWchar(glyph.codepoint));
+            if (auto fg = const_cast<ImFontGlyph*>(found)) {
+                fg->Y0 += ascent;
+                fg->Y1 += ascent;
+            }
+            ++count;
+        }
+    }
+    return count;
+}
+
+#endif
+
+void SetParallelRasterization(bool enable)
+{
+#if defined(IMPLUS_USE_FREETYPE)
+    parallel_rasterization = enable;
+#endif
+}
+
+void SetDistanceFieldAtlas(bool enable)
+{
+    if (distance_field_mode == enable)
+        return;
+    distance_field_mode = enable;
+    RequestRebuild();
+}
+
+auto DistanceFieldAtlas() -> bool
+{
+    return distance_field_atlas && ImGui::GetCurrentContext() &&
+           ImGui::GetIO().Fonts == distance_field_atlas;
+}
+
+// rescale_distance_fields scales the fonts of the distance field atlas, baked
+// at distance_field_dpi, to the pixel sizes of the views at dpi
+void rescale_distance_fields(float dpi)
+{
+    for (auto const& v : views)
+        if (!v.MergeMode && v.font && v.SizePixels > 0.0f)
+            v.font->Scale = std::round(v.point_size * dpi / 72.0f) / v.SizePixels;
+}
+
 auto Setup(float dpi, float oversample) -> bool
 {
+    IMPLUS_PROFILE_SCOPE("font.setup");
+
     if (dpi < 1.0f)
         dpi = 1.0f;
     if (oversample < 1.0f)
@@ -225,14 +769,42 @@ auto Setup(float dpi, float oversample) -> bool
     if (lastDpi == dpi && lastOversample == oversample)
         return false;
 
+    auto& io = ImGui::GetIO();
+
+    // the distance fields are drawn at any scale, the atlas is kept
+    if (atlas_rescalable && distance_field_atlas == io.Fonts && io.Fonts->IsBuilt()) {
+        auto const t_start = clock::now();
+        lastDpi = dpi;
+        lastOversample = oversample;
+        rescale_distance_fields(dpi);
+        ++generation;
+        last_timings = SetupTimings{.Total = seconds_since(t_start), .Views = views.size(),
+            .Rescaled = true};
+        return true;
+    }
+
     lastDpi = dpi;
     lastOversample = oversample;
-    auto& io = ImGui::GetIO();
 
-    auto scale_factor = dpi / 72.0f;
+    auto timings = SetupTimings{};
+    auto const t_start = clock::now();
+
+    timings.CoverageScans = resolve_auto_ranges();
+    timings.Coverage = seconds_since(t_start);
+
+    auto const t_configure = clock::now();
     io.Fonts->Clear();
+    ++generation;
+    auto const order = add_order();
+#if defined(IMPLUS_USE_FREETYPE)
+    auto const distance_field = distance_fields_supported(order, *io.Fonts);
+#else
+    auto const distance_field = false;
+#endif
+    auto scale_factor = (distance_field ? distance_field_dpi : dpi) / 72.0f;
     auto first = true;
-    for (auto& v : views) {
+    for (auto i : order) {
+        auto& v = views[i];
         v.OversampleH = v.PixelSnapH ? oversample : 3 * oversample;
         v.OversampleV = oversample;
 
@@ -245,9 +817,54 @@ auto Setup(float dpi, float oversample) -> bool
         if (first)
             v.MergeMode = false;
         first = false;
-        v.font = io.Fonts->AddFont(&v);
     }
 
+    if (distance_field && !(io.Fonts->Flags & ImFontAtlasFlags_NoBakedLines)) {
+        io.Fonts->Flags |= ImFontAtlasFlags_NoBakedLines;
+        lines_unbaked = true;
+    }
+    else if (!distance_field && lines_unbaked) {
+        io.Fonts->Flags &= ~ImFontAtlasFlags_NoBakedLines;
+        lines_unbaked = false;
+    }
+    distance_field_atlas = distance_field ? io.Fonts : nullptr;
+    atlas_rescalable = distance_field;
+
+#if defined(IMPLUS_USE_FREETYPE)
+    prerender_views(order, *io.Fonts, distance_field, timings);
+#endif
+    for (auto i : order)
+        views[i].font = io.Fonts->AddFont(&views[i]);
+#if defined(IMPLUS_USE_FREETYPE)
+    add_prerendered_rects(*io.Fonts);
+#endif
+    if (!views.empty())
+        for (auto&& cb : OnAtlasPrepare)
+            cb(*io.Fonts);
+    timings.Configure = seconds_since(t_configure) - timings.Rasterize;
+
+    // packing and the glyphs that were not prerendered happen within the atlas
+    // builder, building here (rather than lazily in the renderer backend)
+    // makes it measurable
+    auto const t_build = clock::now();
+    if (!views.empty()) {
+        io.Fonts->Build();
+        timings.Build = seconds_since(t_build);
+#if defined(IMPLUS_USE_FREETYPE)
+        auto const t_blit = clock::now();
+        timings.RasterizedGlyphs = blit_prerendered(*io.Fonts);
+        timings.Blit = seconds_since(t_blit);
+#endif
+        if (distance_field)
+            rescale_distance_fields(dpi);
+        for (auto&& cb : OnAtlasBuilt)
+            cb(*io.Fonts);
+    }
+
+    timings.Views = views.size();
+    timings.Total = seconds_since(t_start);
+    last_timings = timings;
+
     return true;
 }
 
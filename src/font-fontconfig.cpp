@@ -3,32 +3,165 @@
 #include <cmath>
 #include <filesystem>
 #include <fontconfig/fontconfig.h>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace ImPlus::Font {
 
-auto GetFileInfo(char const* facename) -> FileInfo
+// fontconfig state is shared across lookups, initializing the config
+// rescans the font configuration which is expensive
+static std::mutex fc_mutex;
+static FcConfig* fc_config = nullptr;
+static auto fc_cache = std::unordered_map<std::string, FileInfo>{};
+
+static auto shared_config() -> FcConfig*
+{
+    if (!fc_config)
+        fc_config = FcInitLoadConfigAndFonts();
+    return fc_config;
+}
+
+static auto file_info_of(FcPattern* font) -> FileInfo
 {
     auto fi = FileInfo{};
+    FcChar8* file = nullptr;
+    if (FcPatternGetString(font, FC_FILE, 0, &file) == FcResultMatch)
+        fi.Filename = reinterpret_cast<char const*>(file);
+    FcPatternGetInteger(font, FC_INDEX, 0, &fi.FaceIndex);
+    return fi;
+}
 
-    auto fontconfig = FcInitLoadConfigAndFonts();
-    auto pattern = FcNameParse((FcChar8*)facename);
-    FcConfigSubstitute(fontconfig, pattern, FcMatchPattern);
+static auto parse_pattern(FcConfig* cfg, char const* facename) -> FcPattern*
+{
+    auto pattern = FcNameParse((FcChar8 const*)facename);
+    if (!pattern)
+        return nullptr;
+    FcConfigSubstitute(cfg, pattern, FcMatchPattern);
     FcDefaultSubstitute(pattern);
+    return pattern;
+}
 
-    auto fc_result = FcResultNoMatch;
-    if (auto res = FcFontMatch(fontconfig, pattern, &fc_result)) {
-        FcChar8* file = nullptr;
+// face_pattern builds a match pattern from the family, weight and slant of
+// the installed face with the given PostScript or full name, FcNameParse
+// would read "Foo-Bold" as the family "Foo" at the size "Bold"
+static auto face_pattern(FcConfig* cfg, char const* name, FcCharSet* cs) -> FcPattern*
+{
+    auto pattern = FcPatternCreate();
+    if (!pattern)
+        return nullptr;
+
+    auto found = false;
+    auto os = FcObjectSetBuild(FC_FAMILY, FC_WEIGHT, FC_SLANT, nullptr);
+    for (auto object : {FC_POSTSCRIPT_NAME, FC_FULLNAME}) {
+        auto query = FcPatternCreate();
+        FcPatternAddString(query, object, (FcChar8 const*)name);
+        if (auto set = FcFontList(cfg, query, os)) {
+            if (set->nfont > 0) {
+                auto font = set->fonts[0];
+                FcChar8* family = nullptr;
+                auto weight = 0;
+                auto slant = 0;
+                if (FcPatternGetString(font, FC_FAMILY, 0, &family) == FcResultMatch) {
+                    FcPatternAddString(pattern, FC_FAMILY, family);
+                    found = true;
+                }
+                if (FcPatternGetInteger(font, FC_WEIGHT, 0, &weight) == FcResultMatch)
+                    FcPatternAddInteger(pattern, FC_WEIGHT, weight);
+                if (FcPatternGetInteger(font, FC_SLANT, 0, &slant) == FcResultMatch)
+                    FcPatternAddInteger(pattern, FC_SLANT, slant);
+            }
+            FcFontSetDestroy(set);
+        }
+        FcPatternDestroy(query);
+        if (found)
+            break;
+    }
+    FcObjectSetDestroy(os);
 
-        if (FcPatternGetString(res, FC_FILE, 0, &file) == FcResultMatch)
-            fi.Filename = reinterpret_cast<char const*>(file);
+    // not an installed face, the name is taken as a family name
+    if (!found)
+        FcPatternAddString(pattern, FC_FAMILY, (FcChar8 const*)name);
+    if (cs)
+        FcPatternAddCharSet(pattern, FC_CHARSET, cs);
+    FcConfigSubstitute(cfg, pattern, FcMatchPattern);
+    FcDefaultSubstitute(pattern);
+    return pattern;
+}
 
-        FcPatternGetInteger(res, FC_INDEX, 0, &fi.FaceIndex);
+auto GetFileInfo(char const* facename) -> FileInfo
+{
+    auto lock = std::lock_guard{fc_mutex};
 
-        FcPatternDestroy(pattern);
-        FcConfigDestroy(fontconfig);
+    auto key = std::string{facename};
+    if (auto it = fc_cache.find(key); it != fc_cache.end())
+        return it->second;
+
+    auto fi = FileInfo{};
+    if (auto cfg = shared_config())
+        if (auto pattern = parse_pattern(cfg, facename)) {
+            auto fc_result = FcResultNoMatch;
+            if (auto res = FcFontMatch(cfg, pattern, &fc_result)) {
+                fi = file_info_of(res);
+                FcPatternDestroy(res);
+            }
+            FcPatternDestroy(pattern);
+        }
+
+    fc_cache.emplace(std::move(key), fi);
+    return fi;
+}
+
+auto GetFallbackFileInfos(char const* facename, std::span<range const> ranges)
+    -> std::vector<FileInfo>
+{
+    auto ret = std::vector<FileInfo>{};
+    if (ranges.empty())
+        return ret;
+
+    auto lock = std::lock_guard{fc_mutex};
+
+    auto cfg = shared_config();
+    if (!cfg)
+        return ret;
+
+    auto remaining = FcCharSetCreate();
+    for (auto const& r : ranges)
+        for (unsigned cp = r.lo; cp <= r.hi; ++cp)
+            FcCharSetAddChar(remaining, cp);
+
+    auto pattern = face_pattern(cfg, facename, remaining);
+    if (!pattern) {
+        FcCharSetDestroy(remaining);
+        return ret;
+    }
+
+    // a single trimmed sort pass, fonts that do not extend the coverage of
+    // the preceding fonts are already dropped by fontconfig
+    auto fc_result = FcResultNoMatch;
+    if (auto set = FcFontSort(cfg, pattern, FcTrue, nullptr, &fc_result)) {
+        for (int i = 0; i < set->nfont && FcCharSetCount(remaining) > 0; ++i) {
+            auto font = set->fonts[i];
+            FcCharSet* cs = nullptr;
+            if (FcPatternGetCharSet(font, FC_CHARSET, 0, &cs) != FcResultMatch || !cs)
+                continue;
+            if (FcCharSetIntersectCount(remaining, cs) == 0)
+                continue;
+            auto fi = file_info_of(font);
+            if (fi.Filename.empty())
+                continue;
+            auto rest = FcCharSetSubtract(remaining, cs);
+            FcCharSetDestroy(remaining);
+            remaining = rest;
+            ret.push_back(std::move(fi));
+        }
+        FcFontSetDestroy(set);
     }
+
     FcPatternDestroy(pattern);
-    return fi;
+    FcCharSetDestroy(remaining);
+    return ret;
 }
 
 auto LoadDefault() -> Resource
@@ -1,4 +1,5 @@
 #include <implus/host.hpp>
+#include <implus/input-replay.hpp>
 #include <implus/render-device.hpp>
 
 #include "host-render.hpp"
@@ -237,24 +238,31 @@ void Window::NewFrame(bool poll_events)
         glfwPollEvents();
     Render::NewFrame(*this);
     ImGui_ImplGlfw_NewFrame();
+    IMPLUS_REPLAY_NEW_FRAME(*this);
     ImGui::NewFrame();
 }
 
 void Window::RenderFrame(bool swap_buffers)
 {
     ImGui::Render();
-    Render::PrepareViewport(*this);
 
-    if (OnBeforeDraw)
-        OnBeforeDraw();
+    if (begin_present(swap_buffers)) {
+        Render::PrepareViewport(*this);
 
-    Render::RenderDrawData();
+        if (OnBeforeDraw)
+            OnBeforeDraw();
 
-    if (OnAfterDraw)
-        OnAfterDraw();
+        Render::RenderDrawData();
 
-    if (swap_buffers)
-        Render::SwapBuffers(*this);
+        if (OnAfterDraw)
+            OnAfterDraw();
+
+        if (swap_buffers)
+            Render::SwapBuffers(*this);
+    }
+    else {
+        pace_skipped_frame();
+    }
 
     if (pending_locate_) {
         perform_locate(*pending_locate_, pending_constrain_);
@@ -520,6 +528,16 @@ auto PrimaryMonitorWorkArea() -> Window::Bounds
 
 void InvalidateDeviceObjects() { Render::InvalidateDeviceObjects(); }
 
+void WaitEvents(double timeout)
+{
+    if (timeout < 0.0)
+        glfwWaitEvents();
+    else if (timeout > 0.0)
+        glfwWaitEventsTimeout(timeout);
+}
+
+void PostEmptyEvent() { glfwPostEmptyEvent(); }
+
 auto SetFeature(Feature f, std::string const& value) -> bool { return false; }
 auto GetFeature(Feature f) -> std::string { return ""; }
 auto IsFeatureSupported(Feature f) -> bool { return false; }
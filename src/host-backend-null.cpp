@@ -0,0 +1,265 @@
+#include <implus/host.hpp>
+#include <implus/input-replay.hpp>
+#include <implus/render-device.hpp>
+
+#include "host-render.hpp"
+#include <imgui_internal.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+// Offscreen host: windows are plain state, there is no event source and the
+// frames are rendered by the NULL or SOFTWARE renderer. Input is fed to ImGui
+// directly (io.AddMousePosEvent() and friends).
+
+namespace ImPlus::Host {
+
+extern Window* main_window_;
+extern std::size_t window_counter_;
+
+// a virtual monitor for default sizes, maximized and fullscreen windows
+static auto const work_area = Window::Bounds{{0, 0}, {1920, 1080}};
+
+struct offscreen {
+    Window::Bounds bounds;
+    bool visible = false;
+    bool maximized = false;
+};
+
+inline auto native_wnd(void* h) -> offscreen* { return static_cast<offscreen*>(h); }
+
+using clock = std::chrono::steady_clock;
+
+static auto time_step = std::optional<double>{};
+static auto last_frame = clock::time_point{};
+
+static auto wake_mutex = std::mutex{};
+static auto wake_cv = std::condition_variable{};
+static auto wake_posted = false;
+
+void notifyMove(Window& w, Window::Pos const& xy)
+{
+    if (!w.suspendNotifications)
+        w.handleMove(xy);
+}
+void notifyResize(Window& w, Window::Size const& wh)
+{
+    if (!w.suspendNotifications)
+        w.handleResize(wh);
+}
+
+Window::Window(InitLocation const& loc, char const* title, Attrib attr)
+    : regular_attr_{attr}
+{
+    ++window_counter_;
+
+    auto b = PrimaryMonitorWorkArea();
+    b.inflate(-b.size.w / 10, -b.size.h / 10);
+    if (auto sz = std::get_if<Size>(&loc)) {
+        if (sz->w > 0)
+            b.size.w = sz->w;
+        if (sz->h > 0)
+            b.size.h = sz->h;
+    }
+    else if (auto bb = std::get_if<Bounds>(&loc)) {
+        b = *bb;
+    }
+
+    handle_ = new offscreen{.bounds = b};
+    regular_bounds = b;
+
+    if (window_counter_ == 1) {
+        Render::SetupInstance(*this);
+        if (Render::OnDeviceChange)
+            Render::OnDeviceChange(Render::GetDeviceInfo());
+    }
+
+    Render::SetupWindow(*this);
+
+    context_ = ImGui::CreateContext();
+
+    if (window_counter_ == 1) {
+        IMGUI_CHECKVERSION();
+        ImGui::StyleColorsDark();
+
+        main_window_ = this;
+        ImGui::GetIO().BackendPlatformName = "implus_host_null";
+        Render::SetupImplementation(*this);
+    }
+}
+
+Window::~Window()
+{
+    --window_counter_;
+
+    if (this == main_window_)
+        main_window_ = nullptr;
+
+    if (window_counter_ == 0) {
+        if (Render::OnDeviceChange)
+            Render::OnDeviceChange({});
+        Render::ShutdownImplementation();
+    }
+    if (context_)
+        ImGui::DestroyContext(context_);
+    if (window_counter_ == 0)
+        Render::ShutdownInstance();
+    delete native_wnd(handle_);
+}
+
+void Window::Show(bool do_show) { native_wnd(handle_)->visible = do_show; }
+
+void Window::BringToFront() { native_wnd(handle_)->visible = true; }
+
+auto Window::ContentScale() const -> Scale { return {.dpi = 96.0f, .fb_scale = 1.0f}; }
+
+auto Window::ShouldClose() const -> bool { return should_close_; }
+
+void Window::SetShouldClose(bool close) { should_close_ = close; }
+
+void Window::NewFrame(bool poll_events)
+{
+    ImGui::SetCurrentContext(context_);
+
+    auto& io = ImGui::GetIO();
+    auto const& b = native_wnd(handle_)->bounds;
+    io.DisplaySize = ImVec2{float(b.size.w), float(b.size.h)};
+    io.DisplayFramebufferScale = ImVec2{1.0f, 1.0f};
+
+    auto const now = clock::now();
+    if (time_step)
+        io.DeltaTime = float(*time_step);
+    else if (last_frame == clock::time_point{})
+        io.DeltaTime = 1.0f / 60.0f;
+    else
+        io.DeltaTime = std::max(std::chrono::duration<float>(now - last_frame).count(), 1.0e-6f);
+    last_frame = now;
+
+    if (poll_events) {
+        // the only events are wake-ups from PostEmptyEvent
+        auto lock = std::lock_guard{wake_mutex};
+        wake_posted = false;
+    }
+
+    Render::NewFrame(*this);
+    IMPLUS_REPLAY_NEW_FRAME(*this);
+    ImGui::NewFrame();
+}
+
+void Window::RenderFrame(bool swap_buffers)
+{
+    ImGui::Render();
+
+    // no display to pace against, skipped frames return at once
+    if (begin_present(swap_buffers)) {
+        Render::PrepareViewport(*this);
+
+        if (OnBeforeDraw)
+            OnBeforeDraw();
+
+        Render::RenderDrawData();
+
+        if (OnAfterDraw)
+            OnAfterDraw();
+
+        if (swap_buffers)
+            Render::SwapBuffers(*this);
+    }
+
+    if (pending_locate_) {
+        perform_locate(*pending_locate_, pending_constrain_);
+        pending_locate_.reset();
+    }
+}
+
+auto Window::FramebufferSize() const -> Size { return native_wnd(handle_)->bounds.size; }
+
+auto Window::Locate() const -> Location
+{
+    auto const maximized = native_wnd(handle_)->maximized;
+    return {regular_bounds.pos, regular_bounds.size, maximized, fullscreen};
+}
+
+auto Window::IsMinimized() const -> bool { return false; }
+
+void Window::perform_locate(Location const& loc, bool constrain_to_monitor)
+{
+    auto& s = *native_wnd(handle_);
+
+    if (loc.Pos)
+        regular_bounds.pos = *loc.Pos;
+    if (loc.Size)
+        regular_bounds.size = *loc.Size;
+
+    if (constrain_to_monitor)
+        regular_bounds = ConstrainToMonitor(regular_bounds);
+
+    fullscreen = loc.FullScreen.value_or(fullscreen);
+    s.maximized = loc.Maximized.value_or(s.maximized);
+
+    auto const b = fullscreen || s.maximized ? work_area : regular_bounds;
+    auto const resized = b.size.w != s.bounds.size.w || b.size.h != s.bounds.size.h;
+    s.bounds = b;
+
+    if (resized && OnFramebufferSize)
+        OnFramebufferSize(b.size);
+}
+
+void Window::Cleanup() {}
+
+void Window::SetTitle(char const* s) {}
+
+void Window::handleMove(Pos const& xy)
+{
+    if (!fullscreen && !native_wnd(handle_)->maximized)
+        regular_bounds.pos = xy;
+}
+
+void Window::handleResize(Size const& wh)
+{
+    if (!fullscreen && !native_wnd(handle_)->maximized)
+        regular_bounds.size = wh;
+}
+
+void Window::EnableDropFiles(bool allow) {}
+
+// offscreen windows are not bound to a monitor
+auto ConstrainToMonitor(Window::Bounds const& b) -> Window::Bounds { return b; }
+
+auto PrimaryMonitorWorkArea() -> Window::Bounds { return work_area; }
+
+void InvalidateDeviceObjects() { Render::InvalidateDeviceObjects(); }
+
+void SetFrameTimeStep(std::optional<double> seconds) { time_step = seconds; }
+
+void WaitEvents(double timeout)
+{
+    // with a fixed time step the clock is virtual, waiting would only slow
+    // down the replay
+    if (time_step)
+        return;
+
+    auto lock = std::unique_lock{wake_mutex};
+    auto const posted = [] { return wake_posted; };
+    if (timeout < 0.0)
+        wake_cv.wait(lock, posted);
+    else if (timeout > 0.0)
+        wake_cv.wait_for(lock, std::chrono::duration<double>(std::min(timeout, 1.0e6)), posted);
+}
+
+void PostEmptyEvent()
+{
+    {
+        auto lock = std::lock_guard{wake_mutex};
+        wake_posted = true;
+    }
+    wake_cv.notify_one();
+}
+
+auto SetFeature(Feature f, std::string const& value) -> bool { return false; }
+auto GetFeature(Feature f) -> std::string { return ""; }
+auto IsFeatureSupported(Feature f) -> bool { return false; }
+
+} // namespace ImPlus::Host
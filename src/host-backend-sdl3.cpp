@@ -1,4 +1,5 @@
 #include <implus/host.hpp>
+#include <implus/input-replay.hpp>
 #include <implus/render-device.hpp>
 
 #include <imgui_internal.h>
@@ -15,6 +16,7 @@
 #include <backends/imgui_impl_sdl3.h>
 
 #include <algorithm>
+#include <cmath>
 #include <cstdio>
 
 namespace ImPlus::Host {
@@ -289,24 +291,31 @@ void Window::NewFrame(bool poll_events)
 
     Render::NewFrame(*this);
     ImGui_ImplSDL3_NewFrame();
+    IMPLUS_REPLAY_NEW_FRAME(*this);
     ImGui::NewFrame();
 }
 
 void Window::RenderFrame(bool swap_buffers)
 {
     ImGui::Render();
-    Render::PrepareViewport(*this);
 
-    if (OnBeforeDraw)
-        OnBeforeDraw();
+    if (begin_present(swap_buffers)) {
+        Render::PrepareViewport(*this);
 
-    Render::RenderDrawData();
+        if (OnBeforeDraw)
+            OnBeforeDraw();
 
-    if (OnAfterDraw)
-        OnAfterDraw();
+        Render::RenderDrawData();
 
-    if (swap_buffers)
-        Render::SwapBuffers(*this);
+        if (OnAfterDraw)
+            OnAfterDraw();
+
+        if (swap_buffers)
+            Render::SwapBuffers(*this);
+    }
+    else {
+        pace_skipped_frame();
+    }
 
     if (pending_locate_) {
         perform_locate(*pending_locate_, pending_constrain_);
@@ -544,6 +553,26 @@ auto PrimaryMonitorWorkArea() -> Window::Bounds
 
 void InvalidateDeviceObjects() { Render::InvalidateDeviceObjects(); }
 
+void WaitEvents(double timeout)
+{
+    // leave the event in the queue for the next NewFrame
+    if (timeout < 0.0)
+        SDL_WaitEvent(nullptr);
+    else if (timeout > 0.0)
+        SDL_WaitEventTimeout(nullptr, int(std::ceil(std::min(timeout, 1.0e6) * 1000.0)));
+}
+
+void PostEmptyEvent()
+{
+    static auto const type = [] {
+        auto const t = SDL_RegisterEvents(1);
+        return t != 0 ? t : Uint32(SDL_EVENT_USER);
+    }();
+    auto event = SDL_Event{};
+    event.type = type;
+    SDL_PushEvent(&event);
+}
+
 auto SetFeature(Feature f, std::string const& value) -> bool
 {
     switch (f) {
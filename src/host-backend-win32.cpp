@@ -1,5 +1,6 @@
 #include "host-render.hpp"
 #include <implus/host.hpp>
+#include <implus/input-replay.hpp>
 #include <implus/render-device.hpp>
 
 #include <imgui_internal.h>
@@ -26,6 +27,8 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <cstddef>
 #include <string>
 #include <string_view>
@@ -476,23 +479,30 @@ void Window::NewFrame(bool poll_events)
 
     Render::NewFrame(*this);
     ImGui_ImplWin32_NewFrame();
+    IMPLUS_REPLAY_NEW_FRAME(*this);
     ImGui::NewFrame();
 }
 
 void Window::RenderFrame(bool swap_buffers)
 {
     ImGui::Render();
-    Render::PrepareViewport(*this);
 
-    if (OnBeforeDraw)
-        OnBeforeDraw();
+    if (begin_present(true)) {
+        Render::PrepareViewport(*this);
 
-    Render::RenderDrawData();
+        if (OnBeforeDraw)
+            OnBeforeDraw();
 
-    if (OnAfterDraw)
-        OnAfterDraw();
+        Render::RenderDrawData();
 
-    Render::SwapBuffers(*this);
+        if (OnAfterDraw)
+            OnAfterDraw();
+
+        Render::SwapBuffers(*this);
+    }
+    else {
+        pace_skipped_frame();
+    }
 
     if (pending_locate_) {
         perform_locate(*pending_locate_, pending_constrain_);
@@ -743,7 +753,29 @@ auto PrimaryMonitorWorkArea() -> Window::Bounds
     return {{0, 0}, {640, 480}};
 }
 
-void InvalidateDeviceObjects() { ImGui_ImplDX11_InvalidateDeviceObjects(); }
+void InvalidateDeviceObjects()
+{
+    ImGui_ImplDX11_InvalidateDeviceObjects();
+    ++Render::ResourceGeneration;
+}
+
+// thread waiting for messages, woken by PostEmptyEvent
+static std::atomic<DWORD> waiting_thread_id = 0;
+
+void WaitEvents(double timeout)
+{
+    waiting_thread_id = ::GetCurrentThreadId();
+    if (timeout == 0.0)
+        return;
+    auto const ms = timeout < 0.0 ? INFINITE : DWORD(std::ceil(std::min(timeout, 1.0e6) * 1000.0));
+    ::MsgWaitForMultipleObjectsEx(0, nullptr, ms, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+}
+
+void PostEmptyEvent()
+{
+    if (auto const id = waiting_thread_id.load())
+        ::PostThreadMessageW(id, WM_NULL, 0, 0);
+}
 
 auto SetFeature(Feature f, std::string const& value) -> bool
 {
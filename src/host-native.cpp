@@ -36,6 +36,9 @@
 // SDL3
 #include <SDL3/SDL.h>
 
+#elif defined(IMPLUS_HOST_NULL)
+// offscreen, no native handles
+
 #else
 #error Unsupported Windowing Backend
 
@@ -47,6 +50,9 @@ auto ImPlus::Host::GetBackendNativeHandle(ImPlus::Host::Window const& wnd) -> Na
     // HWND
     return {wnd.Handle(), NativeHandleType::WIN32_HWND};
 
+#elif defined(IMPLUS_HOST_NULL)
+    return {};
+
 #elif defined(IMPLUS_HOST_SDL2)
     auto sw = static_cast<SDL_Window*>(wnd.Handle());
     SDL_SysWMinfo w;
@@ -1,8 +1,12 @@
 #include "host-render.hpp"
+#include "internal/texture-pool.hpp"
 
 #include <backends/imgui_impl_dx11.h>
+#include <implus/profiler.hpp>
 #include <implus/render-device.hpp>
 #include <stdexcept>
+#include <unordered_set>
+#include <vector>
 
 namespace ImPlus::Render {
 
@@ -11,6 +15,7 @@ static ID3D11DeviceContext* g_pd3dDeviceContext = nullptr;
 static IDXGISwapChain* g_pSwapChain = nullptr;
 static ImPlus::Host::Window::Size g_FramebufferSize = {0, 0};
 static ID3D11RenderTargetView* g_mainRenderTargetView = nullptr;
+static std::unordered_set<ID3D11ShaderResourceView*> g_Textures;
 
 auto GetDeviceInfo() -> Render::DeviceInfo
 {
@@ -106,7 +111,93 @@ void SetupImplementation(ImPlus::Host::Window&)
     ImGui_ImplDX11_Init(g_pd3dDevice, g_pd3dDeviceContext);
 }
 
-void ShutdownImplementation() { ImGui_ImplDX11_Shutdown(); }
+void ShutdownImplementation()
+{
+    internal::release_device_textures();
+    for (auto view : g_Textures)
+        view->Release();
+    g_Textures.clear();
+    ImGui_ImplDX11_Shutdown();
+}
+
+auto CreateTexture(int width, int height, void const* pixels, int stride) -> ImTextureID
+{
+    if (!g_pd3dDevice || width <= 0 || height <= 0)
+        return {};
+
+    auto zeros = std::vector<unsigned char>{};
+    if (!pixels) {
+        zeros.assign(std::size_t(width) * height * 4, 0);
+        pixels = zeros.data();
+        stride = 0;
+    }
+
+    D3D11_TEXTURE2D_DESC desc;
+    ZeroMemory(&desc, sizeof(desc));
+    desc.Width = width;
+    desc.Height = height;
+    desc.MipLevels = 1;
+    desc.ArraySize = 1;
+    desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+    desc.SampleDesc.Count = 1;
+    desc.Usage = D3D11_USAGE_DEFAULT;
+    desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+    D3D11_SUBRESOURCE_DATA data;
+    ZeroMemory(&data, sizeof(data));
+    data.pSysMem = pixels;
+    data.SysMemPitch = stride ? UINT(stride) : UINT(width) * 4;
+
+    ID3D11Texture2D* texture = nullptr;
+    if (g_pd3dDevice->CreateTexture2D(&desc, &data, &texture) != S_OK)
+        return {}; // out of memory or a lost device
+
+    D3D11_SHADER_RESOURCE_VIEW_DESC srv;
+    ZeroMemory(&srv, sizeof(srv));
+    srv.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+    srv.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+    srv.Texture2D.MipLevels = 1;
+
+    ID3D11ShaderResourceView* view = nullptr;
+    auto const hr = g_pd3dDevice->CreateShaderResourceView(texture, &srv, &view);
+    texture->Release();
+    if (hr != S_OK)
+        return {};
+
+    g_Textures.insert(view);
+    ++ResourceGeneration;
+    return (ImTextureID)(intptr_t)view;
+}
+
+void UpdateTexture(
+    ImTextureID id, int x, int y, int width, int height, void const* pixels, int stride)
+{
+    auto view = (ID3D11ShaderResourceView*)(intptr_t)id;
+    if (!g_Textures.contains(view) || width <= 0 || height <= 0)
+        return;
+
+    auto zeros = std::vector<unsigned char>{};
+    if (!pixels) {
+        zeros.assign(std::size_t(width) * height * 4, 0);
+        pixels = zeros.data();
+        stride = 0;
+    }
+
+    ID3D11Resource* res = nullptr;
+    view->GetResource(&res);
+    auto const box = D3D11_BOX{UINT(x), UINT(y), 0, UINT(x + width), UINT(y + height), 1};
+    g_pd3dDeviceContext->UpdateSubresource(
+        res, 0, &box, pixels, stride ? UINT(stride) : UINT(width) * 4, 0);
+    res->Release();
+    ++ResourceGeneration;
+}
+
+void DestroyTexture(ImTextureID id)
+{
+    auto view = (ID3D11ShaderResourceView*)(intptr_t)id;
+    if (g_Textures.erase(view))
+        view->Release();
+}
 
 void NewFrame(ImPlus::Host::Window& wnd)
 {
@@ -118,6 +209,7 @@ void NewFrame(ImPlus::Host::Window& wnd)
         // g_pSwapChain->ResizeBuffers(
         //     0, (UINT)LOWORD(sz.w), (UINT)HIWORD(sz.h), DXGI_FORMAT_UNKNOWN, 0);
         createRenderTarget();
+        ++ResourceGeneration;
     }
 
     ImGui_ImplDX11_NewFrame();
@@ -130,10 +222,15 @@ void PrepareViewport(ImPlus::Host::Window& wnd)
     g_pd3dDeviceContext->ClearRenderTargetView(g_mainRenderTargetView, (float*)&clr);
 }
 
-void RenderDrawData() { ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData()); }
+void RenderDrawData()
+{
+    IMPLUS_PROFILE_SCOPE("render.draw");
+    ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
+}
 
 void SwapBuffers(ImPlus::Host::Window&)
 {
+    IMPLUS_PROFILE_SCOPE("render.swap");
     assert(g_pSwapChain);
     g_pSwapChain->Present(1, 0); // Present with vsync
 }
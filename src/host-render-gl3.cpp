@@ -1,5 +1,14 @@
 #include "host-render.hpp"
+#include "internal/distance-field.hpp"
+#include "internal/texture-pool.hpp"
+#include <implus/font.hpp>
+#include <implus/profiler.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
 #include <stdexcept>
+#include <unordered_set>
+#include <vector>
 
 #ifdef IMPLUS_GL_LOADER_GLAD
 #include <glad/glad.h>
@@ -48,6 +57,9 @@ static auto glad_inited = false;
 static SDL_GLContext gl_context_ = nullptr;
 #endif
 
+static std::unordered_set<GLuint> textures_;
+static auto textures_ready_ = false; // between SetupImplementation and ShutdownImplementation
+
 auto GetDeviceInfo() -> Render::DeviceInfo
 {
     // OpenGL device info is a stub
@@ -163,10 +175,489 @@ void SetupWindow(ImPlus::Host::Window& wnd)
 #endif
 }
 
+#if defined(IMPLUS_GL3_STREAMING)
+
+// streaming render path
+//
+// The vertices and indices of all draw lists of a frame are copied into one
+// buffer through a single mapping, one upload per frame. With GL 4.4 or
+// ARB_buffer_storage the buffer is persistently mapped and split into regions
+// guarded by fences, otherwise its storage is orphaned and mapped each frame.
+// The render state is set once per frame, texture binds and scissor rects are
+// issued only when they change between draw commands, and the state of the
+// application is restored afterwards. Without GL 3.3 frames are rendered by
+// imgui_impl_opengl3.
+//
+// The commands that sample a distance field font atlas are drawn with a second
+// program, which turns the distances into coverage (see
+// Font::SetDistanceFieldAtlas).
+
+#ifndef GL_MAP_PERSISTENT_BIT
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#endif
+#ifndef GL_MAP_COHERENT_BIT
+#define GL_MAP_COHERENT_BIT 0x0080
+#endif
+
+typedef void(APIENTRYP buffer_storage_proc)(
+    GLenum target, GLsizeiptr size, void const* data, GLbitfield flags);
+
+static constexpr auto stream_regions = 3;
+static constexpr auto stream_min_size = GLsizeiptr{256 * 1024};
+
+struct stream_state {
+    bool ready = false;
+    GLuint program = 0;
+    GLint proj_loc = -1;
+    GLuint sdf_program = 0; // draws the distance field atlas
+    GLint sdf_proj_loc = -1;
+    GLuint vao = 0;
+    GLuint buffer = 0;
+    buffer_storage_proc buffer_storage = nullptr;
+    bool persistent = false;
+    GLsizeiptr region_size = 0;      // bytes of one region, the buffer if orphaned
+    unsigned char* mapped = nullptr; // persistent mapping of all regions
+    int region = 0;
+    GLsync fences[stream_regions] = {};
+};
+
+static auto stream_ = stream_state{};
+
+static char const* stream_vs = R"(#version 330 core
+layout (location = 0) in vec2 Position;
+layout (location = 1) in vec2 UV;
+layout (location = 2) in vec4 Color;
+uniform mat4 ProjMtx;
+out vec2 Frag_UV;
+out vec4 Frag_Color;
+void main()
+{
+    Frag_UV = UV;
+    Frag_Color = Color;
+    gl_Position = ProjMtx * vec4(Position.xy, 0, 1);
+}
+)";
+
+static char const* stream_fs = R"(#version 330 core
+in vec2 Frag_UV;
+in vec4 Frag_Color;
+uniform sampler2D Texture;
+layout (location = 0) out vec4 Out_Color;
+void main()
+{
+    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);
+}
+)";
+
+// the distance is 0.5 on the outline, coverage ramps over one pixel across it
+static char const* stream_fs_sdf = R"(#version 330 core
+in vec2 Frag_UV;
+in vec4 Frag_Color;
+uniform sampler2D Texture;
+layout (location = 0) out vec4 Out_Color;
+void main()
+{
+    float d = texture(Texture, Frag_UV.st).a;
+    float coverage = clamp((d - 0.5) / max(fwidth(d), 1e-5) + 0.5, 0.0, 1.0);
+    Out_Color = vec4(Frag_Color.rgb, Frag_Color.a * coverage);
+}
+)";
+
+static auto gl_proc(char const* name) -> void*
+{
+#if defined(IMPLUS_HOST_GLFW)
+    return (void*)glfwGetProcAddress(name);
+#else
+    return (void*)SDL_GL_GetProcAddress(name);
+#endif
+}
+
+static auto has_extension(char const* name) -> bool
+{
+    auto count = GLint{0};
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (auto i = 0; i < count; ++i) {
+        auto ext = reinterpret_cast<char const*>(glGetStringi(GL_EXTENSIONS, GLuint(i)));
+        if (ext && std::strcmp(ext, name) == 0)
+            return true;
+    }
+    return false;
+}
+
+static auto compile_shader(GLenum type, char const* src) -> GLuint
+{
+    auto shader = glCreateShader(type);
+    glShaderSource(shader, 1, &src, nullptr);
+    glCompileShader(shader);
+    auto ok = GLint{0};
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &ok);
+    if (!ok) {
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+// link_program returns 0 if the shaders fail to compile or link
+static auto link_program(char const* vs_src, char const* fs_src, GLint& proj_loc) -> GLuint
+{
+    auto program = GLuint{0};
+    auto vs = compile_shader(GL_VERTEX_SHADER, vs_src);
+    auto fs = compile_shader(GL_FRAGMENT_SHADER, fs_src);
+    if (vs && fs) {
+        program = glCreateProgram();
+        glAttachShader(program, vs);
+        glAttachShader(program, fs);
+        glLinkProgram(program);
+        glDetachShader(program, vs);
+        glDetachShader(program, fs);
+    }
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+
+    auto linked = GLint{0};
+    if (program)
+        glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        glDeleteProgram(program);
+        return 0;
+    }
+
+    proj_loc = glGetUniformLocation(program, "ProjMtx");
+    glUseProgram(program);
+    glUniform1i(glGetUniformLocation(program, "Texture"), 0);
+    glUseProgram(0);
+    return program;
+}
+
+static void stream_setup()
+{
+    auto& s = stream_;
+    if (GLVersion.major * 10 + GLVersion.minor < 33)
+        return;
+
+    s.program = link_program(stream_vs, stream_fs, s.proj_loc);
+    if (!s.program)
+        return;
+    s.sdf_program = link_program(stream_vs, stream_fs_sdf, s.sdf_proj_loc);
+
+    glGenVertexArrays(1, &s.vao);
+    if (GLVersion.major * 10 + GLVersion.minor >= 44 || has_extension("GL_ARB_buffer_storage"))
+        s.buffer_storage = (buffer_storage_proc)gl_proc("glBufferStorage");
+    s.ready = true;
+}
+
+static void stream_release_buffer()
+{
+    auto& s = stream_;
+    for (auto& f : s.fences) {
+        if (f)
+            glDeleteSync(f);
+        f = nullptr;
+    }
+    if (s.mapped) {
+        glBindBuffer(GL_ARRAY_BUFFER, s.buffer);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+        s.mapped = nullptr;
+    }
+    if (s.buffer)
+        glDeleteBuffers(1, &s.buffer);
+    s.buffer = 0;
+    s.persistent = false;
+}
+
+static void stream_shutdown()
+{
+    auto& s = stream_;
+    stream_release_buffer();
+    if (s.vao)
+        glDeleteVertexArrays(1, &s.vao);
+    if (s.program)
+        glDeleteProgram(s.program);
+    if (s.sdf_program)
+        glDeleteProgram(s.sdf_program);
+    s = stream_state{};
+}
+
+// stream_reserve makes room for size bytes per frame, the buffer grows by
+// doubling and is never shrunk
+static void stream_reserve(GLsizeiptr size)
+{
+    auto& s = stream_;
+    if (s.buffer && size <= s.region_size)
+        return;
+
+    auto region = std::max(s.region_size, stream_min_size);
+    while (region < size)
+        region *= 2;
+
+    stream_release_buffer();
+    glGenBuffers(1, &s.buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, s.buffer);
+    if (s.buffer_storage) {
+        auto const flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        s.buffer_storage(GL_ARRAY_BUFFER, region * stream_regions, nullptr, flags);
+        s.mapped = static_cast<unsigned char*>(
+            glMapBufferRange(GL_ARRAY_BUFFER, 0, region * stream_regions, flags));
+        s.persistent = s.mapped != nullptr;
+        if (!s.persistent) {
+            // immutable storage can't be orphaned, orphan a new buffer
+            s.buffer_storage = nullptr;
+            glDeleteBuffers(1, &s.buffer);
+            glGenBuffers(1, &s.buffer);
+            glBindBuffer(GL_ARRAY_BUFFER, s.buffer);
+        }
+    }
+    if (!s.persistent)
+        glBufferData(GL_ARRAY_BUFFER, region, nullptr, GL_STREAM_DRAW);
+    s.region_size = region;
+}
+
+static void stream_setup_state(ImDrawData const& dd, int fb_w, int fb_h, GLintptr base)
+{
+    auto const& s = stream_;
+    glEnable(GL_BLEND);
+    glBlendEquation(GL_FUNC_ADD);
+    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    glDisable(GL_CULL_FACE);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_STENCIL_TEST);
+    glDisable(GL_PRIMITIVE_RESTART);
+    glEnable(GL_SCISSOR_TEST);
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+    glViewport(0, 0, fb_w, fb_h);
+
+    auto const l = dd.DisplayPos.x;
+    auto const r = dd.DisplayPos.x + dd.DisplaySize.x;
+    auto const t = dd.DisplayPos.y;
+    auto const b = dd.DisplayPos.y + dd.DisplaySize.y;
+    float const proj[4][4] = {
+        {2.0f / (r - l), 0.0f, 0.0f, 0.0f},
+        {0.0f, 2.0f / (t - b), 0.0f, 0.0f},
+        {0.0f, 0.0f, -1.0f, 0.0f},
+        {(r + l) / (l - r), (t + b) / (b - t), 0.0f, 1.0f},
+    };
+    if (s.sdf_program) {
+        glUseProgram(s.sdf_program);
+        glUniformMatrix4fv(s.sdf_proj_loc, 1, GL_FALSE, &proj[0][0]);
+    }
+    glUseProgram(s.program);
+    glUniformMatrix4fv(s.proj_loc, 1, GL_FALSE, &proj[0][0]);
+    glActiveTexture(GL_TEXTURE0);
+
+    glBindVertexArray(s.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, s.buffer);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, s.buffer);
+    glEnableVertexAttribArray(0);
+    glEnableVertexAttribArray(1);
+    glEnableVertexAttribArray(2);
+    auto const stride = GLsizei(sizeof(ImDrawVert));
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, stride,
+        reinterpret_cast<void*>(base + GLintptr(offsetof(ImDrawVert, pos))));
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, stride,
+        reinterpret_cast<void*>(base + GLintptr(offsetof(ImDrawVert, uv))));
+    glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride,
+        reinterpret_cast<void*>(base + GLintptr(offsetof(ImDrawVert, col))));
+}
+
+// GL state changed by stream_setup_state, saved before and restored after the
+// frame like imgui_impl_opengl3 does
+struct stream_saved_state {
+    GLint program, texture, active_texture, vao, array_buffer;
+    GLint blend_src_rgb, blend_dst_rgb, blend_src_alpha, blend_dst_alpha;
+    GLint blend_eq_rgb, blend_eq_alpha;
+    GLint polygon_mode[2], viewport[4], scissor_box[4];
+    GLboolean blend, cull_face, depth_test, stencil_test, scissor_test, primitive_restart;
+
+    void save()
+    {
+        glGetIntegerv(GL_ACTIVE_TEXTURE, &active_texture);
+        glActiveTexture(GL_TEXTURE0);
+        glGetIntegerv(GL_CURRENT_PROGRAM, &program);
+        glGetIntegerv(GL_TEXTURE_BINDING_2D, &texture);
+        glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &vao);
+        glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &array_buffer);
+        glGetIntegerv(GL_BLEND_SRC_RGB, &blend_src_rgb);
+        glGetIntegerv(GL_BLEND_DST_RGB, &blend_dst_rgb);
+        glGetIntegerv(GL_BLEND_SRC_ALPHA, &blend_src_alpha);
+        glGetIntegerv(GL_BLEND_DST_ALPHA, &blend_dst_alpha);
+        glGetIntegerv(GL_BLEND_EQUATION_RGB, &blend_eq_rgb);
+        glGetIntegerv(GL_BLEND_EQUATION_ALPHA, &blend_eq_alpha);
+        glGetIntegerv(GL_POLYGON_MODE, polygon_mode);
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        glGetIntegerv(GL_SCISSOR_BOX, scissor_box);
+        blend = glIsEnabled(GL_BLEND);
+        cull_face = glIsEnabled(GL_CULL_FACE);
+        depth_test = glIsEnabled(GL_DEPTH_TEST);
+        stencil_test = glIsEnabled(GL_STENCIL_TEST);
+        scissor_test = glIsEnabled(GL_SCISSOR_TEST);
+        primitive_restart = glIsEnabled(GL_PRIMITIVE_RESTART);
+    }
+
+    void restore() const
+    {
+        auto const enable = [](GLenum cap, GLboolean on) {
+            if (on)
+                glEnable(cap);
+            else
+                glDisable(cap);
+        };
+        glUseProgram(GLuint(program));
+        glBindTexture(GL_TEXTURE_2D, GLuint(texture));
+        glActiveTexture(GLenum(active_texture));
+        // the element buffer binding belongs to the vertex array
+        glBindVertexArray(GLuint(vao));
+        glBindBuffer(GL_ARRAY_BUFFER, GLuint(array_buffer));
+        glBlendEquationSeparate(GLenum(blend_eq_rgb), GLenum(blend_eq_alpha));
+        glBlendFuncSeparate(GLenum(blend_src_rgb), GLenum(blend_dst_rgb),
+            GLenum(blend_src_alpha), GLenum(blend_dst_alpha));
+        enable(GL_BLEND, blend);
+        enable(GL_CULL_FACE, cull_face);
+        enable(GL_DEPTH_TEST, depth_test);
+        enable(GL_STENCIL_TEST, stencil_test);
+        enable(GL_SCISSOR_TEST, scissor_test);
+        enable(GL_PRIMITIVE_RESTART, primitive_restart);
+        glPolygonMode(GL_FRONT_AND_BACK, GLenum(polygon_mode[0]));
+        glViewport(viewport[0], viewport[1], GLsizei(viewport[2]), GLsizei(viewport[3]));
+        glScissor(scissor_box[0], scissor_box[1], GLsizei(scissor_box[2]),
+            GLsizei(scissor_box[3]));
+    }
+};
+
+static void stream_render(ImDrawData const& dd)
+{
+    auto& s = stream_;
+    auto const fb_w = int(dd.DisplaySize.x * dd.FramebufferScale.x);
+    auto const fb_h = int(dd.DisplaySize.y * dd.FramebufferScale.y);
+    if (fb_w <= 0 || fb_h <= 0 || dd.CmdListsCount == 0)
+        return;
+
+    // vertices of all lists, then their indices
+    auto const vtx_bytes = GLsizeiptr(dd.TotalVtxCount) * GLsizeiptr(sizeof(ImDrawVert));
+    auto const idx_start = (vtx_bytes + 15) & ~GLsizeiptr{15};
+    auto const size = idx_start + GLsizeiptr(dd.TotalIdxCount) * GLsizeiptr(sizeof(ImDrawIdx));
+    stream_reserve(size);
+
+    auto base = GLintptr{0};
+    auto dst = static_cast<unsigned char*>(nullptr);
+    glBindBuffer(GL_ARRAY_BUFFER, s.buffer);
+    if (s.persistent) {
+        s.region = (s.region + 1) % stream_regions;
+        base = GLintptr(s.region) * s.region_size;
+        if (auto& fence = s.fences[s.region]) {
+            // the region must not be written before the GPU is done with it,
+            // wait for everything if the fence times out or fails
+            auto const r =
+                glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, GLuint64{1'000'000'000});
+            if (r != GL_ALREADY_SIGNALED && r != GL_CONDITION_SATISFIED)
+                glFinish();
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+        dst = s.mapped + base;
+    }
+    else {
+        // invalidating the whole buffer orphans the storage of the last frame
+        dst = static_cast<unsigned char*>(glMapBufferRange(
+            GL_ARRAY_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+        if (!dst)
+            return;
+    }
+    {
+        IMPLUS_PROFILE_SCOPE("render.upload");
+        auto vtx = dst;
+        auto idx = dst + idx_start;
+        for (auto i = 0; i < dd.CmdListsCount; ++i) {
+            auto const dl = dd.CmdLists[i];
+            auto const vb = std::size_t(dl->VtxBuffer.size_in_bytes());
+            auto const ib = std::size_t(dl->IdxBuffer.size_in_bytes());
+            std::memcpy(vtx, dl->VtxBuffer.Data, vb);
+            std::memcpy(idx, dl->IdxBuffer.Data, ib);
+            vtx += vb;
+            idx += ib;
+        }
+    }
+    if (!s.persistent)
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+
+    auto saved = stream_saved_state{};
+    saved.save();
+    stream_setup_state(dd, fb_w, fb_h, base);
+
+    auto const idx_type = sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+    auto const clip_off = dd.DisplayPos;
+    auto const clip_scale = dd.FramebufferScale;
+
+    // the commands that sample the distance field atlas use sdf_program
+    auto const sdf_tex = s.sdf_program && Font::DistanceFieldAtlas()
+                             ? GLuint(intptr_t(ImGui::GetIO().Fonts->TexID))
+                             : GLuint{0};
+
+    // state of the last draw command, unknown after user callbacks
+    auto known = false;
+    auto bound_tex = GLuint{0};
+    auto bound_program = s.program;
+    GLint scissor[4] = {};
+
+    auto vtx_base = GLint{0};
+    auto idx_base = base + GLintptr(idx_start);
+    for (auto i = 0; i < dd.CmdListsCount; ++i) {
+        auto const dl = dd.CmdLists[i];
+        for (auto const& cmd : dl->CmdBuffer) {
+            if (cmd.UserCallback) {
+                if (cmd.UserCallback == ImDrawCallback_ResetRenderState)
+                    stream_setup_state(dd, fb_w, fb_h, base);
+                else
+                    cmd.UserCallback(dl, &cmd);
+                known = false;
+                continue;
+            }
+
+            auto const min_x = (cmd.ClipRect.x - clip_off.x) * clip_scale.x;
+            auto const min_y = (cmd.ClipRect.y - clip_off.y) * clip_scale.y;
+            auto const max_x = (cmd.ClipRect.z - clip_off.x) * clip_scale.x;
+            auto const max_y = (cmd.ClipRect.w - clip_off.y) * clip_scale.y;
+            if (max_x <= min_x || max_y <= min_y)
+                continue;
+
+            GLint const rect[4] = {GLint(min_x), GLint(float(fb_h) - max_y),
+                GLint(max_x - min_x), GLint(max_y - min_y)};
+            if (!known || std::memcmp(rect, scissor, sizeof(rect)) != 0) {
+                glScissor(rect[0], rect[1], rect[2], rect[3]);
+                std::memcpy(scissor, rect, sizeof(rect));
+            }
+            auto const tex = GLuint(intptr_t(cmd.GetTexID()));
+            if (!known || tex != bound_tex) {
+                glBindTexture(GL_TEXTURE_2D, tex);
+                bound_tex = tex;
+            }
+            auto const program = sdf_tex && tex == sdf_tex ? s.sdf_program : s.program;
+            if (!known || program != bound_program) {
+                glUseProgram(program);
+                bound_program = program;
+            }
+            known = true;
+
+            glDrawElementsBaseVertex(GL_TRIANGLES, GLsizei(cmd.ElemCount), idx_type,
+                reinterpret_cast<void*>(idx_base + GLintptr(cmd.IdxOffset * sizeof(ImDrawIdx))),
+                vtx_base + GLint(cmd.VtxOffset));
+        }
+        vtx_base += dl->VtxBuffer.Size;
+        idx_base += GLintptr(dl->IdxBuffer.size_in_bytes());
+    }
+
+    if (s.persistent)
+        s.fences[s.region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    saved.restore();
+}
+
+#endif
+
 void SetupImplementation(ImPlus::Host::Window& wnd)
 {
     if (!ImGui_ImplOpenGL3_Init(glsl_version))
         throw std::runtime_error("Failed to init OpenGL renderer");
+    textures_ready_ = true;
 
 #if defined(IMPLUS_HOST_GLFW)
     auto window = static_cast<GLFWwindow*>(wnd.Handle());
@@ -180,9 +671,28 @@ void SetupImplementation(ImPlus::Host::Window& wnd)
     auto window = static_cast<SDL_Window*>(wnd.Handle());
     ImGui_ImplSDL3_InitForOpenGL(window, gl_context_);
 #endif
+
+#if defined(IMPLUS_GL3_STREAMING)
+    stream_setup();
+    if (stream_.ready)
+        ImGui::GetIO().BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+    internal::distance_field_renderer = stream_.sdf_program != 0;
+#endif
 }
 
-void ShutdownImplementation() { ImGui_ImplOpenGL3_Shutdown(); }
+void ShutdownImplementation()
+{
+    internal::release_device_textures();
+    textures_ready_ = false;
+    for (auto tex : textures_)
+        glDeleteTextures(1, &tex);
+    textures_.clear();
+#if defined(IMPLUS_GL3_STREAMING)
+    internal::distance_field_renderer = false;
+    stream_shutdown();
+#endif
+    ImGui_ImplOpenGL3_Shutdown();
+}
 
 void ShutdownInstance()
 {
@@ -201,10 +711,82 @@ void ShutdownInstance()
 #endif
 }
 
+// packed_rows returns tightly packed pixel rows, GL_UNPACK_ROW_LENGTH is not
+// available with GLES2/WebGL1
+static auto packed_rows(int width, int height, void const* pixels, int stride,
+    std::vector<unsigned char>& buf) -> void const*
+{
+    auto const row = std::size_t(width) * 4;
+    if (!pixels) {
+        buf.assign(row * height, 0);
+        return buf.data();
+    }
+    if (!stride || std::size_t(stride) == row)
+        return pixels;
+
+    buf.resize(row * height);
+    auto src = static_cast<unsigned char const*>(pixels);
+    for (auto y = 0; y < height; ++y)
+        std::memcpy(buf.data() + y * row, src + std::size_t(y) * stride, row);
+    return buf.data();
+}
+
+auto CreateTexture(int width, int height, void const* pixels, int stride) -> ImTextureID
+{
+    if (!textures_ready_ || width <= 0 || height <= 0)
+        return {};
+
+    auto buf = std::vector<unsigned char>{};
+    auto last_texture = GLint{0};
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture);
+
+    auto tex = GLuint{0};
+    glGenTextures(1, &tex);
+    glBindTexture(GL_TEXTURE_2D, tex);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+        packed_rows(width, height, pixels, stride, buf));
+    glBindTexture(GL_TEXTURE_2D, GLuint(last_texture));
+
+    textures_.insert(tex);
+    ++ResourceGeneration;
+    return (ImTextureID)(intptr_t)tex;
+}
+
+void UpdateTexture(
+    ImTextureID id, int x, int y, int width, int height, void const* pixels, int stride)
+{
+    auto const tex = GLuint((intptr_t)id);
+    if (!textures_.contains(tex) || width <= 0 || height <= 0)
+        return;
+
+    auto buf = std::vector<unsigned char>{};
+    auto last_texture = GLint{0};
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture);
+    glBindTexture(GL_TEXTURE_2D, tex);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE,
+        packed_rows(width, height, pixels, stride, buf));
+    glBindTexture(GL_TEXTURE_2D, GLuint(last_texture));
+    ++ResourceGeneration;
+}
+
+void DestroyTexture(ImTextureID id)
+{
+    auto tex = GLuint((intptr_t)id);
+    if (textures_.erase(tex))
+        glDeleteTextures(1, &tex);
+}
+
 void InvalidateDeviceObjects()
 {
     ImGui_ImplOpenGL3_DestroyFontsTexture();
     ImGui_ImplOpenGL3_CreateFontsTexture();
+    ++ResourceGeneration;
 }
 
 void NewFrame(ImPlus::Host::Window&) { ImGui_ImplOpenGL3_NewFrame(); }
@@ -213,14 +795,27 @@ void PrepareViewport(ImPlus::Host::Window& wnd)
 {
     auto const fbsize = wnd.FramebufferSize();
     glViewport(0, 0, fbsize.w, fbsize.h);
+    glDisable(GL_SCISSOR_TEST); // glClear is clipped by the scissor rect
     glClearColor(wnd.Background.x, wnd.Background.y, wnd.Background.z, wnd.Background.w);
     glClear(GL_COLOR_BUFFER_BIT);
 }
 
-void RenderDrawData() { ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData()); }
+void RenderDrawData()
+{
+    IMPLUS_PROFILE_SCOPE("render.draw");
+#if defined(IMPLUS_GL3_STREAMING)
+    if (stream_.ready) {
+        if (auto dd = ImGui::GetDrawData())
+            stream_render(*dd);
+        return;
+    }
+#endif
+    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+}
 
 void SwapBuffers(ImPlus::Host::Window& wnd)
 {
+    IMPLUS_PROFILE_SCOPE("render.swap");
 #if defined(IMPLUS_HOST_GLFW)
     auto window = static_cast<GLFWwindow*>(wnd.Handle());
     glfwSwapBuffers(window);
@@ -0,0 +1,193 @@
+#include "host-render.hpp"
+#include "internal/distance-field.hpp"
+#include "internal/raster.hpp"
+#include "internal/texture-pool.hpp"
+#include <implus/font.hpp>
+#include <implus/profiler.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// Renderer of the offscreen host: NULL discards the draw data, SOFTWARE
+// rasterizes it into an in-memory RGBA framebuffer (see Render::GetFramebuffer).
+
+namespace ImPlus::Render {
+
+struct texture {
+    int width = 0;
+    int height = 0;
+    std::vector<std::uint8_t> pixels; // kept by the software renderer only
+};
+
+static auto textures_ = std::unordered_map<std::intptr_t, std::unique_ptr<texture>>{};
+static auto font_texture_ = ImTextureID{};
+
+#if defined(IMPLUS_RENDER_SOFTWARE)
+static auto framebuffer_ = std::vector<std::uint8_t>{};
+static auto framebuffer_size_ = Host::Window::Size{};
+#endif
+
+auto GetDeviceInfo() -> Render::DeviceInfo { return {}; }
+
+auto GetFrameInfo() -> Render::FrameInfo { return {}; }
+
+void SetHint(U32Hint h, uint32_t value) {}
+
+void SetupWindowHints() {}
+
+void SetupInstance(ImPlus::Host::Window&) {}
+
+void SetupWindow(ImPlus::Host::Window&) {}
+
+void SetupImplementation(ImPlus::Host::Window&)
+{
+    auto& io = ImGui::GetIO();
+#if defined(IMPLUS_RENDER_SOFTWARE)
+    io.BackendRendererName = "implus_render_software";
+    internal::distance_field_renderer = true;
+#else
+    io.BackendRendererName = "implus_render_null";
+#endif
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+}
+
+void ShutdownImplementation()
+{
+    internal::distance_field_renderer = false;
+    internal::release_device_textures();
+    textures_.clear();
+    font_texture_ = ImTextureID{};
+    ImGui::GetIO().Fonts->SetTexID(ImTextureID{});
+}
+
+void ShutdownInstance() {}
+
+auto CreateTexture(int width, int height, void const* pixels, int stride) -> ImTextureID
+{
+    auto t = std::make_unique<texture>();
+    t->width = width;
+    t->height = height;
+    auto const id = std::intptr_t(t.get());
+    textures_.emplace(id, std::move(t));
+    UpdateTexture((ImTextureID)id, 0, 0, width, height, pixels, stride);
+    ++ResourceGeneration;
+    return (ImTextureID)id;
+}
+
+void UpdateTexture(
+    ImTextureID id, int x, int y, int width, int height, void const* pixels, int stride)
+{
+#if defined(IMPLUS_RENDER_SOFTWARE)
+    auto it = textures_.find(std::intptr_t(id));
+    if (it == textures_.end() || width <= 0 || height <= 0)
+        return;
+
+    auto& t = *it->second;
+    t.pixels.resize(std::size_t(t.width) * t.height * 4);
+
+    x = std::clamp(x, 0, t.width);
+    y = std::clamp(y, 0, t.height);
+    width = std::min(width, t.width - x);
+    height = std::min(height, t.height - y);
+
+    auto const row = std::size_t(width) * 4;
+    auto const src_stride = stride ? std::size_t(stride) : row;
+    auto const src = static_cast<std::uint8_t const*>(pixels);
+    for (auto r = 0; r < height; ++r) {
+        auto dst = t.pixels.data() + (std::size_t(y + r) * t.width + x) * 4;
+        if (src)
+            std::memcpy(dst, src + r * src_stride, row);
+        else
+            std::memset(dst, 0, row);
+    }
+    ++ResourceGeneration;
+#endif
+}
+
+void DestroyTexture(ImTextureID id) { textures_.erase(std::intptr_t(id)); }
+
+static void create_fonts_texture()
+{
+    auto& io = ImGui::GetIO();
+    unsigned char* pixels = nullptr;
+    auto w = 0;
+    auto h = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &w, &h);
+    font_texture_ = CreateTexture(w, h, pixels);
+    io.Fonts->SetTexID(font_texture_);
+}
+
+void InvalidateDeviceObjects()
+{
+    if (font_texture_)
+        DestroyTexture(font_texture_);
+    create_fonts_texture();
+}
+
+void NewFrame(ImPlus::Host::Window&)
+{
+    if (!font_texture_)
+        create_fonts_texture();
+}
+
+#if defined(IMPLUS_RENDER_SOFTWARE)
+
+static auto lookup_texture(ImTextureID id) -> internal::rgba_texture
+{
+    auto it = textures_.find(std::intptr_t(id));
+    if (it == textures_.end() || it->second->pixels.empty())
+        return {};
+    auto const& t = *it->second;
+    auto const distance_field = id == font_texture_ && Font::DistanceFieldAtlas();
+    return {t.width, t.height, t.pixels.data(), t.width * 4, distance_field};
+}
+
+void PrepareViewport(ImPlus::Host::Window& wnd)
+{
+    framebuffer_size_ = wnd.FramebufferSize();
+    auto const n = std::size_t(std::max(framebuffer_size_.w, 0)) * std::max(framebuffer_size_.h, 0);
+    framebuffer_.resize(n * 4);
+
+    auto const bg = ImGui::ColorConvertFloat4ToU32(wnd.Background);
+    std::uint8_t const rgba[4] = {std::uint8_t(bg >> IM_COL32_R_SHIFT),
+        std::uint8_t(bg >> IM_COL32_G_SHIFT), std::uint8_t(bg >> IM_COL32_B_SHIFT),
+        std::uint8_t(bg >> IM_COL32_A_SHIFT)};
+    for (auto i = std::size_t{0}; i < n; ++i)
+        std::memcpy(framebuffer_.data() + i * 4, rgba, 4);
+}
+
+void RenderDrawData()
+{
+    IMPLUS_PROFILE_SCOPE("render.draw");
+    auto const dd = ImGui::GetDrawData();
+    if (!dd || !dd->Valid)
+        return;
+
+    auto const w = framebuffer_size_.w;
+    auto const h = framebuffer_size_.h;
+    for (auto i = 0; i < dd->CmdListsCount; ++i) {
+        internal::rasterize_rgba(*dd->CmdLists[i], dd->DisplayPos, dd->FramebufferScale, w, h,
+            framebuffer_.data(), w * 4, lookup_texture);
+    }
+}
+
+auto GetFramebuffer() -> Framebuffer
+{
+    return {framebuffer_size_.w, framebuffer_size_.h, framebuffer_.data()};
+}
+
+#else
+
+void PrepareViewport(ImPlus::Host::Window&) {}
+
+void RenderDrawData() { IMPLUS_PROFILE_SCOPE("render.draw"); }
+
+#endif
+
+void SwapBuffers(ImPlus::Host::Window&) { IMPLUS_PROFILE_SCOPE("render.swap"); }
+
+} // namespace ImPlus::Render
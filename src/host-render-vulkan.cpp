@@ -1,6 +1,17 @@
 #include "host-render.hpp"
+#include "internal/distance-field.hpp"
+#include "internal/texture-pool.hpp"
+#include <implus/font.hpp>
+#include <implus/profiler.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <optional>
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #if defined(IMPLUS_HOST_GLFW)
 #include <backends/imgui_impl_glfw.h>
@@ -47,11 +58,71 @@ static VkPipelineCache g_PipelineCache = VK_NULL_HANDLE;
 static VkDescriptorPool g_DescriptorPool = VK_NULL_HANDLE;
 
 static ImGui_ImplVulkanH_Window g_MainWindowData;
-static uint32_t g_MinImageCount = 2;
+static uint32_t g_MinImageCount = 2; // Vulkan_MinImageCount
 static bool g_SwapChainRebuild = false;
+#ifdef APP_UNLIMITED_FRAME_RATE
+static VkPresentModeKHR g_PresentMode = VK_PRESENT_MODE_MAILBOX_KHR;
+#else
+static VkPresentModeKHR g_PresentMode = VK_PRESENT_MODE_FIFO_KHR;
+#endif
+static bool g_IncrementalPresent = false; // VK_KHR_incremental_present is enabled
+
+// the pool shared with imgui_impl_vulkan holds the font atlas and the sets of
+// applications that call ImGui_ImplVulkan_AddTexture with
+// DeviceInfo::descriptor_pool, textures of Render::CreateTexture and
+// Render::RegisterTexture have their own growing pools
+static auto Hint_CombinedImageSamplerCount = uint32_t{16};
+static auto Hint_DescriptorPoolMaxSets = uint32_t{16};
+
+// vertex and index buffers of each frame are allocated with at least this
+// size, so that typical frames never reallocate them
+static auto Hint_BufferReserve = uint32_t{1024 * 1024};
+
+#ifdef IMPLUS_ENABLE_PROFILER
+// input stamp of the frame submitted on each swap chain image, the latency is
+// recorded once its fence signals, it ends when the GPU has finished the frame
+// and doesn't include the wait for presentation
+static std::vector<std::optional<ImPlus::Profiler::clock::time_point>> g_FrameInput;
+
+static void RecordFrameLatency(uint32_t frame, ImPlus::Profiler::clock::time_point now)
+{
+    if (frame < g_FrameInput.size() && g_FrameInput[frame]) {
+        ImPlus::Profiler::RecordLatency(now - *g_FrameInput[frame]);
+        g_FrameInput[frame].reset();
+    }
+}
+#endif
 
-static auto Hint_CombinedImageSamplerCount = uint32_t{1};
-static auto Hint_DescriptorPoolMaxSets = uint32_t{1};
+struct Texture {
+    VkImage image = VK_NULL_HANDLE;
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkImageView view = VK_NULL_HANDLE;
+    VkDescriptorSet set = VK_NULL_HANDLE;
+};
+
+static std::unordered_map<VkDescriptorSet, Texture> g_Textures;
+static bool g_TexturesReady = false; // between SetupImplementation and ShutdownImplementation
+static std::vector<std::pair<uint64_t, Texture>> g_RetiredTextures; // serial, texture
+
+// texture descriptor sets are allocated from a chain of pools, each pool
+// twice the size of the previous one, released sets are recycled once the
+// last submission that can use them has completed
+static VkDescriptorSetLayout g_TextureSetLayout = VK_NULL_HANDLE;
+static std::vector<VkDescriptorPool> g_TexturePools;
+static uint32_t g_TexturePoolSize = 0; // sets in the last pool
+static uint32_t g_TexturePoolUsed = 0; // sets allocated from the last pool
+static std::vector<VkDescriptorSet> g_FreeSets;
+static std::vector<std::pair<uint64_t, VkDescriptorSet>> g_RetiredSets; // serial, set
+static std::unordered_set<VkDescriptorSet> g_RegisteredSets; // Render::RegisterTexture
+
+// frame submissions are numbered, a released resource is tagged with the
+// serial of the next submission (the frame being built may still draw it)
+// and recycled once the fences show that this submission has completed
+static uint64_t g_SubmitSerial = 0;         // last submitted frame
+static uint64_t g_CompletedSerial = 0;      // frames up to this one have completed
+static std::vector<uint64_t> g_ImageSerial; // last frame submitted on each swap chain image
+static VkSampler g_TextureSampler = VK_NULL_HANDLE;
+static VkCommandPool g_UploadCommandPool = VK_NULL_HANDLE;
 
 static void check_vk_result(VkResult err)
 {
@@ -220,6 +291,12 @@ static void SetupVulkan(ImVector<const char*> instance_extensions)
         if (IsExtensionAvailable(properties, VK_KHR_PORTABILITY_SUBSET_EXTENSION_NAME))
             device_extensions.push_back(VK_KHR_PORTABILITY_SUBSET_EXTENSION_NAME);
 #endif
+#ifdef VK_KHR_INCREMENTAL_PRESENT_EXTENSION_NAME
+        g_IncrementalPresent =
+            IsExtensionAvailable(properties, VK_KHR_INCREMENTAL_PRESENT_EXTENSION_NAME);
+        if (g_IncrementalPresent)
+            device_extensions.push_back(VK_KHR_INCREMENTAL_PRESENT_EXTENSION_NAME);
+#endif
 
         const float queue_priority[] = {1.0f};
         VkDeviceQueueCreateInfo queue_info[1] = {};
@@ -254,6 +331,14 @@ static void SetupVulkan(ImVector<const char*> instance_extensions)
     }
 }
 
+// SelectPresentMode selects the hinted present mode, FIFO is always available
+static void SelectPresentMode(ImGui_ImplVulkanH_Window* wd)
+{
+    VkPresentModeKHR present_modes[] = {g_PresentMode, VK_PRESENT_MODE_FIFO_KHR};
+    wd->PresentMode = ImGui_ImplVulkanH_SelectPresentMode(
+        g_PhysicalDevice, wd->Surface, &present_modes[0], IM_ARRAYSIZE(present_modes));
+}
+
 static void SetupVulkanWindow(
     ImGui_ImplVulkanH_Window* wd, VkSurfaceKHR surface, int width, int height)
 {
@@ -275,16 +360,7 @@ static void SetupVulkanWindow(
         requestSurfaceImageFormat, (size_t)IM_ARRAYSIZE(requestSurfaceImageFormat),
         requestSurfaceColorSpace);
 
-    // Select Present Mode
-#ifdef APP_UNLIMITED_FRAME_RATE
-    VkPresentModeKHR present_modes[] = {
-        VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_IMMEDIATE_KHR, VK_PRESENT_MODE_FIFO_KHR};
-#else
-    VkPresentModeKHR present_modes[] = {VK_PRESENT_MODE_FIFO_KHR};
-#endif
-    wd->PresentMode = ImGui_ImplVulkanH_SelectPresentMode(
-        g_PhysicalDevice, wd->Surface, &present_modes[0], IM_ARRAYSIZE(present_modes));
-    // printf("[vulkan] Selected PresentMode = %d\n", wd->PresentMode);
+    SelectPresentMode(wd);
 
     // Create SwapChain, RenderPass, Framebuffer, etc.
     IM_ASSERT(g_MinImageCount >= 2);
@@ -313,6 +389,8 @@ static void CleanupVulkanWindow()
     ImGui_ImplVulkanH_DestroyWindow(g_Instance, g_Device, &g_MainWindowData, g_Allocator);
 }
 
+static void InsertDistanceFieldCallbacks(ImDrawData* draw_data, VkCommandBuffer command_buffer);
+
 static void FrameRender(ImGui_ImplVulkanH_Window* wd, ImDrawData* draw_data)
 {
     VkResult err;
@@ -334,6 +412,9 @@ static void FrameRender(ImGui_ImplVulkanH_Window* wd, ImDrawData* draw_data)
         err = vkWaitForFences(g_Device, 1, &fd->Fence, VK_TRUE,
             UINT64_MAX); // wait indefinitely instead of periodically checking
         check_vk_result(err);
+#ifdef IMPLUS_ENABLE_PROFILER
+        RecordFrameLatency(wd->FrameIndex, ImPlus::Profiler::clock::now());
+#endif
 
         err = vkResetFences(g_Device, 1, &fd->Fence);
         check_vk_result(err);
@@ -360,6 +441,7 @@ static void FrameRender(ImGui_ImplVulkanH_Window* wd, ImDrawData* draw_data)
     }
 
     // Record dear imgui primitives into command buffer
+    InsertDistanceFieldCallbacks(draw_data, fd->CommandBuffer);
     ImGui_ImplVulkan_RenderDrawData(draw_data, fd->CommandBuffer);
 
     // Submit command buffer
@@ -381,6 +463,12 @@ static void FrameRender(ImGui_ImplVulkanH_Window* wd, ImDrawData* draw_data)
         err = vkQueueSubmit(g_Queue, 1, &info, fd->Fence);
         check_vk_result(err);
     }
+    g_ImageSerial.resize(wd->ImageCount);
+    g_ImageSerial[wd->FrameIndex] = ++g_SubmitSerial;
+#ifdef IMPLUS_ENABLE_PROFILER
+    g_FrameInput.resize(wd->ImageCount);
+    g_FrameInput[wd->FrameIndex] = ImPlus::Profiler::TakeInput();
+#endif
 }
 
 static void FramePresent(ImGui_ImplVulkanH_Window* wd)
@@ -396,6 +484,26 @@ static void FramePresent(ImGui_ImplVulkanH_Window* wd)
     info.swapchainCount = 1;
     info.pSwapchains = &wd->Swapchain;
     info.pImageIndices = &wd->FrameIndex;
+
+#ifdef VK_KHR_INCREMENTAL_PRESENT_EXTENSION_NAME
+    // the image is fully rendered, the region tells the presentation engine
+    // which part of it changed since the last present
+    auto const& damage = ImPlus::Render::PresentDamage;
+    VkRectLayerKHR rect = {};
+    VkPresentRegionKHR region = {};
+    VkPresentRegionsKHR regions = {};
+    if (g_IncrementalPresent && !damage.empty()) {
+        rect.offset = {damage.pos.x, damage.pos.y};
+        rect.extent = {uint32_t(damage.size.w), uint32_t(damage.size.h)};
+        region.rectangleCount = 1;
+        region.pRectangles = &rect;
+        regions.sType = VK_STRUCTURE_TYPE_PRESENT_REGIONS_KHR;
+        regions.swapchainCount = 1;
+        regions.pRegions = &region;
+        info.pNext = &regions;
+    }
+#endif
+
     VkResult err = vkQueuePresentKHR(g_Queue, &info);
     if (err == VK_ERROR_OUT_OF_DATE_KHR || err == VK_SUBOPTIMAL_KHR) {
         g_SwapChainRebuild = true;
@@ -406,6 +514,595 @@ static void FramePresent(ImGui_ImplVulkanH_Window* wd)
         (wd->SemaphoreIndex + 1) % wd->SemaphoreCount; // Now we can use the next set of semaphores
 }
 
+
+static uint32_t FindMemoryType(uint32_t type_bits, VkMemoryPropertyFlags flags)
+{
+    VkPhysicalDeviceMemoryProperties props;
+    vkGetPhysicalDeviceMemoryProperties(g_PhysicalDevice, &props);
+    for (uint32_t i = 0; i < props.memoryTypeCount; i++)
+        if ((type_bits & (1u << i)) && (props.memoryTypes[i].propertyFlags & flags) == flags)
+            return i;
+    throw std::runtime_error("[vulkan] Error: no suitable memory type");
+}
+
+// UploadTexture copies pixels through a staging buffer and waits for the
+// transfer, uploads are expected to be infrequent (atlas pages, images)
+static void UploadTexture(Texture& tex, int x, int y, int width, int height, void const* pixels,
+    int stride, bool initial)
+{
+    VkResult err;
+    auto const row = VkDeviceSize(width) * 4;
+    auto const size = row * height;
+
+    VkBuffer buffer;
+    VkDeviceMemory buffer_memory;
+    {
+        VkBufferCreateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        info.size = size;
+        info.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+        info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        err = vkCreateBuffer(g_Device, &info, g_Allocator, &buffer);
+        check_vk_result(err);
+
+        VkMemoryRequirements req;
+        vkGetBufferMemoryRequirements(g_Device, buffer, &req);
+        VkMemoryAllocateInfo alloc_info = {};
+        alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        alloc_info.allocationSize = req.size;
+        alloc_info.memoryTypeIndex = FindMemoryType(req.memoryTypeBits,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+        err = vkAllocateMemory(g_Device, &alloc_info, g_Allocator, &buffer_memory);
+        check_vk_result(err);
+        err = vkBindBufferMemory(g_Device, buffer, buffer_memory, 0);
+        check_vk_result(err);
+    }
+    {
+        void* map = nullptr;
+        err = vkMapMemory(g_Device, buffer_memory, 0, size, 0, &map);
+        check_vk_result(err);
+        auto src = static_cast<unsigned char const*>(pixels);
+        auto dst = static_cast<unsigned char*>(map);
+        auto const src_stride = stride ? VkDeviceSize(stride) : row;
+        for (int r = 0; r < height; r++) {
+            if (src)
+                std::memcpy(dst + r * row, src + r * src_stride, row);
+            else
+                std::memset(dst + r * row, 0, row);
+        }
+        vkUnmapMemory(g_Device, buffer_memory);
+    }
+
+    if (g_UploadCommandPool == VK_NULL_HANDLE) {
+        VkCommandPoolCreateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        info.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        info.queueFamilyIndex = g_QueueFamily;
+        err = vkCreateCommandPool(g_Device, &info, g_Allocator, &g_UploadCommandPool);
+        check_vk_result(err);
+    }
+
+    VkCommandBuffer command_buffer;
+    {
+        VkCommandBufferAllocateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        info.commandPool = g_UploadCommandPool;
+        info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        info.commandBufferCount = 1;
+        err = vkAllocateCommandBuffers(g_Device, &info, &command_buffer);
+        check_vk_result(err);
+
+        VkCommandBufferBeginInfo begin_info = {};
+        begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        begin_info.flags |= VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        err = vkBeginCommandBuffer(command_buffer, &begin_info);
+        check_vk_result(err);
+    }
+
+    // submission order makes the barrier wait for earlier frames sampling the
+    // texture
+    VkImageMemoryBarrier barrier = {};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = tex.image;
+    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.levelCount = 1;
+    barrier.subresourceRange.layerCount = 1;
+    barrier.srcAccessMask = 0;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.oldLayout =
+        initial ? VK_IMAGE_LAYOUT_UNDEFINED : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    vkCmdPipelineBarrier(command_buffer,
+        initial ? VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT : VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+    VkBufferImageCopy region = {};
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.layerCount = 1;
+    region.imageOffset = {x, y, 0};
+    region.imageExtent = {uint32_t(width), uint32_t(height), 1};
+    vkCmdCopyBufferToImage(command_buffer, buffer, tex.image,
+        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+    err = vkEndCommandBuffer(command_buffer);
+    check_vk_result(err);
+
+    VkSubmitInfo submit_info = {};
+    submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submit_info.commandBufferCount = 1;
+    submit_info.pCommandBuffers = &command_buffer;
+    err = vkQueueSubmit(g_Queue, 1, &submit_info, VK_NULL_HANDLE);
+    check_vk_result(err);
+    err = vkQueueWaitIdle(g_Queue);
+    check_vk_result(err);
+
+    vkFreeCommandBuffers(g_Device, g_UploadCommandPool, 1, &command_buffer);
+    vkDestroyBuffer(g_Device, buffer, g_Allocator);
+    vkFreeMemory(g_Device, buffer_memory, g_Allocator);
+}
+
+// the layout is defined like the one of imgui_impl_vulkan, so that its
+// pipeline accepts the sets
+static void CreateTextureSetLayout()
+{
+    VkDescriptorSetLayoutBinding binding = {};
+    binding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    binding.descriptorCount = 1;
+    binding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+    VkDescriptorSetLayoutCreateInfo info = {};
+    info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    info.bindingCount = 1;
+    info.pBindings = &binding;
+    auto err = vkCreateDescriptorSetLayout(g_Device, &info, g_Allocator, &g_TextureSetLayout);
+    check_vk_result(err);
+}
+
+static void AddTexturePool()
+{
+    g_TexturePoolSize = g_TexturePoolSize ? g_TexturePoolSize * 2 : 64;
+    VkDescriptorPoolSize pool_size = {
+        VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, g_TexturePoolSize};
+    VkDescriptorPoolCreateInfo info = {};
+    info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    info.maxSets = g_TexturePoolSize;
+    info.poolSizeCount = 1;
+    info.pPoolSizes = &pool_size;
+    auto pool = VkDescriptorPool{VK_NULL_HANDLE};
+    auto err = vkCreateDescriptorPool(g_Device, &info, g_Allocator, &pool);
+    check_vk_result(err);
+    g_TexturePools.push_back(pool);
+    g_TexturePoolUsed = 0;
+}
+
+static auto AllocateTextureSet(VkSampler sampler, VkImageView view, VkImageLayout layout)
+    -> VkDescriptorSet
+{
+    auto set = VkDescriptorSet{VK_NULL_HANDLE};
+    if (!g_FreeSets.empty()) {
+        set = g_FreeSets.back();
+        g_FreeSets.pop_back();
+    }
+    else {
+        if (g_TextureSetLayout == VK_NULL_HANDLE)
+            CreateTextureSetLayout();
+        if (g_TexturePools.empty() || g_TexturePoolUsed == g_TexturePoolSize)
+            AddTexturePool();
+
+        VkDescriptorSetAllocateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        info.descriptorPool = g_TexturePools.back();
+        info.descriptorSetCount = 1;
+        info.pSetLayouts = &g_TextureSetLayout;
+        auto err = vkAllocateDescriptorSets(g_Device, &info, &set);
+        check_vk_result(err);
+        ++g_TexturePoolUsed;
+    }
+
+    VkDescriptorImageInfo image = {};
+    image.sampler = sampler;
+    image.imageView = view;
+    image.imageLayout = layout;
+    VkWriteDescriptorSet write = {};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = set;
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    write.pImageInfo = &image;
+    vkUpdateDescriptorSets(g_Device, 1, &write, 0, nullptr);
+    return set;
+}
+
+static void CleanupTextureSets()
+{
+    for (auto pool : g_TexturePools)
+        vkDestroyDescriptorPool(g_Device, pool, g_Allocator);
+    g_TexturePools.clear();
+    g_TexturePoolSize = 0;
+    g_TexturePoolUsed = 0;
+    g_FreeSets.clear();
+    g_RetiredSets.clear();
+    g_RegisteredSets.clear();
+    if (g_TextureSetLayout != VK_NULL_HANDLE) {
+        vkDestroyDescriptorSetLayout(g_Device, g_TextureSetLayout, g_Allocator);
+        g_TextureSetLayout = VK_NULL_HANDLE;
+    }
+}
+
+static auto GetTextureSampler() -> VkSampler
+{
+    if (g_TextureSampler == VK_NULL_HANDLE) {
+        VkSamplerCreateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        info.magFilter = VK_FILTER_LINEAR;
+        info.minFilter = VK_FILTER_LINEAR;
+        info.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+        info.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        info.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        info.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        info.minLod = -1000;
+        info.maxLod = 1000;
+        info.maxAnisotropy = 1.0f;
+        auto err = vkCreateSampler(g_Device, &info, g_Allocator, &g_TextureSampler);
+        check_vk_result(err);
+    }
+    return g_TextureSampler;
+}
+
+static void ReleaseTexture(Texture& tex)
+{
+    g_FreeSets.push_back(tex.set);
+    vkDestroyImageView(g_Device, tex.view, g_Allocator);
+    vkDestroyImage(g_Device, tex.image, g_Allocator);
+    vkFreeMemory(g_Device, tex.memory, g_Allocator);
+}
+
+// UpdateCompletedSerial polls the fences of the frames in flight, the
+// completed serial is the one before the oldest frame still pending
+static void UpdateCompletedSerial()
+{
+    auto completed = g_SubmitSerial;
+    auto const images = std::min<size_t>(g_ImageSerial.size(), g_MainWindowData.ImageCount);
+    for (auto i = size_t{0}; i < images; ++i) {
+        auto const serial = g_ImageSerial[i];
+        if (serial <= g_CompletedSerial || serial > completed)
+            continue;
+        if (vkGetFenceStatus(g_Device, g_MainWindowData.Frames[i].Fence) != VK_SUCCESS)
+            completed = serial - 1;
+    }
+    g_CompletedSerial = std::max(g_CompletedSerial, completed);
+}
+
+// textures and sets are retired until the submission they were tagged with
+// has completed, all of them once the device is idle
+static void CollectRetiredTextures(bool all)
+{
+    std::erase_if(g_RetiredTextures, [&](auto& p) {
+        if (!all && p.first > g_CompletedSerial)
+            return false;
+        ReleaseTexture(p.second);
+        return true;
+    });
+    std::erase_if(g_RetiredSets, [&](auto& p) {
+        if (!all && p.first > g_CompletedSerial)
+            return false;
+        g_FreeSets.push_back(p.second);
+        return true;
+    });
+}
+
+static void CleanupTextures()
+{
+    CollectRetiredTextures(true);
+    for (auto& [set, tex] : g_Textures)
+        ReleaseTexture(tex);
+    g_Textures.clear();
+    CleanupTextureSets();
+
+    if (g_TextureSampler != VK_NULL_HANDLE) {
+        vkDestroySampler(g_Device, g_TextureSampler, g_Allocator);
+        g_TextureSampler = VK_NULL_HANDLE;
+    }
+    if (g_UploadCommandPool != VK_NULL_HANDLE) {
+        vkDestroyCommandPool(g_Device, g_UploadCommandPool, g_Allocator);
+        g_UploadCommandPool = VK_NULL_HANDLE;
+    }
+}
+
+// distance field pipeline
+//
+// The commands that sample a distance field font atlas (see
+// Font::SetDistanceFieldAtlas) are drawn with a pipeline of its own, bound by
+// a callback inserted ahead of them, ImDrawCallback_ResetRenderState after
+// them rebinds the pipeline of imgui_impl_vulkan. The pipeline layout is
+// compatible with the one of imgui_impl_vulkan, the descriptor sets it binds
+// and the constants it pushes stay valid across the switch.
+//
+// The shaders were assembled from this GLSL:
+//
+//   layout(location = 0) in vec2 aPos;
+//   layout(location = 1) in vec2 aUV;
+//   layout(location = 2) in vec4 aColor;
+//   layout(push_constant) uniform uPushConstant { vec2 uScale; vec2 uTranslate; } pc;
+//   layout(location = 0) out vec4 Color;
+//   layout(location = 1) out vec2 UV;
+//   void main()
+//   {
+//       Color = aColor;
+//       UV = aUV;
+//       gl_Position = vec4(aPos * pc.uScale + pc.uTranslate, 0, 1);
+//   }
+//
+//   layout(location = 0) in vec4 Color;
+//   layout(location = 1) in vec2 UV;
+//   layout(set = 0, binding = 0) uniform sampler2D sTexture;
+//   layout(location = 0) out vec4 fColor;
+//   void main()
+//   {
+//       float d = texture(sTexture, UV).a;
+//       float coverage = clamp((d - 0.5) / max(fwidth(d), 1e-5) + 0.5, 0.0, 1.0);
+//       fColor = vec4(Color.rgb, Color.a * coverage);
+//   }
+//
+static uint32_t const g_DistanceFieldVertSpv[] = {
+    0x07230203, 0x00010000, 0x00000000, 0x0000002a, 0x00000000, 0x00020011, 0x00000001, 0x0003000e,
+    0x00000000, 0x00000001, 0x000b000f, 0x00000000, 0x00000001, 0x6e69616d, 0x00000000, 0x00000002,
+    0x00000003, 0x00000004, 0x00000005, 0x00000006, 0x00000007, 0x00040047, 0x00000002, 0x0000001e,
+    0x00000000, 0x00040047, 0x00000003, 0x0000001e, 0x00000001, 0x00040047, 0x00000004, 0x0000001e,
+    0x00000002, 0x00040047, 0x00000005, 0x0000001e, 0x00000000, 0x00040047, 0x00000006, 0x0000001e,
+    0x00000001, 0x00050048, 0x00000008, 0x00000000, 0x0000000b, 0x00000000, 0x00030047, 0x00000008,
+    0x00000002, 0x00050048, 0x00000009, 0x00000000, 0x00000023, 0x00000000, 0x00050048, 0x00000009,
+    0x00000001, 0x00000023, 0x00000008, 0x00030047, 0x00000009, 0x00000002, 0x00020013, 0x0000000a,
+    0x00030021, 0x0000000b, 0x0000000a, 0x00030016, 0x0000000c, 0x00000020, 0x00040017, 0x0000000d,
+    0x0000000c, 0x00000002, 0x00040017, 0x0000000e, 0x0000000c, 0x00000004, 0x00040015, 0x0000000f,
+    0x00000020, 0x00000001, 0x0004002b, 0x0000000f, 0x00000010, 0x00000000, 0x0004002b, 0x0000000f,
+    0x00000011, 0x00000001, 0x0004002b, 0x0000000c, 0x00000012, 0x00000000, 0x0004002b, 0x0000000c,
+    0x00000013, 0x3f800000, 0x0003001e, 0x00000008, 0x0000000e, 0x00040020, 0x00000014, 0x00000003,
+    0x00000008, 0x0004003b, 0x00000014, 0x00000007, 0x00000003, 0x00040020, 0x00000015, 0x00000001,
+    0x0000000d, 0x00040020, 0x00000016, 0x00000001, 0x0000000e, 0x0004003b, 0x00000015, 0x00000002,
+    0x00000001, 0x0004003b, 0x00000015, 0x00000003, 0x00000001, 0x0004003b, 0x00000016, 0x00000004,
+    0x00000001, 0x00040020, 0x00000017, 0x00000003, 0x0000000e, 0x00040020, 0x00000018, 0x00000003,
+    0x0000000d, 0x0004003b, 0x00000017, 0x00000005, 0x00000003, 0x0004003b, 0x00000018, 0x00000006,
+    0x00000003, 0x0004001e, 0x00000009, 0x0000000d, 0x0000000d, 0x00040020, 0x00000019, 0x00000009,
+    0x00000009, 0x0004003b, 0x00000019, 0x0000001a, 0x00000009, 0x00040020, 0x0000001b, 0x00000009,
+    0x0000000d, 0x00050036, 0x0000000a, 0x00000001, 0x00000000, 0x0000000b, 0x000200f8, 0x0000001c,
+    0x0004003d, 0x0000000e, 0x0000001d, 0x00000004, 0x0003003e, 0x00000005, 0x0000001d, 0x0004003d,
+    0x0000000d, 0x0000001e, 0x00000003, 0x0003003e, 0x00000006, 0x0000001e, 0x0004003d, 0x0000000d,
+    0x0000001f, 0x00000002, 0x00050041, 0x0000001b, 0x00000020, 0x0000001a, 0x00000010, 0x0004003d,
+    0x0000000d, 0x00000021, 0x00000020, 0x00050041, 0x0000001b, 0x00000022, 0x0000001a, 0x00000011,
+    0x0004003d, 0x0000000d, 0x00000023, 0x00000022, 0x00050085, 0x0000000d, 0x00000024, 0x0000001f,
+    0x00000021, 0x00050081, 0x0000000d, 0x00000025, 0x00000024, 0x00000023, 0x00050051, 0x0000000c,
+    0x00000026, 0x00000025, 0x00000000, 0x00050051, 0x0000000c, 0x00000027, 0x00000025, 0x00000001,
+    0x00070050, 0x0000000e, 0x00000028, 0x00000026, 0x00000027, 0x00000012, 0x00000013, 0x00050041,
+    0x00000017, 0x00000029, 0x00000007, 0x00000010, 0x0003003e, 0x00000029, 0x00000028, 0x000100fd,
+    0x00010038,
+};
+
+static uint32_t const g_DistanceFieldFragSpv[] = {
+    0x07230203, 0x00010000, 0x00000000, 0x00000025, 0x00000000, 0x00020011, 0x00000001, 0x0006000b,
+    0x00000001, 0x4c534c47, 0x6474732e, 0x3035342e, 0x00000000, 0x0003000e, 0x00000000, 0x00000001,
+    0x0008000f, 0x00000004, 0x00000002, 0x6e69616d, 0x00000000, 0x00000003, 0x00000004, 0x00000005,
+    0x00030010, 0x00000002, 0x00000007, 0x00040047, 0x00000003, 0x0000001e, 0x00000000, 0x00040047,
+    0x00000004, 0x0000001e, 0x00000001, 0x00040047, 0x00000005, 0x0000001e, 0x00000000, 0x00040047,
+    0x00000006, 0x00000022, 0x00000000, 0x00040047, 0x00000006, 0x00000021, 0x00000000, 0x00020013,
+    0x00000007, 0x00030021, 0x00000008, 0x00000007, 0x00030016, 0x00000009, 0x00000020, 0x00040017,
+    0x0000000a, 0x00000009, 0x00000002, 0x00040017, 0x0000000b, 0x00000009, 0x00000004, 0x0004002b,
+    0x00000009, 0x0000000c, 0x00000000, 0x0004002b, 0x00000009, 0x0000000d, 0x3f800000, 0x0004002b,
+    0x00000009, 0x0000000e, 0x3f000000, 0x0004002b, 0x00000009, 0x0000000f, 0x3727c5ac, 0x00040020,
+    0x00000010, 0x00000001, 0x0000000b, 0x00040020, 0x00000011, 0x00000001, 0x0000000a, 0x00040020,
+    0x00000012, 0x00000003, 0x0000000b, 0x0004003b, 0x00000010, 0x00000003, 0x00000001, 0x0004003b,
+    0x00000011, 0x00000004, 0x00000001, 0x0004003b, 0x00000012, 0x00000005, 0x00000003, 0x00090019,
+    0x00000013, 0x00000009, 0x00000001, 0x00000000, 0x00000000, 0x00000000, 0x00000001, 0x00000000,
+    0x0003001b, 0x00000014, 0x00000013, 0x00040020, 0x00000015, 0x00000000, 0x00000014, 0x0004003b,
+    0x00000015, 0x00000006, 0x00000000, 0x00050036, 0x00000007, 0x00000002, 0x00000000, 0x00000008,
+    0x000200f8, 0x00000016, 0x0004003d, 0x0000000b, 0x00000017, 0x00000003, 0x0004003d, 0x0000000a,
+    0x00000018, 0x00000004, 0x0004003d, 0x00000014, 0x00000019, 0x00000006, 0x00050057, 0x0000000b,
+    0x0000001a, 0x00000019, 0x00000018, 0x00050051, 0x00000009, 0x0000001b, 0x0000001a, 0x00000003,
+    0x000400d1, 0x00000009, 0x0000001c, 0x0000001b, 0x0007000c, 0x00000009, 0x0000001d, 0x00000001,
+    0x00000028, 0x0000001c, 0x0000000f, 0x00050083, 0x00000009, 0x0000001e, 0x0000001b, 0x0000000e,
+    0x00050088, 0x00000009, 0x0000001f, 0x0000001e, 0x0000001d, 0x00050081, 0x00000009, 0x00000020,
+    0x0000001f, 0x0000000e, 0x0008000c, 0x00000009, 0x00000021, 0x00000001, 0x0000002b, 0x00000020,
+    0x0000000c, 0x0000000d, 0x00050051, 0x00000009, 0x00000022, 0x00000017, 0x00000003, 0x00050085,
+    0x00000009, 0x00000023, 0x00000022, 0x00000021, 0x00060052, 0x0000000b, 0x00000024, 0x00000023,
+    0x00000017, 0x00000003, 0x0003003e, 0x00000005, 0x00000024, 0x000100fd, 0x00010038,
+};
+
+static VkPipelineLayout g_DistanceFieldLayout = VK_NULL_HANDLE;
+static VkPipeline g_DistanceFieldPipeline = VK_NULL_HANDLE;
+
+static auto CreateShaderModule(uint32_t const* code, size_t size) -> VkShaderModule
+{
+    VkShaderModuleCreateInfo info = {};
+    info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    info.codeSize = size;
+    info.pCode = code;
+    auto shader = VkShaderModule{VK_NULL_HANDLE};
+    auto err = vkCreateShaderModule(g_Device, &info, g_Allocator, &shader);
+    check_vk_result(err);
+    return shader;
+}
+
+// the fixed function state is the one of imgui_impl_vulkan
+static void CreateDistanceFieldPipeline(VkRenderPass render_pass)
+{
+    if (g_TextureSetLayout == VK_NULL_HANDLE)
+        CreateTextureSetLayout();
+
+    VkPushConstantRange push_constants = {};
+    push_constants.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+    push_constants.offset = 0;
+    push_constants.size = sizeof(float) * 4;
+    VkPipelineLayoutCreateInfo layout_info = {};
+    layout_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    layout_info.setLayoutCount = 1;
+    layout_info.pSetLayouts = &g_TextureSetLayout;
+    layout_info.pushConstantRangeCount = 1;
+    layout_info.pPushConstantRanges = &push_constants;
+    auto err = vkCreatePipelineLayout(g_Device, &layout_info, g_Allocator, &g_DistanceFieldLayout);
+    check_vk_result(err);
+
+    auto const vert = CreateShaderModule(g_DistanceFieldVertSpv, sizeof(g_DistanceFieldVertSpv));
+    auto const frag = CreateShaderModule(g_DistanceFieldFragSpv, sizeof(g_DistanceFieldFragSpv));
+    VkPipelineShaderStageCreateInfo stages[2] = {};
+    stages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
+    stages[0].module = vert;
+    stages[0].pName = "main";
+    stages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+    stages[1].module = frag;
+    stages[1].pName = "main";
+
+    VkVertexInputBindingDescription binding = {};
+    binding.stride = sizeof(ImDrawVert);
+    binding.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+    VkVertexInputAttributeDescription attributes[3] = {};
+    attributes[0].location = 0;
+    attributes[0].format = VK_FORMAT_R32G32_SFLOAT;
+    attributes[0].offset = offsetof(ImDrawVert, pos);
+    attributes[1].location = 1;
+    attributes[1].format = VK_FORMAT_R32G32_SFLOAT;
+    attributes[1].offset = offsetof(ImDrawVert, uv);
+    attributes[2].location = 2;
+    attributes[2].format = VK_FORMAT_R8G8B8A8_UNORM;
+    attributes[2].offset = offsetof(ImDrawVert, col);
+    VkPipelineVertexInputStateCreateInfo vertex_info = {};
+    vertex_info.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+    vertex_info.vertexBindingDescriptionCount = 1;
+    vertex_info.pVertexBindingDescriptions = &binding;
+    vertex_info.vertexAttributeDescriptionCount = 3;
+    vertex_info.pVertexAttributeDescriptions = attributes;
+
+    VkPipelineInputAssemblyStateCreateInfo ia_info = {};
+    ia_info.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+    ia_info.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+    VkPipelineViewportStateCreateInfo viewport_info = {};
+    viewport_info.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+    viewport_info.viewportCount = 1;
+    viewport_info.scissorCount = 1;
+
+    VkPipelineRasterizationStateCreateInfo raster_info = {};
+    raster_info.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+    raster_info.polygonMode = VK_POLYGON_MODE_FILL;
+    raster_info.cullMode = VK_CULL_MODE_NONE;
+    raster_info.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+    raster_info.lineWidth = 1.0f;
+
+    VkPipelineMultisampleStateCreateInfo ms_info = {};
+    ms_info.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+    ms_info.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+    VkPipelineColorBlendAttachmentState color_attachment = {};
+    color_attachment.blendEnable = VK_TRUE;
+    color_attachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+    color_attachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    color_attachment.colorBlendOp = VK_BLEND_OP_ADD;
+    color_attachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+    color_attachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    color_attachment.alphaBlendOp = VK_BLEND_OP_ADD;
+    color_attachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT |
+                                      VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+    VkPipelineColorBlendStateCreateInfo blend_info = {};
+    blend_info.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+    blend_info.attachmentCount = 1;
+    blend_info.pAttachments = &color_attachment;
+
+    VkPipelineDepthStencilStateCreateInfo depth_info = {};
+    depth_info.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+
+    VkDynamicState dynamic_states[2] = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+    VkPipelineDynamicStateCreateInfo dynamic_state = {};
+    dynamic_state.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+    dynamic_state.dynamicStateCount = 2;
+    dynamic_state.pDynamicStates = dynamic_states;
+
+    VkGraphicsPipelineCreateInfo info = {};
+    info.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    info.stageCount = 2;
+    info.pStages = stages;
+    info.pVertexInputState = &vertex_info;
+    info.pInputAssemblyState = &ia_info;
+    info.pViewportState = &viewport_info;
+    info.pRasterizationState = &raster_info;
+    info.pMultisampleState = &ms_info;
+    info.pDepthStencilState = &depth_info;
+    info.pColorBlendState = &blend_info;
+    info.pDynamicState = &dynamic_state;
+    info.layout = g_DistanceFieldLayout;
+    info.renderPass = render_pass;
+    info.subpass = 0;
+    err = vkCreateGraphicsPipelines(
+        g_Device, g_PipelineCache, 1, &info, g_Allocator, &g_DistanceFieldPipeline);
+    check_vk_result(err);
+
+    vkDestroyShaderModule(g_Device, vert, g_Allocator);
+    vkDestroyShaderModule(g_Device, frag, g_Allocator);
+}
+
+static void DestroyDistanceFieldPipeline()
+{
+    if (g_DistanceFieldPipeline != VK_NULL_HANDLE) {
+        vkDestroyPipeline(g_Device, g_DistanceFieldPipeline, g_Allocator);
+        g_DistanceFieldPipeline = VK_NULL_HANDLE;
+    }
+    if (g_DistanceFieldLayout != VK_NULL_HANDLE) {
+        vkDestroyPipelineLayout(g_Device, g_DistanceFieldLayout, g_Allocator);
+        g_DistanceFieldLayout = VK_NULL_HANDLE;
+    }
+}
+
+// the command buffer is passed as the user data of the callback
+static void BindDistanceFieldPipeline(ImDrawList const*, ImDrawCmd const* cmd)
+{
+    auto const command_buffer = static_cast<VkCommandBuffer>(cmd->UserCallbackData);
+    vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, g_DistanceFieldPipeline);
+}
+
+// InsertDistanceFieldCallbacks surrounds each run of commands that sample the
+// distance field atlas with the callbacks that switch the pipelines, the
+// draw lists are rebuilt by the next frame
+static void InsertDistanceFieldCallbacks(ImDrawData* draw_data, VkCommandBuffer command_buffer)
+{
+    if (g_DistanceFieldPipeline == VK_NULL_HANDLE || !ImPlus::Font::DistanceFieldAtlas())
+        return;
+
+    auto const atlas = ImGui::GetIO().Fonts->TexID;
+    auto const callback = [](ImDrawCmd const& at, ImDrawCallback fn, void* data) {
+        auto cmd = ImDrawCmd{};
+        cmd.ClipRect = at.ClipRect;
+        cmd.VtxOffset = at.VtxOffset;
+        cmd.IdxOffset = at.IdxOffset;
+        cmd.UserCallback = fn;
+        cmd.UserCallbackData = data;
+        return cmd;
+    };
+    for (auto n = 0; n < draw_data->CmdListsCount; ++n) {
+        auto& cmds = draw_data->CmdLists[n]->CmdBuffer;
+        auto bound = false;
+        for (auto i = 0; i < cmds.Size; ++i) {
+            auto const sdf = !cmds[i].UserCallback && cmds[i].GetTexID() == atlas;
+            if (sdf == bound)
+                continue;
+            auto const cmd = sdf ? callback(cmds[i], BindDistanceFieldPipeline, command_buffer)
+                                 : callback(cmds[i], ImDrawCallback_ResetRenderState, nullptr);
+            cmds.insert(cmds.Data + i, cmd);
+            ++i;
+            bound = sdf;
+        }
+        if (bound)
+            cmds.push_back(callback(cmds.back(), ImDrawCallback_ResetRenderState, nullptr));
+    }
+}
+
 namespace ImPlus::Render {
 
 void SetHint(ImPlus::Render::U32Hint h, uint32_t v)
@@ -415,6 +1112,15 @@ void SetHint(ImPlus::Render::U32Hint h, uint32_t v)
         Hint_CombinedImageSamplerCount = v;
         break;
     case ImPlus::Render::Vulkan_DescriptorPoolMaxSets: Hint_DescriptorPoolMaxSets = v; break;
+    case ImPlus::Render::Vulkan_MinImageCount:
+        g_MinImageCount = v < 2 ? 2 : v;
+        g_SwapChainRebuild = g_Device != VK_NULL_HANDLE;
+        break;
+    case ImPlus::Render::Vulkan_PresentMode:
+        g_PresentMode = VkPresentModeKHR(v);
+        g_SwapChainRebuild = g_Device != VK_NULL_HANDLE;
+        break;
+    case ImPlus::Render::Vulkan_BufferReserve: Hint_BufferReserve = v; break;
     }
 }
 
@@ -541,18 +1247,118 @@ void SetupImplementation(ImPlus::Host::Window& wnd)
     init_info.MinImageCount = g_MinImageCount;
     init_info.ImageCount = wd->ImageCount;
     init_info.MSAASamples = VK_SAMPLE_COUNT_1_BIT;
+    init_info.MinAllocationSize = Hint_BufferReserve;
     init_info.Allocator = g_Allocator;
     init_info.CheckVkResultFn = check_vk_result;
     ImGui_ImplVulkan_Init(&init_info);
+    g_TexturesReady = true;
+
+    CreateDistanceFieldPipeline(wd->RenderPass);
+    internal::distance_field_renderer = true;
 }
 
 void ShutdownImplementation()
 {
+    internal::release_device_textures();
+    g_TexturesReady = false;
     auto err = vkDeviceWaitIdle(g_Device);
     check_vk_result(err);
+    internal::distance_field_renderer = false;
+    DestroyDistanceFieldPipeline();
+    CleanupTextures();
     ImGui_ImplVulkan_Shutdown();
 }
 
+auto CreateTexture(int width, int height, void const* pixels, int stride) -> ImTextureID
+{
+    if (!g_TexturesReady || width <= 0 || height <= 0)
+        return {};
+
+    VkResult err;
+    auto tex = Texture{};
+    {
+        VkImageCreateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        info.imageType = VK_IMAGE_TYPE_2D;
+        info.format = VK_FORMAT_R8G8B8A8_UNORM;
+        info.extent = {uint32_t(width), uint32_t(height), 1};
+        info.mipLevels = 1;
+        info.arrayLayers = 1;
+        info.samples = VK_SAMPLE_COUNT_1_BIT;
+        info.tiling = VK_IMAGE_TILING_OPTIMAL;
+        info.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+        info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        err = vkCreateImage(g_Device, &info, g_Allocator, &tex.image);
+        check_vk_result(err);
+
+        VkMemoryRequirements req;
+        vkGetImageMemoryRequirements(g_Device, tex.image, &req);
+        VkMemoryAllocateInfo alloc_info = {};
+        alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        alloc_info.allocationSize = req.size;
+        alloc_info.memoryTypeIndex =
+            FindMemoryType(req.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        err = vkAllocateMemory(g_Device, &alloc_info, g_Allocator, &tex.memory);
+        check_vk_result(err);
+        err = vkBindImageMemory(g_Device, tex.image, tex.memory, 0);
+        check_vk_result(err);
+    }
+    {
+        VkImageViewCreateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        info.image = tex.image;
+        info.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        info.format = VK_FORMAT_R8G8B8A8_UNORM;
+        info.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        info.subresourceRange.levelCount = 1;
+        info.subresourceRange.layerCount = 1;
+        err = vkCreateImageView(g_Device, &info, g_Allocator, &tex.view);
+        check_vk_result(err);
+    }
+
+    UploadTexture(tex, 0, 0, width, height, pixels, stride, true);
+    tex.set = AllocateTextureSet(
+        GetTextureSampler(), tex.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    g_Textures.emplace(tex.set, tex);
+    ++ResourceGeneration;
+    return (ImTextureID)tex.set;
+}
+
+void UpdateTexture(
+    ImTextureID id, int x, int y, int width, int height, void const* pixels, int stride)
+{
+    auto it = g_Textures.find((VkDescriptorSet)id);
+    if (it == g_Textures.end() || width <= 0 || height <= 0)
+        return;
+    UploadTexture(it->second, x, y, width, height, pixels, stride, false);
+    ++ResourceGeneration;
+}
+
+void DestroyTexture(ImTextureID id)
+{
+    auto it = g_Textures.find((VkDescriptorSet)id);
+    if (it == g_Textures.end())
+        return;
+    g_RetiredTextures.emplace_back(g_SubmitSerial + 1, it->second);
+    g_Textures.erase(it);
+}
+
+auto RegisterTexture(VkImageView view, VkImageLayout layout, VkSampler sampler) -> ImTextureID
+{
+    auto set = AllocateTextureSet(sampler ? sampler : GetTextureSampler(), view, layout);
+    g_RegisteredSets.insert(set);
+    ++ResourceGeneration;
+    return (ImTextureID)set;
+}
+
+void UnregisterTexture(ImTextureID id)
+{
+    auto set = (VkDescriptorSet)id;
+    if (g_RegisteredSets.erase(set))
+        g_RetiredSets.emplace_back(g_SubmitSerial + 1, set);
+}
+
 void ShutdownInstance()
 {
     CleanupVulkanWindow();
@@ -563,6 +1369,7 @@ void InvalidateDeviceObjects()
 {
     ImGui_ImplVulkan_DestroyFontsTexture();
     ImGui_ImplVulkan_CreateFontsTexture();
+    ++ResourceGeneration;
 }
 
 void NewFrame(ImPlus::Host::Window& wnd)
@@ -577,13 +1384,34 @@ void NewFrame(ImPlus::Host::Window& wnd)
     if (fbsize.w > 0 && fbsize.h > 0 &&
         (g_SwapChainRebuild || g_MainWindowData.Width != fbsize.w ||
             g_MainWindowData.Height != fbsize.h)) {
+        SelectPresentMode(&g_MainWindowData);
         ImGui_ImplVulkan_SetMinImageCount(g_MinImageCount);
         ImGui_ImplVulkanH_CreateOrResizeWindow(g_Instance, g_PhysicalDevice, g_Device,
             &g_MainWindowData, g_QueueFamily, g_Allocator, fbsize.w, fbsize.h, g_MinImageCount);
         g_MainWindowData.FrameIndex = 0;
         g_SwapChainRebuild = false;
+        ++ResourceGeneration;
+        // the rebuild waited for the device, the new images have new fences
+        g_CompletedSerial = g_SubmitSerial;
+        g_ImageSerial.clear();
+#ifdef IMPLUS_ENABLE_PROFILER
+        g_FrameInput.clear(); // the rebuild waited for all frames
+#endif
     }
 
+    UpdateCompletedSerial();
+    CollectRetiredTextures(false);
+
+#ifdef IMPLUS_ENABLE_PROFILER
+    // frames in flight that completed since the last frame
+    auto const now = ImPlus::Profiler::clock::now();
+    for (auto i = uint32_t{0}; i < g_FrameInput.size() && i < g_MainWindowData.ImageCount; ++i) {
+        if (g_FrameInput[i] &&
+            vkGetFenceStatus(g_Device, g_MainWindowData.Frames[i].Fence) == VK_SUCCESS)
+            RecordFrameLatency(i, now);
+    }
+#endif
+
     ImGui_ImplVulkan_NewFrame();
 }
 
@@ -598,6 +1426,7 @@ void PrepareViewport(ImPlus::Host::Window& wnd)
 
 void RenderDrawData()
 {
+    IMPLUS_PROFILE_SCOPE("render.draw");
     auto* wd = &g_MainWindowData;
     ImDrawData* draw_data = ImGui::GetDrawData();
     const bool is_minimized =
@@ -608,6 +1437,7 @@ void RenderDrawData()
 
 void SwapBuffers(ImPlus::Host::Window&)
 {
+    IMPLUS_PROFILE_SCOPE("render.swap");
     auto* wd = &g_MainWindowData;
     ImDrawData* draw_data = ImGui::GetDrawData();
     const bool is_minimized =
@@ -24,4 +24,14 @@ void RenderDrawData();
 
 void SwapBuffers(ImPlus::Host::Window&);
 
+// ResourceGeneration is incremented by the renderers whenever resources that
+// draw commands refer to change (texture contents, device objects, swap
+// chains), frames are never skipped across generations
+inline unsigned ResourceGeneration = 0;
+
+// PresentDamage is the region of the framebuffer (pixels, top-left origin)
+// that changed since the last presented frame, SwapBuffers may present only
+// this region where supported, an empty region presents the whole frame
+inline ImPlus::Host::Window::Bounds PresentDamage;
+
 } // namespace ImPlus::Render
\ No newline at end of file
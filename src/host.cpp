@@ -3,8 +3,14 @@
 #include <implus/host.hpp>
 #include <implus/render-device.hpp>
 
+#include "host-render.hpp"
+#include "internal/frame-digest.hpp"
+
 #include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <codecvt>
+#include <thread>
 
 namespace ImPlus::Host {
 
@@ -28,6 +34,110 @@ void Window::Locate(Location const& loc, bool constrain_to_monitor)
     }
 }
 
+// frame_state holds the digest of the last presented frame and the pacing of
+// skipped frames
+struct Window::frame_state {
+    using clock = std::chrono::steady_clock;
+
+    internal::frame_digest last;
+    internal::frame_digest next;
+    bool valid = false;
+    unsigned resources = 0;
+    ImVec4 background = {};
+
+    clock::time_point frame_time = {}; // previous call of begin_present
+    bool presented = false;            // the previous frame was presented
+    double interval = 1.0 / 60.0;      // smoothed interval of presented frames
+};
+
+void Window::InvalidateFrame()
+{
+    if (frame_)
+        frame_->valid = false;
+}
+
+static auto same_color(ImVec4 const& a, ImVec4 const& b) -> bool
+{
+    return a.x == b.x && a.y == b.y && a.z == b.z && a.w == b.w;
+}
+
+// damage_pixels converts a damage rect in display coordinates to framebuffer
+// pixels, empty if it covers the whole framebuffer
+static auto damage_pixels(ImVec4 const& r, ImDrawData const& dd) -> Window::Bounds
+{
+    auto const sx = dd.FramebufferScale.x;
+    auto const sy = dd.FramebufferScale.y;
+    auto const fb_w = int(dd.DisplaySize.x * sx);
+    auto const fb_h = int(dd.DisplaySize.y * sy);
+    auto const x0 = std::clamp(int(std::floor((r.x - dd.DisplayPos.x) * sx)), 0, fb_w);
+    auto const y0 = std::clamp(int(std::floor((r.y - dd.DisplayPos.y) * sy)), 0, fb_h);
+    auto const x1 = std::clamp(int(std::ceil((r.z - dd.DisplayPos.x) * sx)), 0, fb_w);
+    auto const y1 = std::clamp(int(std::ceil((r.w - dd.DisplayPos.y) * sy)), 0, fb_h);
+    if (x0 == 0 && y0 == 0 && x1 == fb_w && y1 == fb_h)
+        return {};
+    return {{x0, y0}, {x1 - x0, y1 - y0}};
+}
+
+// begin_present returns false if the frame rendered by ImGui::Render shows the
+// same image as the last presented frame and its submission can be skipped,
+// otherwise records the frame and sets Render::PresentDamage
+auto Window::begin_present(bool will_present) -> bool
+{
+    using clock = frame_state::clock;
+
+    if (!frame_)
+        frame_ = std::make_shared<frame_state>();
+    auto& f = *frame_;
+
+    auto const now = clock::now();
+    if (f.presented && f.frame_time != clock::time_point{}) {
+        auto const dt = std::chrono::duration<double>(now - f.frame_time).count();
+        f.interval += (std::clamp(dt, 1.0 / 240.0, 1.0 / 30.0) - f.interval) * 0.1;
+    }
+    f.frame_time = now;
+    f.presented = true;
+
+    Render::PresentDamage = {};
+    auto const dd = ImGui::GetDrawData();
+    if (!SkipUnchangedFrames || !will_present || !dd || !dd->Valid || OnBeforeDraw ||
+        OnAfterDraw) {
+        f.valid = false;
+        return true;
+    }
+
+    internal::make_digest(*dd, f.next);
+    auto const same_target = f.valid && f.next.comparable &&
+                             f.resources == Render::ResourceGeneration &&
+                             same_color(f.background, Background);
+    if (same_target && f.next.hash == f.last.hash) {
+        f.presented = false;
+        return false;
+    }
+    if (same_target)
+        Render::PresentDamage = damage_pixels(internal::damage_rect(f.last, f.next), *dd);
+
+    std::swap(f.last, f.next);
+    f.valid = f.last.comparable;
+    f.resources = Render::ResourceGeneration;
+    f.background = Background;
+    return true;
+}
+
+// pace_skipped_frame waits for about one present interval, skipped frames
+// don't block on vsync and would otherwise spin the render loop (the browser
+// paces emscripten frames)
+void Window::pace_skipped_frame()
+{
+#ifndef __EMSCRIPTEN__
+    if (!frame_)
+        return;
+    auto& f = *frame_;
+    auto const until = f.frame_time + std::chrono::duration_cast<frame_state::clock::duration>(
+                                          std::chrono::duration<double>(f.interval));
+    std::this_thread::sleep_until(until);
+#endif
+}
+
 auto AllowRefreshWithinFrameScope = false;
 
 auto WithinFrame() -> bool
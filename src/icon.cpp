@@ -3,30 +3,55 @@
 
 #include <algorithm>
 #include <cmath>
+#include <implus/application.hpp>
 #include <implus/badge.hpp>
+#include <implus/draw-stats.hpp>
 #include <implus/icon.hpp>
+#include <optional>
+#include <unordered_map>
 #include <vector>
 
+#include "internal/glyph-batch.hpp"
+#include "internal/raster.hpp"
+
 namespace ImPlus {
 
-std::vector<std::pair<int, Font::Resource>> tag_map;
+// fonts registered for GlyphInfo::FontTag, small tags are indexed densely,
+// other tags (arbitrary or hashed values) are kept in a list
+static constexpr auto dense_tag_limit = 256;
+static std::vector<std::optional<Font::Resource>> tag_fonts;
+static std::vector<std::pair<int, Font::Resource>> tag_map;
 
-inline auto find_font(int tag) -> Font::Resource
+static auto find_tag_font(int tag) -> Font::Resource const*
 {
+    if (tag > 0 && tag < dense_tag_limit) {
+        if (std::size_t(tag) < tag_fonts.size() && tag_fonts[tag])
+            return &*tag_fonts[tag];
+        return nullptr;
+    }
     for (auto&& p : tag_map)
         if (p.first == tag)
-            return p.second;
-    return {};
+            return &p.second;
+    return nullptr;
 }
 
 void GlyphInfo::RegisterFontTag(int tag, Font::Resource font)
 {
+    IM_ASSERT(tag != 0 && "font tag zero stands for the current font");
+    if (tag == 0)
+        return;
+    if (tag > 0 && tag < dense_tag_limit) {
+        if (std::size_t(tag) >= tag_fonts.size())
+            tag_fonts.resize(std::size_t(tag) + 1);
+        tag_fonts[tag] = font;
+        return;
+    }
     for (auto&& p : tag_map)
         if (p.first == tag) {
             p.second = font;
             return;
         }
-    tag_map.emplace_back(std::pair{tag, font});
+    tag_map.emplace_back(tag, font);
 }
 
 Glyph::Glyph(GlyphInfo const& info)
@@ -35,14 +60,32 @@ Glyph::Glyph(GlyphInfo const& info)
         Symbol = info.Symbol;
         return;
     }
-    for (auto&& p : tag_map)
-        if (p.first == info.FontTag) {
-            Symbol = info.Symbol;
-            Font = p.second;
-            return;
-        }
+    if (auto font = find_tag_font(info.FontTag)) {
+        Symbol = info.Symbol;
+        Font = *font;
+    }
 }
 
+auto Glyph::Measure() const -> ImVec2
+{
+    auto const& g = *GImGui;
+    auto const gen = ImPlus::Font::Generation();
+    if (measured_ && measured_->generation == gen && measured_->current_font == g.Font &&
+        measured_->current_size == g.FontSize && measured_->font_id == Font.view_id)
+        return measured_->size;
+
+    auto m = measurement{gen, g.Font, g.FontSize, Font.view_id};
+    if (Font)
+        ImGui::PushFont(Font);
+    m.size = ImGui::CalcTextSize(Symbol.data(), Symbol.data() + Symbol.size());
+    if (Font)
+        ImGui::PopFont();
+    measured_ = m;
+    return m.size;
+}
+
+static constexpr auto spinner_frame_rate = 30.0;
+
 static void draw_builtin(
     ImDrawList* dl, Icon::Builtin shape, ImVec2 const& c, float size, ImU32 clr)
 {
@@ -77,8 +120,13 @@ static void draw_builtin(
         auto radius = (od - thickness) * 0.45f;
         auto num_segments = 30;
 
-        auto& g = *GImGui;
-        auto start = std::abs(std::sin(g.Time * 1.4f) * (num_segments - 5));
+        // step the animation at a fixed rate and ask for the frame of the next
+        // step, rather than redrawing at the display refresh rate
+        auto const step = 1.0 / spinner_frame_rate;
+        auto const t = std::floor(GImGui->Time / step) * step;
+        Application::RequestAnimationFrame(t + step);
+
+        auto start = std::abs(std::sin(t * 1.4f) * (num_segments - 5));
 
         const float a_min = IM_PI * 2.0f * ((float)start) / (float)num_segments;
         const float a_max = IM_PI * 2.0f * ((float)num_segments - 3) / (float)num_segments;
@@ -86,7 +134,7 @@ static void draw_builtin(
         for (int i = 0; i < num_segments; i++) {
             auto const a = a_min + ((float)i / (float)num_segments) * (a_max - a_min);
             dl->PathLineTo(
-                ImVec2(c.x + ImCos(a + g.Time * 8) * radius, c.y + ImSin(a + g.Time * 8) * radius));
+                ImVec2(c.x + ImCos(a + t * 8) * radius, c.y + ImSin(a + t * 8) * radius));
         }
 
         dl->PathStroke(clr, false, thickness);
@@ -96,6 +144,204 @@ static void draw_builtin(
     }
 }
 
+// raster cache for static builtin shapes and custom icons, baked into
+// custom rectangles of the font atlas
+
+struct raster_key {
+    bool custom = false;
+    std::size_t id = 0; // builtin shape or CustomIconData::cache_id
+    float w = 0.0f;
+    float h = 0.0f;
+    float scale = 1.0f; // framebuffer pixels per display unit
+    friend auto operator==(raster_key const&, raster_key const&) -> bool = default;
+};
+
+struct raster_key_hash {
+    auto operator()(raster_key const& k) const noexcept -> std::size_t
+    {
+        auto h = std::hash<std::size_t>{}(k.id) ^ std::size_t(k.custom);
+        h ^= std::hash<float>{}(k.w) + 0x9e3779b9 + (h << 6) + (h >> 2);
+        h ^= std::hash<float>{}(k.h) + 0x9e3779b9 + (h << 6) + (h >> 2);
+        h ^= std::hash<float>{}(k.scale) + 0x9e3779b9 + (h << 6) + (h >> 2);
+        return h;
+    }
+};
+
+using raster_proc =
+    std::function<void(ImDrawList*, ImVec2 const& bb_min, ImVec2 const& bb_max, ImU32 clr)>;
+
+struct raster_cache : public ResettableResource {
+    static constexpr int settle_frames = 30; // frames without new icons before rebuilding
+    static constexpr float max_size = 128.0f; // display units
+
+    struct entry {
+        raster_proc draw;
+        int rect_id = -1;
+        ImFontAtlas const* atlas = nullptr; // the atlas that holds the baked icon
+        ImVec2 uv0 = {0, 0};
+        ImVec2 uv1 = {0, 0};
+        ImVec2 size = {0, 0}; // quad size in display units, whole pixels
+        bool used = true;
+    };
+
+    bool enabled = false;
+    bool hooks_installed = false;
+    bool pending = false;
+    int last_new_frame = 0;
+    std::unordered_map<raster_key, entry, raster_key_hash> entries;
+    std::vector<std::uint8_t> mask;
+
+    // Reset is called after the atlas has been rebuilt, evicts icons that were
+    // not drawn since the previous rebuild
+    void Reset() override
+    {
+        std::erase_if(entries, [](auto const& kv) { return !kv.second.used; });
+        for (auto& kv : entries)
+            kv.second.used = false;
+    }
+
+    static auto pixel_size(raster_key const& k) -> ImVec2
+    {
+        return {std::ceil(k.w * k.scale), std::ceil(k.h * k.scale)};
+    }
+
+    // prepare reserves a rect for every known icon, icons are added to the
+    // atlas only while it is being rebuilt; a distance field atlas gets none,
+    // its texels are drawn as distances rather than coverage
+    void prepare(ImFontAtlas& atlas)
+    {
+        auto const distance_field = Font::DistanceFieldAtlas();
+        for (auto& [k, e] : entries) {
+            auto const px = pixel_size(k);
+            e.rect_id = distance_field ? -1 : atlas.AddCustomRectRegular(int(px.x), int(px.y));
+            e.atlas = nullptr;
+        }
+        pending = false;
+    }
+
+    // bake rasterizes the icons into their rects at framebuffer pixel size
+    void bake(ImFontAtlas& atlas)
+    {
+        if (entries.empty() || (!atlas.TexPixelsAlpha8 && !atlas.TexPixelsRGBA32))
+            return;
+
+        auto dl = ImDrawList{ImGui::GetDrawListSharedData()};
+        for (auto& [k, e] : entries) {
+            auto const r = e.rect_id >= 0 ? atlas.GetCustomRectByIndex(e.rect_id) : nullptr;
+            if (!r || !r->IsPacked() || !e.draw)
+                continue;
+
+            auto const w = int(r->Width);
+            auto const h = int(r->Height);
+
+            // the icon is drawn in display units and scaled to pixels
+            dl._ResetForNewFrame();
+            dl.PushClipRect({0, 0}, {k.w, k.h});
+            dl.PushTextureID(atlas.TexID);
+            e.draw(&dl, {0, 0}, {k.w, k.h}, IM_COL32_WHITE);
+            for (auto& v : dl.VtxBuffer)
+                v.pos = v.pos * k.scale;
+            for (auto& cmd : dl.CmdBuffer) {
+                auto& c = cmd.ClipRect;
+                c = {c.x * k.scale, c.y * k.scale, c.z * k.scale, c.w * k.scale};
+            }
+
+            mask.assign(std::size_t(w * h), 0);
+            internal::rasterize_coverage(dl, w, h, mask.data(), w);
+
+            // white texels with coverage alpha, tinted through the vertex color
+            for (auto y = 0; y < h; ++y) {
+                auto const src = mask.data() + std::size_t(y) * w;
+                auto const offset = std::size_t(r->Y + y) * atlas.TexWidth + r->X;
+                if (atlas.TexPixelsAlpha8)
+                    std::copy(src, src + w, atlas.TexPixelsAlpha8 + offset);
+                if (atlas.TexPixelsRGBA32)
+                    for (auto x = 0; x < w; ++x)
+                        atlas.TexPixelsRGBA32[offset + x] = IM_COL32(255, 255, 255, src[x]);
+            }
+
+            atlas.CalcCustomRectUV(r, &e.uv0, &e.uv1);
+            e.size = ImVec2{float(w), float(h)} / k.scale;
+            e.atlas = &atlas;
+        }
+        dl._ClearFreeMemory();
+    }
+
+    void install_hooks()
+    {
+        if (hooks_installed)
+            return;
+        hooks_installed = true;
+        Font::OnAtlasPrepare.push_back([this](ImFontAtlas& atlas) {
+            if (enabled)
+                prepare(atlas);
+        });
+        Font::OnAtlasBuilt.push_back([this](ImFontAtlas& atlas) {
+            if (enabled)
+                bake(atlas);
+        });
+    }
+
+    // draw renders a baked icon as a quad of the font texture with its origin
+    // snapped to the framebuffer pixel grid, so it batches with text; returns
+    // false if the icon is not in the current atlas yet or the atlas holds
+    // distance fields (the caller draws it as geometry)
+    template <typename Proc>
+    auto draw(ImDrawList* dl, raster_key k, ImVec2 const& pos, ImU32 clr, Proc&& proc) -> bool
+    {
+        if (!enabled || k.w <= 0.0f || k.h <= 0.0f || k.w > max_size || k.h > max_size)
+            return false;
+        if (Font::DistanceFieldAtlas())
+            return false;
+
+        auto const& io = ImGui::GetIO();
+        auto const frame = ImGui::GetFrameCount();
+        k.scale = io.DisplayFramebufferScale.x > 0.0f ? io.DisplayFramebufferScale.x : 1.0f;
+
+        auto it = entries.find(k);
+        if (it == entries.end()) {
+            it = entries.emplace(k, entry{.draw = raster_proc{std::forward<Proc>(proc)}}).first;
+            last_new_frame = frame;
+        }
+
+        auto& e = it->second;
+        e.used = true;
+
+        auto const baked = e.atlas == io.Fonts;
+        if (baked) {
+            auto const p =
+                ImVec2{std::round(pos.x * k.scale), std::round(pos.y * k.scale)} / k.scale;
+            dl->AddImage(io.Fonts->TexID, p, p + e.size, e.uv0, e.uv1, clr);
+        }
+        else
+            pending = true;
+
+        // the icons are baked at the next rebuild, which is requested once the
+        // set of icons has settled
+        if (pending && frame - last_new_frame > settle_frames) {
+            pending = false;
+            Font::RequestRebuild();
+        }
+        return baked;
+    }
+};
+
+static auto raster = raster_cache{};
+
+void Icon::EnableRasterCache(bool enable)
+{
+    raster.enabled = enable;
+    if (enable)
+        raster.install_hooks();
+    else
+        raster.entries.clear();
+}
+
+static auto builtin_raster_key(Icon::Builtin shape, float size) -> raster_key
+{
+    return raster_key{.custom = false, .id = std::size_t(shape), .w = size, .h = size};
+}
+
 auto Icon::Placeholder(length const& width, length const& height) -> CustomIconData
 {
     return CustomIconData{
@@ -109,6 +355,7 @@ auto Icon::Placeholder(length const& width, length const& height) -> CustomIconD
                 dl->AddLine(tl, br, clr);
                 dl->AddLine({tl.x, br.y - 1}, {br.x, tl.y - 1}, clr);
             },
+        .cache_id = ImHashStr("implus-icon-placeholder"),
     };
 }
 
@@ -118,12 +365,7 @@ auto Icon::Measure() const -> ImVec2
         return {0, 0};
     }
     else if (auto v = std::get_if<Glyph>(&content_)) {
-        if (v->Font)
-            ImGui::PushFont(v->Font);
-        auto sz = ImGui::CalcTextSize(v->Symbol.data(), v->Symbol.data() + v->Symbol.size());
-        if (v->Font)
-            ImGui::PopFont();
-        return sz * v->FontScale;
+        return v->Measure() * v->FontScale;
     }
     else if (auto p = std::get_if<builtin_content>(&content_)) {
         auto h = to_pt(p->size);
@@ -148,28 +390,56 @@ auto Icon::Measure() const -> ImVec2
     }
 }
 
+// glyph_font returns the font of a glyph, the current font if it has none
+static auto glyph_font(ImDrawList const* dl, Glyph const& v) -> ImFont&
+{
+    if (auto font = v.Font ? v.Font.imfont() : nullptr)
+        return *font;
+    return *dl->_Data->Font;
+}
+
+// glyph_font_size returns the size the font would have if it was pushed,
+// without the font stack round-trip
+static auto glyph_font_size(ImDrawList const* dl, ImFont const& font) -> float
+{
+    auto const& current = *dl->_Data->Font;
+    if (&font == &current)
+        return dl->_Data->FontSize;
+    return dl->_Data->FontSize * (font.FontSize * font.Scale) / (current.FontSize * current.Scale);
+}
+
 void Icon::Draw(ImDrawList* dl, ImVec2 const& pos, ImU32 clr) const
 {
-    auto sz = ImVec2{};
+    IMPLUS_DRAW_SCOPE("icon", dl);
 
-    if (std::holds_alternative<std::monostate>(content_)) {
+    if (std::holds_alternative<std::monostate>(content_))
         return;
-    }
-    else if (auto v = std::get_if<Glyph>(&content_)) {
-        if (v->Font)
-            ImGui::PushFont(v->Font);
+
+    // the glyph and the glyph overlays share one reservation, flushed before
+    // anything else is drawn
+    auto glyphs = internal::glyph_batch{dl};
+    auto sz = ImVec2{};
+
+    if (auto v = std::get_if<Glyph>(&content_)) {
+        sz = v->Measure() * v->FontScale;
         auto const c = v->Color ? ImGui::GetColorU32(*v->Color) : clr;
-        sz = ImGui::CalcTextSize(v->Symbol.data(), v->Symbol.data() + v->Symbol.size());
-        sz *= v->FontScale;
-        dl->AddText(nullptr, dl->_Data->FontSize * v->FontScale, pos, c, v->Symbol.data(),
-            v->Symbol.data() + v->Symbol.size());
-        if (v->Font)
-            ImGui::PopFont();
+        auto& font = glyph_font(dl, *v);
+        glyphs.add_text(font, glyph_font_size(dl, font) * v->FontScale, pos, c, v->Symbol);
     }
     else if (auto p = std::get_if<builtin_content>(&content_)) {
         auto h = to_pt(p->size);
         sz = {h, h};
-        draw_builtin(dl, p->shape, {pos.x + h * 0.5f, pos.y + h * 0.5f}, h, clr);
+        auto const shape = p->shape;
+        auto const baked = shape != Builtin::Spinner &&
+                           raster.draw(dl, builtin_raster_key(shape, h), pos, clr,
+                               [shape](ImDrawList* dl, ImVec2 const& bb_min, ImVec2 const& bb_max,
+                                   ImU32 clr) {
+                                   auto const h = bb_max.x - bb_min.x;
+                                   draw_builtin(dl, shape,
+                                       {bb_min.x + h * 0.5f, bb_min.y + h * 0.5f}, h, clr);
+                               });
+        if (!baked)
+            draw_builtin(dl, shape, {pos.x + h * 0.5f, pos.y + h * 0.5f}, h, clr);
     }
     else if (auto p = std::get_if<CustomIconData>(&content_)) {
         sz = ImVec2{to_pt(p->width), to_pt(p->height)};
@@ -177,7 +447,10 @@ void Icon::Draw(ImDrawList* dl, ImVec2 const& pos, ImU32 clr) const
             sz.x = sz.y;
         else if (!sz.y)
             sz.y = sz.x;
-        if (p->on_draw)
+        auto const baked = p->cache_id && p->on_draw &&
+                           raster.draw(dl, raster_key{true, p->cache_id, sz.x, sz.y}, pos, clr,
+                               p->on_draw);
+        if (!baked && p->on_draw)
             p->on_draw(dl, pos, pos + sz, clr);
     }
     else if (auto p = std::get_if<GraphicalResource*>(&content_)) {
@@ -189,15 +462,12 @@ void Icon::Draw(ImDrawList* dl, ImVec2 const& pos, ImU32 clr) const
 
     for (auto const& overlay : overlays_) {
         if (auto v = std::get_if<Glyph>(&overlay)) {
-            if (v->Font)
-                ImGui::PushFont(v->Font);
             auto const c = v->Color ? ImGui::GetColorU32(*v->Color) : clr;
-            dl->AddText(
-                nullptr, 0.0f, pos, c, v->Symbol.data(), v->Symbol.data() + v->Symbol.size());
-            if (v->Font)
-                ImGui::PopFont();
+            auto& font = glyph_font(dl, *v);
+            glyphs.add_text(font, glyph_font_size(dl, font), pos, c, v->Symbol);
         }
         else if (auto v = std::get_if<IconBadge>(&overlay)) {
+            glyphs.flush();
             ImPlus::Badge::Render(dl, pos + sz, v->Content,
                 ImPlus::Badge::Options{
                     .Font = v->Font,
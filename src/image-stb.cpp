@@ -0,0 +1,35 @@
+#include "internal/image-decode.hpp"
+
+#include <climits>
+#include <cstring>
+
+#define STB_IMAGE_IMPLEMENTATION
+#define STBI_NO_STDIO
+#define STBI_NO_HDR
+#define STBI_NO_LINEAR
+#define STBI_NO_PIC
+#define STBI_NO_PNM
+#include <stb_image.h>
+
+namespace ImPlus::internal {
+
+auto decode_stb_image(std::span<std::uint8_t const> encoded) -> TextureImage::Pixels
+{
+    if (encoded.empty() || encoded.size() > std::size_t(INT_MAX))
+        return {};
+
+    auto w = 0;
+    auto h = 0;
+    auto channels = 0;
+    auto data = stbi_load_from_memory(encoded.data(), int(encoded.size()), &w, &h, &channels, 4);
+    if (!data)
+        return {};
+
+    auto px = TextureImage::Pixels{.Width = w, .Height = h};
+    px.RGBA.resize(std::size_t(w) * h * 4);
+    std::memcpy(px.RGBA.data(), data, px.RGBA.size());
+    stbi_image_free(data);
+    return px;
+}
+
+} // namespace ImPlus::internal
@@ -0,0 +1,317 @@
+#include <implus/image.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <list>
+#include <mutex>
+#include <thread>
+
+#include "internal/image-decode.hpp"
+#include "internal/texture-pool.hpp"
+
+namespace ImPlus {
+
+namespace internal {
+
+enum class image_state {
+    idle,     // not decoded, or evicted
+    decoding, // queued or on a worker
+    decoded,  // pixels ready for upload
+    uploaded,
+    failed,
+};
+
+struct texture_image {
+    std::string path;
+    std::vector<std::uint8_t> encoded;
+    std::atomic<image_state> state = image_state::idle;
+    std::atomic<bool> cancelled = false;
+    TextureImage::Pixels pixels; // handed over by the worker with image_state::decoded
+
+    // main thread only
+    ImTextureID texture = {};
+    int width = 0;
+    int height = 0;
+    int last_frame = -1;
+    std::list<texture_image*>::iterator lru;
+};
+
+} // namespace internal
+
+using internal::image_state;
+using internal::texture_image;
+
+static auto default_decoder() -> TextureImage::Decoder
+{
+#ifdef IMPLUS_ENABLE_STB_IMAGE
+    return internal::decode_stb_image;
+#else
+    return {};
+#endif
+}
+
+static auto read_file(std::string const& path) -> std::vector<std::uint8_t>
+{
+    auto const p = std::filesystem::path{std::u8string{path.begin(), path.end()}};
+    auto f = std::ifstream{p, std::ios::binary};
+    if (!f)
+        return {};
+    return {std::istreambuf_iterator<char>{f}, std::istreambuf_iterator<char>{}};
+}
+
+static void decode(texture_image& img, TextureImage::Decoder const& decoder)
+{
+    if (img.cancelled)
+        return;
+
+    auto px = TextureImage::Pixels{};
+    try {
+        if (img.path.empty())
+            px = decoder(img.encoded);
+        else if (auto bytes = read_file(img.path); !bytes.empty())
+            px = decoder(bytes);
+    }
+    catch (...) {
+        px = {};
+    }
+
+    auto const valid = px.Width > 0 && px.Height > 0 &&
+                       px.RGBA.size() >= std::size_t(px.Width) * px.Height * 4;
+    if (valid)
+        img.pixels = std::move(px);
+    img.state = valid ? image_state::decoded : image_state::failed;
+}
+
+// decode_queue runs decoding jobs on a few worker threads, the most recently
+// queued job first so that newly visible images are decoded before the ones
+// that were scrolled past
+struct decode_queue {
+    using job = std::pair<std::shared_ptr<texture_image>, TextureImage::Decoder>;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<job> jobs;
+    std::vector<std::thread> threads;
+    bool stop = false;
+
+    ~decode_queue()
+    {
+        {
+            auto lock = std::scoped_lock{mutex};
+            stop = true;
+            jobs.clear();
+        }
+        cv.notify_all();
+        for (auto& t : threads)
+            t.join();
+    }
+
+    void push(std::shared_ptr<texture_image> img, TextureImage::Decoder decoder)
+    {
+        {
+            auto lock = std::scoped_lock{mutex};
+            jobs.emplace_front(std::move(img), std::move(decoder));
+            if (threads.empty()) {
+                auto const n = std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u);
+                for (auto i = 0u; i < n; ++i)
+                    threads.emplace_back([this] { run(); });
+            }
+        }
+        cv.notify_one();
+    }
+
+    void run()
+    {
+        while (true) {
+            auto lock = std::unique_lock{mutex};
+            cv.wait(lock, [this] { return stop || !jobs.empty(); });
+            if (stop)
+                return;
+            auto j = std::move(jobs.front());
+            jobs.pop_front();
+            lock.unlock();
+            decode(*j.first, j.second);
+        }
+    }
+};
+
+// texture_cache tracks the uploaded images of the main thread, their textures
+// come from the texture pool and are dropped with the renderer
+struct texture_cache : public internal::texture_owner {
+    static constexpr auto upload_bytes_per_frame = std::size_t{8} << 20;
+
+    TextureImage::Decoder decoder = default_decoder();
+    std::size_t budget = std::size_t{64} << 20;
+    std::size_t usage = 0;
+    std::list<texture_image*> lru; // most recently drawn first
+    int upload_frame = -1;
+    std::size_t uploaded_bytes = 0; // in upload_frame
+
+    static auto bytes_of(int w, int h) -> std::size_t { return std::size_t(w) * h * 4; }
+
+    void release(texture_image& img)
+    {
+        internal::destroy_texture(img.texture);
+        img.texture = {};
+        usage -= bytes_of(img.width, img.height);
+        lru.erase(img.lru);
+        img.state = image_state::idle;
+    }
+
+    // make_room evicts images that were not drawn in this frame, a single
+    // image may exceed the budget
+    auto make_room(std::size_t bytes) -> bool
+    {
+        auto const frame = ImGui::GetFrameCount();
+        while (usage + bytes > budget && !lru.empty() && lru.back()->last_frame != frame)
+            release(*lru.back());
+        return usage + bytes <= budget || usage == 0;
+    }
+
+    auto upload(texture_image& img) -> bool
+    {
+        auto const frame = ImGui::GetFrameCount();
+        if (upload_frame != frame) {
+            upload_frame = frame;
+            uploaded_bytes = 0;
+        }
+
+        auto const bytes = bytes_of(img.pixels.Width, img.pixels.Height);
+        if (uploaded_bytes && uploaded_bytes + bytes > upload_bytes_per_frame)
+            return false;
+        if (!make_room(bytes))
+            return false;
+
+        // without a renderer the pixels are kept and uploaded later
+        img.texture = internal::create_texture(
+            *this, img.pixels.Width, img.pixels.Height, img.pixels.RGBA.data());
+        if (!img.texture)
+            return false;
+        img.pixels = {};
+        usage += bytes;
+        uploaded_bytes += bytes;
+        lru.push_front(&img);
+        img.lru = lru.begin();
+        img.state = image_state::uploaded;
+        return true;
+    }
+
+    void touch(texture_image& img) { lru.splice(lru.begin(), lru, img.lru); }
+
+    // the uploaded images are decoded again when they are drawn next time
+    void textures_released() override
+    {
+        for (auto img : lru) {
+            img->texture = {};
+            img->state = image_state::idle;
+        }
+        lru.clear();
+        usage = 0;
+    }
+};
+
+static auto queue = decode_queue{};
+
+// the cache is created on first use and never destroyed, TextureImage objects
+// with static storage may be created before and destroyed after it
+static auto textures() -> texture_cache&
+{
+    static auto& cache = *new texture_cache{};
+    return cache;
+}
+
+TextureImage::TextureImage(std::string path, length width, length height)
+    : data_{std::make_shared<texture_image>()}
+    , width_{width}
+    , height_{height}
+{
+    data_->path = std::move(path);
+}
+
+TextureImage::TextureImage(std::vector<std::uint8_t> encoded, length width, length height)
+    : data_{std::make_shared<texture_image>()}
+    , width_{width}
+    , height_{height}
+{
+    data_->encoded = std::move(encoded);
+}
+
+TextureImage::~TextureImage()
+{
+    data_->cancelled = true;
+    if (data_->state == image_state::uploaded)
+        textures().release(*data_);
+}
+
+auto TextureImage::GetSize() -> ImVec2
+{
+    auto const& img = *data_;
+    auto w = to_pt(width_);
+    auto h = to_pt(height_);
+    auto const known = img.width > 0 && img.height > 0;
+    if (w <= 0.0f && h <= 0.0f)
+        return known ? ImVec2{float(img.width), float(img.height)} : ImVec2{0, 0};
+
+    auto const aspect = known ? float(img.width) / float(img.height) : 1.0f;
+    if (w <= 0.0f)
+        w = h * aspect;
+    else if (h <= 0.0f)
+        h = w / aspect;
+    return {w, h};
+}
+
+void TextureImage::Render(ImDrawList* dl, ImVec2 const& xy, ImU32 clr)
+{
+    auto& img = *data_;
+    img.last_frame = ImGui::GetFrameCount();
+
+    switch (img.state.load()) {
+    case image_state::idle:
+        if (textures().decoder) {
+            img.state = image_state::decoding;
+            queue.push(data_, textures().decoder);
+        }
+        else {
+            img.state = image_state::failed;
+        }
+        break;
+
+    case image_state::decoded:
+        img.width = img.pixels.Width;
+        img.height = img.pixels.Height;
+        textures().upload(img);
+        break;
+
+    case image_state::uploaded: textures().touch(img); break;
+
+    default: break;
+    }
+
+    auto const sz = GetSize();
+    auto const bb_max = ImVec2{xy.x + sz.x, xy.y + sz.y};
+    if (img.state == image_state::uploaded) {
+        auto const tint = (clr & IM_COL32_A_MASK) | (IM_COL32_WHITE & ~IM_COL32_A_MASK);
+        dl->AddImage(img.texture, xy, bb_max, {0, 0}, {1, 1}, tint);
+    }
+    else {
+        static auto const placeholder = Icon::Placeholder(0_pt, 0_pt).on_draw;
+        placeholder(dl, xy, bb_max, clr);
+    }
+}
+
+auto TextureImage::IsReady() const -> bool { return data_->state == image_state::uploaded; }
+
+auto TextureImage::IsFailed() const -> bool { return data_->state == image_state::failed; }
+
+void TextureImage::SetDecoder(Decoder decoder) { textures().decoder = std::move(decoder); }
+
+void TextureImage::SetTextureBudget(std::size_t bytes) { textures().budget = bytes; }
+
+auto TextureImage::TextureMemoryUsage() -> std::size_t { return textures().usage; }
+
+} // namespace ImPlus
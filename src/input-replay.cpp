@@ -0,0 +1,432 @@
+#include <implus/input-replay.hpp>
+
+#include <implus/alloc-tracker.hpp>
+#include <implus/application.hpp>
+
+#include <imgui.h>
+#include <imgui_internal.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+// The log is a header followed by tagged records in native byte order, each
+// frame starts with a frame record and holds the records of the display size
+// and content scale only when they change:
+//
+//     "IMPLUSIN" u32 version
+//     frame        f32 delta_time
+//     display      f32 width, height, fb_scale_x, fb_scale_y
+//     scale        f32 dpi, fb_scale
+//     mouse_pos    f32 x, y, u8 source
+//     mouse_wheel  f32 x, y, u8 source
+//     mouse_button u8 button, down, source
+//     key          u16 key, u8 down, f32 analog_value
+//     text         u32 char
+//     focus        u8 focused
+
+namespace ImPlus::InputReplay {
+
+namespace {
+
+enum tag : std::uint8_t {
+    tag_frame = 1,
+    tag_display,
+    tag_scale,
+    tag_mouse_pos,
+    tag_mouse_wheel,
+    tag_mouse_button,
+    tag_key,
+    tag_text,
+    tag_focus,
+    tag_count,
+};
+
+constexpr std::size_t payload_size[tag_count] = {0, 4, 16, 8, 9, 9, 3, 7, 4, 1};
+
+constexpr char magic[8] = {'I', 'M', 'P', 'L', 'U', 'S', 'I', 'N'};
+constexpr std::uint32_t version = 1;
+constexpr auto header_size = sizeof(magic) + sizeof(version);
+
+using clock = std::chrono::steady_clock;
+
+struct display {
+    ImVec2 size;
+    ImVec2 fb_scale;
+};
+
+} // namespace
+
+// recording
+static auto rec_file = static_cast<std::FILE*>(nullptr);
+static auto rec_buffer = std::vector<std::uint8_t>{};
+static auto rec_display = std::optional<display>{};
+static auto rec_scale = std::optional<Host::Window::Scale>{};
+static auto rec_next_event = ImU32{0}; // first event not recorded yet
+
+// replay
+static auto log_data = std::vector<std::uint8_t>{};
+static auto log_pos = std::size_t{0};
+static auto replaying = false;
+static auto options = ReplayOptions{};
+static auto replay_display = std::optional<display>{};
+static auto replay_scale = std::optional<Host::Window::Scale>{};
+static auto replay_next_event = ImU32{0}; // events from this id are host input
+static auto frame_open = false;
+static auto frame_start = clock::time_point{};
+static auto traces = std::vector<FrameTrace>{};
+static auto trace_path = std::string{}; // from IMPLUS_REPLAY_TRACE
+
+template <typename T> static void put(T const& v)
+{
+    auto const p = reinterpret_cast<std::uint8_t const*>(&v);
+    rec_buffer.insert(rec_buffer.end(), p, p + sizeof(T));
+}
+
+template <typename T> static auto get(std::uint8_t const*& p) -> T
+{
+    auto v = T{};
+    std::memcpy(&v, p, sizeof(T));
+    p += sizeof(T);
+    return v;
+}
+
+void StartRecording(char const* path)
+{
+    StopRecording();
+    rec_file = std::fopen(path, "wb");
+    if (!rec_file)
+        throw std::runtime_error(std::string{"failed to create input log "} + path);
+
+    rec_buffer.clear();
+    rec_buffer.insert(rec_buffer.end(), std::begin(magic), std::end(magic));
+    put(version);
+    std::fwrite(rec_buffer.data(), 1, rec_buffer.size(), rec_file);
+
+    rec_display.reset();
+    rec_scale.reset();
+    rec_next_event = 0;
+}
+
+void StopRecording()
+{
+    if (rec_file)
+        std::fclose(rec_file);
+    rec_file = nullptr;
+}
+
+auto IsRecording() -> bool { return rec_file != nullptr; }
+
+static void record_frame(Host::Window& w)
+{
+    auto& g = *GImGui;
+    auto const& io = g.IO;
+
+    rec_buffer.clear();
+    put(tag_frame);
+    put(io.DeltaTime);
+
+    auto const d = display{io.DisplaySize, io.DisplayFramebufferScale};
+    if (!rec_display || std::memcmp(&*rec_display, &d, sizeof(d)) != 0) {
+        put(tag_display);
+        put(d.size.x);
+        put(d.size.y);
+        put(d.fb_scale.x);
+        put(d.fb_scale.y);
+        rec_display = d;
+    }
+
+    auto const s = w.ContentScale();
+    if (!rec_scale || rec_scale->dpi != s.dpi || rec_scale->fb_scale != s.fb_scale) {
+        put(tag_scale);
+        put(s.dpi);
+        put(s.fb_scale);
+        rec_scale = s;
+    }
+
+    for (auto const& e : g.InputEventsQueue) {
+        // events trickled to the next frame are still queued
+        if (e.EventId < rec_next_event)
+            continue;
+
+        switch (e.Type) {
+        case ImGuiInputEventType_MousePos:
+            put(tag_mouse_pos);
+            put(e.MousePos.PosX);
+            put(e.MousePos.PosY);
+            put(std::uint8_t(e.MousePos.MouseSource));
+            break;
+        case ImGuiInputEventType_MouseWheel:
+            put(tag_mouse_wheel);
+            put(e.MouseWheel.WheelX);
+            put(e.MouseWheel.WheelY);
+            put(std::uint8_t(e.MouseWheel.MouseSource));
+            break;
+        case ImGuiInputEventType_MouseButton:
+            put(tag_mouse_button);
+            put(std::uint8_t(e.MouseButton.Button));
+            put(std::uint8_t(e.MouseButton.Down));
+            put(std::uint8_t(e.MouseButton.MouseSource));
+            break;
+        case ImGuiInputEventType_Key:
+            put(tag_key);
+            put(std::uint16_t(e.Key.Key));
+            put(std::uint8_t(e.Key.Down));
+            put(e.Key.AnalogValue);
+            break;
+        case ImGuiInputEventType_Text:
+            put(tag_text);
+            put(std::uint32_t(e.Text.Char));
+            break;
+        case ImGuiInputEventType_Focus:
+            put(tag_focus);
+            put(std::uint8_t(e.AppFocused.Focused));
+            break;
+        default:
+            break;
+        }
+    }
+    rec_next_event = g.InputEventsNextEventId;
+
+    std::fwrite(rec_buffer.data(), 1, rec_buffer.size(), rec_file);
+    std::fflush(rec_file); // keep the log usable if the process is killed
+}
+
+// next_record returns the tag of the record at log_pos or 0 at the end of the
+// log, throws if the record is truncated or unknown
+static auto next_record(std::size_t pos) -> std::uint8_t
+{
+    if (pos >= log_data.size())
+        return 0;
+    auto const t = log_data[pos];
+    if (t == 0 || t >= tag_count || pos + 1 + payload_size[t] > log_data.size())
+        throw std::runtime_error("corrupted input log");
+    return t;
+}
+
+static auto payload(std::size_t pos) -> std::uint8_t const* { return log_data.data() + pos + 1; }
+
+void StartReplay(char const* path, ReplayOptions const& opts)
+{
+    StopReplay();
+
+    auto f = std::fopen(path, "rb");
+    if (!f)
+        throw std::runtime_error(std::string{"failed to open input log "} + path);
+    auto data = std::vector<std::uint8_t>{};
+    std::uint8_t chunk[4096];
+    for (std::size_t n; (n = std::fread(chunk, 1, sizeof(chunk), f)) > 0;)
+        data.insert(data.end(), chunk, chunk + n);
+    std::fclose(f);
+
+    auto v = std::uint32_t{0};
+    if (data.size() >= header_size)
+        std::memcpy(&v, data.data() + sizeof(magic), sizeof(v));
+    if (data.size() < header_size || std::memcmp(data.data(), magic, sizeof(magic)) != 0 ||
+        v != version)
+        throw std::runtime_error(std::string{path} + " is not an input log");
+
+    log_data = std::move(data);
+    log_pos = header_size;
+    options = opts;
+    replay_display.reset();
+    replay_scale.reset();
+    replay_next_event = 0;
+    frame_open = false;
+
+    // reserve the traces so that the replay does not allocate for them
+    auto frames = std::size_t{0};
+    for (auto pos = log_pos; auto t = next_record(pos); pos += 1 + payload_size[t])
+        frames += t == tag_frame;
+    traces.clear();
+    traces.reserve(frames);
+
+    replaying = true;
+}
+
+void StopReplay()
+{
+    replaying = false;
+    frame_open = false;
+    log_data.clear();
+    log_pos = 0;
+}
+
+auto IsReplaying() -> bool { return replaying; }
+
+auto Traces() -> std::vector<FrameTrace> const& { return traces; }
+
+void WriteTraces(char const* path)
+{
+    auto f = std::fopen(path, "w");
+    if (!f)
+        throw std::runtime_error(std::string{"failed to create trace "} + path);
+    std::fprintf(f, "frame,ms,allocations,bytes\n");
+    for (auto const& t : traces)
+        std::fprintf(f, "%d,%.4f,%zu,%zu\n", t.Frame, t.Milliseconds, t.Allocations, t.Bytes);
+    std::fclose(f);
+}
+
+auto ContentScale() -> std::optional<Host::Window::Scale>
+{
+    if (!replaying)
+        return std::nullopt;
+
+    // the scale of the next frame, recorded only when it changes
+    auto ret = replay_scale;
+    auto pos = log_pos;
+    for (auto t = next_record(pos); t; pos += 1 + payload_size[t], t = next_record(pos)) {
+        if (t == tag_frame && pos != log_pos)
+            break;
+        if (t == tag_scale) {
+            auto p = payload(pos);
+            auto const dpi = get<float>(p);
+            ret = Host::Window::Scale{dpi, get<float>(p)};
+        }
+    }
+    return ret;
+}
+
+static void finish_replay(Host::Window& w)
+{
+    StopReplay();
+    if (options.CloseWhenDone)
+        w.SetShouldClose(true);
+    if (!trace_path.empty())
+        WriteTraces(trace_path.c_str());
+}
+
+static void replay_frame(Host::Window& w)
+{
+    auto& g = *GImGui;
+    auto& io = g.IO;
+
+    // drop the host input, events of replayed frames may still be queued when
+    // io.ConfigInputTrickleEventQueue defers them
+    for (auto i = g.InputEventsQueue.Size - 1; i >= 0; --i)
+        if (g.InputEventsQueue[i].EventId >= replay_next_event)
+            g.InputEventsQueue.erase(g.InputEventsQueue.Data + i);
+
+    if (next_record(log_pos) != tag_frame) {
+        finish_replay(w);
+        return;
+    }
+
+    auto p = payload(log_pos);
+    auto const delta_time = get<float>(p);
+    log_pos += 1 + payload_size[tag_frame];
+
+    for (auto t = next_record(log_pos); t && t != tag_frame; t = next_record(log_pos)) {
+        p = payload(log_pos);
+        log_pos += 1 + payload_size[t];
+
+        switch (t) {
+        case tag_display: {
+            auto d = display{};
+            d.size.x = get<float>(p);
+            d.size.y = get<float>(p);
+            d.fb_scale.x = get<float>(p);
+            d.fb_scale.y = get<float>(p);
+            replay_display = d;
+            break;
+        }
+        case tag_scale: {
+            auto const dpi = get<float>(p);
+            replay_scale = Host::Window::Scale{dpi, get<float>(p)};
+            break;
+        }
+        case tag_mouse_pos:
+        case tag_mouse_wheel: {
+            auto const x = get<float>(p);
+            auto const y = get<float>(p);
+            io.AddMouseSourceEvent(ImGuiMouseSource(get<std::uint8_t>(p)));
+            if (t == tag_mouse_pos)
+                io.AddMousePosEvent(x, y);
+            else
+                io.AddMouseWheelEvent(x, y);
+            break;
+        }
+        case tag_mouse_button: {
+            auto const button = get<std::uint8_t>(p);
+            auto const down = get<std::uint8_t>(p) != 0;
+            io.AddMouseSourceEvent(ImGuiMouseSource(get<std::uint8_t>(p)));
+            io.AddMouseButtonEvent(button, down);
+            break;
+        }
+        case tag_key: {
+            auto const key = ImGuiKey(get<std::uint16_t>(p));
+            auto const down = get<std::uint8_t>(p) != 0;
+            io.AddKeyAnalogEvent(key, down, get<float>(p));
+            break;
+        }
+        case tag_text:
+            io.AddInputCharacter(get<std::uint32_t>(p));
+            break;
+        case tag_focus:
+            io.AddFocusEvent(get<std::uint8_t>(p) != 0);
+            break;
+        default:
+            break;
+        }
+    }
+    replay_next_event = g.InputEventsNextEventId;
+
+    io.DeltaTime = options.TimeStep > 0.0 ? float(options.TimeStep) : delta_time;
+    if (replay_display) {
+        io.DisplaySize = replay_display->size;
+        io.DisplayFramebufferScale = replay_display->fb_scale;
+    }
+
+    frame_open = true;
+    frame_start = clock::now();
+}
+
+static void start_from_environment()
+{
+    if (auto path = std::getenv("IMPLUS_REPLAY_INPUT")) {
+        if (auto trace = std::getenv("IMPLUS_REPLAY_TRACE"))
+            trace_path = trace;
+        StartReplay(path, {.CloseWhenDone = true});
+    }
+    else if (auto path = std::getenv("IMPLUS_RECORD_INPUT")) {
+        StartRecording(path);
+    }
+}
+
+void NewFrame(Host::Window& w)
+{
+    static auto const once = (start_from_environment(), true);
+    static_cast<void>(once);
+
+    if (replaying)
+        replay_frame(w);
+    else if (rec_file)
+        record_frame(w);
+}
+
+void EndFrame()
+{
+    if (!frame_open)
+        return;
+    frame_open = false;
+
+    auto t = FrameTrace{};
+    t.Frame = int(traces.size());
+    t.Milliseconds = std::chrono::duration<double, std::milli>(clock::now() - frame_start).count();
+#ifdef IMPLUS_ENABLE_ALLOC_TRACKING
+    auto const allocs = AllocTracker::LastFrame();
+    t.Allocations = allocs.Allocations;
+    t.Bytes = allocs.Bytes;
+#endif
+    traces.push_back(t);
+
+    // replayed frames run back to back
+    Application::RequestRedraw();
+}
+
+} // namespace ImPlus::InputReplay
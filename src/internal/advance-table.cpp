@@ -0,0 +1,78 @@
+#include <imgui_internal.h>
+
+#include "advance-table.hpp"
+#include "implus/font.hpp"
+
+#include <memory>
+#include <unordered_map>
+
+namespace ImPlus::internal {
+
+advance_table::advance_table(ImFont const& font)
+    : fallback_{font.FallbackAdvanceX}
+{
+    pages_.front().fill(fallback_);
+
+    for (auto const& g : font.Glyphs) {
+        auto const c = unsigned(g.Codepoint);
+        if (c > max_codepoint)
+            continue;
+        auto& index = directory_[c >> page_bits];
+        if (!index) {
+            index = std::uint16_t(pages_.size());
+            pages_.push_back(pages_.front());
+        }
+        pages_[index][c & (page_size - 1)] = g.AdvanceX;
+    }
+}
+
+struct cached_table {
+    int glyph_count = 0;
+    std::unique_ptr<advance_table> table;
+};
+
+auto advance_table_of(ImFont const& font) -> advance_table const&
+{
+    static auto cache = std::unordered_map<ImFont const*, cached_table>{};
+    static auto cache_generation = std::size_t{0};
+    static ImFont const* last_font = nullptr;
+    static cached_table* last_entry = nullptr;
+
+    // a new atlas replaces all fonts, their addresses may be reused by the
+    // fonts of the next one
+    if (auto const gen = Font::Generation(); gen != cache_generation) {
+        cache.clear();
+        cache_generation = gen;
+        last_font = nullptr;
+        last_entry = nullptr;
+    }
+
+    auto entry = last_entry;
+    if (&font != last_font) {
+        entry = &cache[&font];
+        last_font = &font;
+        last_entry = entry;
+    }
+
+    if (!entry->table || entry->glyph_count != font.Glyphs.Size) {
+        entry->table = std::make_unique<advance_table>(font);
+        entry->glyph_count = font.Glyphs.Size;
+    }
+    return *entry->table;
+}
+
+auto measure_advance(ImFont const& font, float font_size, std::string_view s) -> float
+{
+    auto const& advance = advance_table_of(font);
+    auto w = 0.0f;
+    auto curr = s.data();
+    auto const last = curr + s.size();
+    while (curr < last) {
+        auto c = static_cast<unsigned int>(static_cast<unsigned char>(*curr));
+        curr += c < 0x80 ? 1 : ImTextCharFromUtf8(&c, curr, last);
+        w += advance(c);
+    }
+    return w * font_size / font.FontSize;
+}
+
+} // namespace ImPlus::internal
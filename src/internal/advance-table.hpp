@@ -0,0 +1,61 @@
+#pragma once
+
+#include <imgui.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace ImPlus::internal {
+
+// advance_table is a compact codepoint-to-advance map indexed up to U+10FFFF.
+//
+// - fonts only have glyphs above U+FFFF when ImGui is built with
+//   IMGUI_USE_WCHAR32, otherwise those codepoints get the fallback advance
+// - two levels: a page directory indexed by the upper codepoint bits, and
+//   256-entry pages of unscaled advances
+// - pages without any glyphs share a single fallback page, so sparse ranges
+//   (CJK, emoji, supplementary planes) only cost directory entries
+//
+struct advance_table {
+    static constexpr unsigned page_bits = 8;
+    static constexpr unsigned page_size = 1u << page_bits;
+    static constexpr unsigned max_codepoint = 0x10ffff;
+    static constexpr unsigned page_count = (max_codepoint >> page_bits) + 1;
+
+    advance_table() = default;
+    explicit advance_table(ImFont const& font);
+
+    auto operator()(unsigned int c) const -> float
+    {
+        return c <= max_codepoint ? pages_[directory_[c >> page_bits]][c & (page_size - 1)]
+                                  : fallback_;
+    }
+
+    auto memory_usage() const -> std::size_t
+    {
+        return sizeof(directory_) + pages_.size() * sizeof(page);
+    }
+
+private:
+    using page = std::array<float, page_size>;
+    float fallback_ = 0.0f;
+    std::array<std::uint16_t, page_count> directory_ = {}; // 0 refers to the fallback page
+    std::vector<page> pages_ = {page{}};
+};
+
+// advance_table_of returns the table for the font
+//
+// - tables are built on first use and shared by all text measuring code
+// - all tables are dropped when Font::Generation() changes, a table is rebuilt
+//   when the glyph count of its font changes
+//
+auto advance_table_of(ImFont const& font) -> advance_table const&;
+
+// measure_advance returns the advance of a single line of text without
+// performing any line breaking
+auto measure_advance(ImFont const& font, float font_size, std::string_view s) -> float;
+
+} // namespace ImPlus::internal
@@ -0,0 +1,15 @@
+#pragma once
+
+namespace ImPlus::internal {
+
+// distance_field_renderer is set by the renderers that draw the distance
+// field atlas, between their setup and shutdown, Font::Setup() builds a
+// bitmap atlas while it is clear
+//
+// the distance field shaders turn the sampled alpha d, with 0.5 at the glyph
+// edge, into coverage = clamp((d - 0.5) / fwidth(d) + 0.5, 0, 1), which
+// leaves the white pixel and the other opaque texels of the atlas opaque
+//
+inline bool distance_field_renderer = false;
+
+} // namespace ImPlus::internal
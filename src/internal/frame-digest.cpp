@@ -0,0 +1,133 @@
+#include "frame-digest.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cstring>
+
+namespace ImPlus::internal {
+
+static constexpr auto seed = std::uint64_t{0x243F6A8885A308D3ull};
+
+static auto mix(std::uint64_t h, std::uint64_t v) -> std::uint64_t
+{
+    h ^= v * 0x9E3779B97F4A7C15ull;
+    h = (h << 31) | (h >> 33);
+    return h * 0xBF58476D1CE4E5B9ull;
+}
+
+// hash_bytes hashes 8 bytes per step, vertex and index buffers are the bulk
+// of the digest
+static auto hash_bytes(std::uint64_t h, void const* data, std::size_t size) -> std::uint64_t
+{
+    auto p = static_cast<unsigned char const*>(data);
+    for (; size >= 8; size -= 8, p += 8) {
+        auto v = std::uint64_t{};
+        std::memcpy(&v, p, 8);
+        h = mix(h, v);
+    }
+    if (size) {
+        auto v = std::uint64_t{};
+        std::memcpy(&v, p, size);
+        h = mix(h, v ^ (std::uint64_t(size) << 56));
+    }
+    return h;
+}
+
+static auto hash_float(std::uint64_t h, float v) -> std::uint64_t
+{
+    auto bits = std::uint32_t{};
+    std::memcpy(&bits, &v, sizeof(bits));
+    return mix(h, bits);
+}
+
+static auto hash_rect(std::uint64_t h, ImVec4 const& r) -> std::uint64_t
+{
+    h = hash_float(h, r.x);
+    h = hash_float(h, r.y);
+    h = hash_float(h, r.z);
+    return hash_float(h, r.w);
+}
+
+static auto digest_list(ImDrawList const& dl, frame_digest::list& out) -> bool
+{
+    auto h = seed;
+    auto bounds = ImVec4{FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX};
+    for (auto const& cmd : dl.CmdBuffer) {
+        if (cmd.UserCallback) {
+            if (cmd.UserCallback != ImDrawCallback_ResetRenderState)
+                return false;
+            h = mix(h, ~std::uint64_t{0});
+            continue;
+        }
+        if (cmd.ElemCount == 0)
+            continue;
+        h = hash_rect(h, cmd.ClipRect);
+        h = mix(h, std::uint64_t((std::uintptr_t)cmd.TextureId));
+        h = mix(h, (std::uint64_t(cmd.VtxOffset) << 32) | cmd.IdxOffset);
+        h = mix(h, cmd.ElemCount);
+        bounds.x = std::min(bounds.x, cmd.ClipRect.x);
+        bounds.y = std::min(bounds.y, cmd.ClipRect.y);
+        bounds.z = std::max(bounds.z, cmd.ClipRect.z);
+        bounds.w = std::max(bounds.w, cmd.ClipRect.w);
+    }
+    h = hash_bytes(h, dl.VtxBuffer.Data, std::size_t(dl.VtxBuffer.size_in_bytes()));
+    h = hash_bytes(h, dl.IdxBuffer.Data, std::size_t(dl.IdxBuffer.size_in_bytes()));
+
+    out.dl = &dl;
+    out.hash = h;
+    out.bounds = bounds.x <= bounds.z ? bounds : ImVec4{};
+    return true;
+}
+
+void make_digest(ImDrawData const& dd, frame_digest& d)
+{
+    auto h = seed;
+    h = hash_float(h, dd.DisplayPos.x);
+    h = hash_float(h, dd.DisplayPos.y);
+    h = hash_float(h, dd.DisplaySize.x);
+    h = hash_float(h, dd.DisplaySize.y);
+    h = hash_float(h, dd.FramebufferScale.x);
+    h = hash_float(h, dd.FramebufferScale.y);
+
+    d.comparable = true;
+    d.lists.resize(std::size_t(dd.CmdListsCount));
+    for (auto i = 0; i < dd.CmdListsCount; ++i) {
+        auto& l = d.lists[std::size_t(i)];
+        if (!digest_list(*dd.CmdLists[i], l)) {
+            d.comparable = false;
+            d.lists.clear();
+            d.hash = 0;
+            return;
+        }
+        h = mix(h, l.hash);
+    }
+    d.hash = h;
+}
+
+auto damage_rect(frame_digest const& prev, frame_digest const& next) -> ImVec4
+{
+    auto r = ImVec4{FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX};
+    auto add = [&](ImVec4 const& b) {
+        if (b.x >= b.z || b.y >= b.w)
+            return;
+        r.x = std::min(r.x, b.x);
+        r.y = std::min(r.y, b.y);
+        r.z = std::max(r.z, b.z);
+        r.w = std::max(r.w, b.w);
+    };
+
+    auto const n = std::max(prev.lists.size(), next.lists.size());
+    for (auto i = std::size_t{0}; i < n; ++i) {
+        auto const p = i < prev.lists.size() ? &prev.lists[i] : nullptr;
+        auto const q = i < next.lists.size() ? &next.lists[i] : nullptr;
+        if (p && q && p->dl == q->dl && p->hash == q->hash)
+            continue;
+        if (p)
+            add(p->bounds);
+        if (q)
+            add(q->bounds);
+    }
+    return r.x <= r.z ? r : ImVec4{};
+}
+
+} // namespace ImPlus::internal
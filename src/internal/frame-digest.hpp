@@ -0,0 +1,32 @@
+#pragma once
+
+#include <imgui.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace ImPlus::internal {
+
+// frame_digest summarizes the draw data of a frame, two frames with equal
+// digests submit the same geometry, clip rects and texture ids
+struct frame_digest {
+    struct list {
+        ImDrawList const* dl = nullptr;
+        std::uint64_t hash = 0;
+        ImVec4 bounds = {}; // union of the clip rects of the draw commands
+    };
+
+    std::uint64_t hash = 0;  // display, framebuffer scale and all lists
+    bool comparable = false; // false if a draw command runs a user callback
+    std::vector<list> lists;
+};
+
+// make_digest computes the digest of draw data, reusing the storage of d
+void make_digest(ImDrawData const& dd, frame_digest& d);
+
+// damage_rect returns the union of the bounds (in display coordinates) of the
+// draw lists that differ between the digests of two frames of one display,
+// lists are matched by position
+auto damage_rect(frame_digest const& prev, frame_digest const& next) -> ImVec4;
+
+} // namespace ImPlus::internal
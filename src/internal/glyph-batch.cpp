@@ -0,0 +1,92 @@
+#include "glyph-batch.hpp"
+
+#include <imgui_internal.h>
+
+namespace ImPlus::internal {
+
+void glyph_batch::add_glyph(ImFontGlyph const& glyph, float scale, float x, float y, ImU32 clr)
+{
+    if (!glyph.Visible)
+        return;
+
+    auto const x0 = x + glyph.X0 * scale;
+    auto const x1 = x + glyph.X1 * scale;
+    auto const y0 = y + glyph.Y0 * scale;
+    auto const y1 = y + glyph.Y1 * scale;
+    auto const& clip = dl_->_CmdHeader.ClipRect;
+    if (x0 > clip.z || x1 < clip.x || y0 > clip.w || y1 < clip.y)
+        return;
+
+    if (count_ == capacity)
+        flush();
+    quads_[count_++] = {
+        {x0, y0},
+        {x1, y1},
+        {glyph.U0, glyph.V0},
+        {glyph.U1, glyph.V1},
+        glyph.Colored ? clr | ~IM_COL32_A_MASK : clr,
+    };
+}
+
+void glyph_batch::add_char(ImFont& font, float size, ImVec2 const& pos, ImU32 clr, ImWchar c)
+{
+    IM_ASSERT(font.ContainerAtlas->TexID == dl_->_CmdHeader.TextureId);
+    if ((clr & IM_COL32_A_MASK) == 0)
+        return;
+    if (auto glyph = font.FindGlyph(c))
+        add_glyph(*glyph, size / font.FontSize, IM_TRUNC(pos.x), IM_TRUNC(pos.y), clr);
+}
+
+void glyph_batch::add_text(
+    ImFont& font, float size, ImVec2 const& pos, ImU32 clr, std::string_view text)
+{
+    IM_ASSERT(font.ContainerAtlas->TexID == dl_->_CmdHeader.TextureId);
+    if ((clr & IM_COL32_A_MASK) == 0)
+        return;
+
+    auto const scale = size / font.FontSize;
+    auto const line_height = font.FontSize * scale;
+    auto const start_x = IM_TRUNC(pos.x);
+    auto x = start_x;
+    auto y = IM_TRUNC(pos.y);
+
+    auto s = text.data();
+    auto const end = s + text.size();
+    while (s < end) {
+        auto c = static_cast<unsigned int>(*s);
+        if (c < 0x80)
+            ++s;
+        else
+            s += ImTextCharFromUtf8(&c, s, end);
+        if (c == 0)
+            break;
+
+        if (c == '\n') {
+            x = start_x;
+            y += line_height;
+            continue;
+        }
+        if (c == '\r')
+            continue;
+
+        auto const glyph = font.FindGlyph(ImWchar(c));
+        if (!glyph)
+            continue;
+        add_glyph(*glyph, scale, x, y, clr);
+        x += glyph->AdvanceX * scale;
+    }
+}
+
+void glyph_batch::flush()
+{
+    if (!count_)
+        return;
+    dl_->PrimReserve(count_ * 6, count_ * 4);
+    for (auto i = 0; i < count_; ++i) {
+        auto const& q = quads_[i];
+        dl_->PrimRectUV(q.min, q.max, q.uv_min, q.uv_max, q.clr);
+    }
+    count_ = 0;
+}
+
+} // namespace ImPlus::internal
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <imgui.h>
+
+#include <string_view>
+
+namespace ImPlus::internal {
+
+// glyph_batch appends the quads of glyphs drawn in sequence to a draw list
+// with one PrimReserve per flush, instead of one per character or string
+//
+// - glyphs must come from the atlas bound to the draw list and share its
+//   current clip rect, quads fully outside the clip rect are dropped
+// - the batch is flushed when full, by flush() and on destruction; flush
+//   before drawing anything else to the draw list to keep the order
+// - glyphs are placed like ImFont::RenderText does (truncated pen position,
+//   colored glyphs untinted)
+//
+class glyph_batch {
+public:
+    explicit glyph_batch(ImDrawList* dl)
+        : dl_{dl}
+    {
+    }
+    glyph_batch(glyph_batch const&) = delete;
+    auto operator=(glyph_batch const&) -> glyph_batch& = delete;
+    ~glyph_batch() { flush(); }
+
+    // add_char adds a glyph with the top-left of its line at pos
+    void add_char(ImFont& font, float size, ImVec2 const& pos, ImU32 clr, ImWchar c);
+
+    // add_text adds the glyphs of UTF-8 text, lines are separated by '\n'
+    void add_text(ImFont& font, float size, ImVec2 const& pos, ImU32 clr, std::string_view text);
+
+    void flush();
+
+private:
+    struct quad {
+        ImVec2 min, max;
+        ImVec2 uv_min, uv_max;
+        ImU32 clr;
+    };
+    static constexpr int capacity = 32;
+
+    void add_glyph(ImFontGlyph const& glyph, float scale, float x, float y, ImU32 clr);
+
+    ImDrawList* dl_;
+    quad quads_[capacity];
+    int count_ = 0;
+};
+
+} // namespace ImPlus::internal
@@ -0,0 +1,256 @@
+#include "glyph-prerender.hpp"
+
+#if defined(IMPLUS_USE_FREETYPE)
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include FT_SYNTHESIS_H
+#include <imgui_freetype.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <future>
+#include <thread>
+
+namespace ImPlus::internal {
+
+namespace {
+
+constexpr unsigned chunk_size = 512; // codepoints per job
+
+// ft_ceil rounds 26.6 fixed point values up to whole pixels
+constexpr auto ft_ceil(FT_Pos v) -> FT_Pos { return (v + 63) >> 6; }
+
+struct chunk {
+    std::size_t config = 0;
+    unsigned lo = 0; // inclusive
+    unsigned hi = 0; // inclusive
+    prerendered_font result;
+};
+
+// ft_options mirrors the load flags and the render mode of the FreeType atlas
+// builder for the given builder flags
+struct ft_options {
+    FT_Int32 load_flags = 0;
+    FT_Render_Mode render_mode = FT_RENDER_MODE_NORMAL;
+    bool bold = false;
+    bool oblique = false;
+
+    explicit ft_options(unsigned flags, bool distance_fields)
+    {
+        bold = (flags & ImGuiFreeTypeBuilderFlags_Bold) != 0;
+        oblique = (flags & ImGuiFreeTypeBuilderFlags_Oblique) != 0;
+        if (distance_fields) {
+            // the fields are scaled, hinting to the baked size would distort them
+            load_flags = FT_LOAD_NO_BITMAP | FT_LOAD_NO_HINTING;
+            render_mode = FT_RENDER_MODE_SDF;
+            return;
+        }
+
+        load_flags = FT_LOAD_NO_BITMAP;
+        if (flags & ImGuiFreeTypeBuilderFlags_NoHinting)
+            load_flags |= FT_LOAD_NO_HINTING;
+        if (flags & ImGuiFreeTypeBuilderFlags_NoAutoHint)
+            load_flags |= FT_LOAD_NO_AUTOHINT;
+        if (flags & ImGuiFreeTypeBuilderFlags_ForceAutoHint)
+            load_flags |= FT_LOAD_FORCE_AUTOHINT;
+        if (flags & ImGuiFreeTypeBuilderFlags_LightHinting)
+            load_flags |= FT_LOAD_TARGET_LIGHT;
+        else if (flags & ImGuiFreeTypeBuilderFlags_MonoHinting)
+            load_flags |= FT_LOAD_TARGET_MONO;
+        else
+            load_flags |= FT_LOAD_TARGET_NORMAL;
+        if (flags & ImGuiFreeTypeBuilderFlags_Monochrome)
+            render_mode = FT_RENDER_MODE_MONO;
+    }
+};
+
+// rasterizer is the FreeType state of one thread, faces are opened at the
+// size of their config on first use
+struct rasterizer {
+    std::span<ImFontConfig const* const> configs;
+    prerender_options options;
+    FT_Library lib = nullptr;
+    std::vector<FT_Face> faces;
+    std::vector<bool> tried;
+
+    rasterizer(std::span<ImFontConfig const* const> configs, prerender_options const& options)
+        : configs{configs}
+        , options{options}
+        , faces(configs.size(), nullptr)
+        , tried(configs.size(), false)
+    {
+        if (FT_Init_FreeType(&lib))
+            lib = nullptr;
+    }
+
+    ~rasterizer()
+    {
+        for (auto f : faces)
+            if (f)
+                FT_Done_Face(f);
+        if (lib)
+            FT_Done_FreeType(lib);
+    }
+
+    rasterizer(rasterizer const&) = delete;
+    auto operator=(rasterizer const&) -> rasterizer& = delete;
+
+    auto face_of(std::size_t i) -> FT_Face
+    {
+        if (tried[i] || !lib)
+            return faces[i];
+        tried[i] = true;
+
+        auto const& cfg = *configs[i];
+        auto f = FT_Face{};
+        if (FT_New_Memory_Face(lib, static_cast<FT_Byte const*>(cfg.FontData),
+                FT_Long(cfg.FontDataSize), FT_Long(cfg.FontNo), &f))
+            return nullptr;
+        FT_Select_Charmap(f, FT_ENCODING_UNICODE);
+
+        auto req = FT_Size_RequestRec{};
+        req.type = FT_SIZE_REQUEST_TYPE_REAL_DIM;
+        req.height = FT_Long(std::uint32_t(cfg.SizePixels) * 64);
+        if (FT_Request_Size(f, &req)) {
+            FT_Done_Face(f);
+            return nullptr;
+        }
+        faces[i] = f;
+        return f;
+    }
+
+    void run(chunk& c)
+    {
+        auto const f = face_of(c.config);
+        if (!f)
+            return;
+
+        auto const& cfg = *configs[c.config];
+        auto const opt =
+            ft_options{cfg.FontBuilderFlags | options.builder_flags, options.distance_fields};
+
+        // distances must not be scaled, the edge stays at 128
+        auto const factor = options.distance_fields ? 1.0f : cfg.RasterizerMultiply;
+        std::uint8_t multiply[256];
+        for (auto i = 0; i < 256; ++i)
+            multiply[i] = std::uint8_t(std::min(unsigned(float(i) * factor), 255u));
+
+        auto& out = c.result;
+        for (auto cp = c.lo; cp <= c.hi; ++cp) {
+            auto const gi = FT_Get_Char_Index(f, cp);
+            if (!gi || FT_Load_Glyph(f, gi, opt.load_flags))
+                continue;
+            auto const slot = f->glyph;
+            if (opt.bold)
+                FT_GlyphSlot_Embolden(slot);
+            if (opt.oblique)
+                FT_GlyphSlot_Oblique(slot);
+            if (FT_Render_Glyph(slot, opt.render_mode)) {
+                // the builder renders a coverage bitmap instead
+                if (options.distance_fields)
+                    out.deferred.push_back(cp);
+                continue;
+            }
+
+            auto const& bm = slot->bitmap;
+            auto const gray = bm.pixel_mode == FT_PIXEL_MODE_GRAY;
+            auto const mono = bm.pixel_mode == FT_PIXEL_MODE_MONO;
+            if (!bm.width || !bm.rows || (!gray && !mono)) {
+                out.deferred.push_back(cp);
+                continue;
+            }
+
+            // placed and advanced like ImFontAtlasBuildWithFreeType and
+            // ImFont::AddGlyph do
+            auto const advance_org = float(ft_ceil(slot->advance.x));
+            auto advance = std::clamp(advance_org, cfg.GlyphMinAdvanceX, cfg.GlyphMaxAdvanceX);
+            auto off_x = cfg.GlyphOffset.x;
+            if (advance != advance_org)
+                off_x += cfg.PixelSnapH ? std::floor((advance - advance_org) * 0.5f)
+                                        : (advance - advance_org) * 0.5f;
+            if (cfg.PixelSnapH)
+                advance = std::round(advance);
+            advance += cfg.GlyphExtraSpacing.x;
+
+            auto& g = out.glyphs.emplace_back();
+            g.codepoint = cp;
+            g.width = int(bm.width);
+            g.height = int(bm.rows);
+            g.offset = {float(slot->bitmap_left) + off_x,
+                float(-slot->bitmap_top) + cfg.GlyphOffset.y};
+            g.advance_x = advance;
+            g.pixels = out.pixels.size();
+
+            out.pixels.resize(out.pixels.size() + std::size_t(g.width) * g.height);
+            auto dst = out.pixels.data() + g.pixels;
+            for (auto y = 0u; y < bm.rows; ++y, dst += g.width) {
+                auto const src = bm.buffer + std::ptrdiff_t(y) * bm.pitch;
+                if (gray)
+                    for (auto x = 0u; x < bm.width; ++x)
+                        dst[x] = multiply[src[x]];
+                else
+                    for (auto x = 0u; x < bm.width; ++x)
+                        dst[x] = multiply[(src[x >> 3] & (0x80 >> (x & 7))) ? 255 : 0];
+            }
+        }
+    }
+};
+
+} // namespace
+
+auto prerender_glyphs(std::span<ImFontConfig const* const> configs,
+    prerender_options const& options) -> prerender_result
+{
+    auto ret = prerender_result{};
+    ret.fonts.resize(configs.size());
+
+    auto chunks = std::vector<chunk>{};
+    for (std::size_t i = 0; i < configs.size(); ++i) {
+        for (auto r = configs[i]->GlyphRanges; r && r[0] && r[1]; r += 2) {
+            for (unsigned lo = r[0]; lo <= r[1]; lo += chunk_size) {
+                auto const hi = std::min(unsigned(r[1]), lo + chunk_size - 1);
+                chunks.push_back(chunk{.config = i, .lo = lo, .hi = hi});
+            }
+        }
+    }
+    if (chunks.empty())
+        return ret;
+
+    // workers and the calling thread take the next chunk
+    auto next = std::atomic<std::size_t>{0};
+    auto work = [&] {
+        auto r = rasterizer{configs, options};
+        for (auto i = next++; i < chunks.size(); i = next++)
+            r.run(chunks[i]);
+    };
+    auto const threads = options.parallel ? std::max(std::thread::hardware_concurrency(), 1u) : 1u;
+    auto const workers = std::min(std::size_t(threads - 1), chunks.size() - 1);
+    auto pool = std::vector<std::future<void>>{};
+    pool.reserve(workers);
+    for (std::size_t i = 0; i < workers; ++i)
+        pool.push_back(std::async(std::launch::async, work));
+    work();
+    for (auto& f : pool)
+        f.get();
+    ret.threads = workers + 1;
+
+    // chunks are joined per config, in the order of its ranges
+    for (auto& c : chunks) {
+        auto& font = ret.fonts[c.config];
+        auto const base = font.pixels.size();
+        for (auto& g : c.result.glyphs) {
+            g.pixels += base;
+            font.glyphs.push_back(g);
+        }
+        font.deferred.insert(font.deferred.end(), c.result.deferred.begin(),
+            c.result.deferred.end());
+        font.pixels.insert(font.pixels.end(), c.result.pixels.begin(), c.result.pixels.end());
+    }
+    return ret;
+}
+
+} // namespace ImPlus::internal
+
+#endif
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <imgui.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace ImPlus::internal {
+
+// prerendered_glyph is a glyph rasterized ahead of the atlas build, placed
+// like the FreeType atlas builder places its glyphs except for the ascent of
+// the destination font, which is known only after the build
+struct prerendered_glyph {
+    unsigned codepoint = 0;
+    int width = 0;
+    int height = 0;
+    ImVec2 offset = {0, 0}; // from the pen position, without the ascent
+    float advance_x = 0.0f;
+    std::size_t pixels = 0; // first alpha row in prerendered_font::pixels
+};
+
+// prerendered_font holds the glyphs of one font config in codepoint order
+//
+// - glyphs have alpha pixels, RasterizerMultiply already applied, or
+//   distance fields with 128 on the outline
+// - deferred are codepoints the font has a glyph for that is left to the
+//   atlas builder: blank glyphs (spaces), bitmaps of other pixel modes and
+//   outlines without a distance field
+//
+struct prerendered_font {
+    std::vector<prerendered_glyph> glyphs;
+    std::vector<unsigned> deferred;
+    std::vector<std::uint8_t> pixels;
+};
+
+struct prerender_result {
+    std::vector<prerendered_font> fonts; // one per config
+    std::size_t threads = 0;
+};
+
+struct prerender_options {
+    unsigned builder_flags = 0;   // ImFontAtlas::FontBuilderFlags
+    bool distance_fields = false; // unhinted signed distance fields
+    bool parallel = true;         // false rasterizes on the calling thread
+};
+
+// prerender_glyphs rasterizes the glyphs within the ranges of each config
+// with FreeType, with the load flags and the size the FreeType atlas builder
+// would use
+//
+// - the ranges are split into chunks taken by the calling thread and at most
+//   hardware_concurrency - 1 workers, each thread has its own FT_Library and
+//   opens the faces it needs
+// - glyphs are rasterized at the default rasterizer density, configs that
+//   load color or bitmap glyphs are left to the atlas builder by the caller
+// - distance fields are rendered with FT_RENDER_MODE_SDF and its default
+//   spread of 8 pixels around the outline, hinting and RasterizerMultiply
+//   are ignored
+//
+auto prerender_glyphs(std::span<ImFontConfig const* const> configs,
+    prerender_options const& options) -> prerender_result;
+
+} // namespace ImPlus::internal
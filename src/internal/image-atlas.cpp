@@ -0,0 +1,220 @@
+#include "image-atlas.hpp"
+
+#include <implus/render-device.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace ImPlus::internal {
+
+image_atlas::image_atlas(int page_size, std::size_t budget)
+    : page_size_{page_size}
+    , budget_{budget}
+{
+}
+
+auto image_atlas::find(key const& k) -> region const*
+{
+    auto it = entries_.find(k);
+    if (it == entries_.end())
+        return nullptr;
+
+    auto& e = it->second;
+    e.last_frame = ImGui::GetFrameCount();
+    lru_.splice(lru_.begin(), lru_, e.lru);
+    return &e.r;
+}
+
+// place finds the best fitting free span: the shelf with the least height
+// waste, then a new shelf, then a new page
+auto image_atlas::place(int w, int h) -> placement
+{
+    auto best = placement{};
+    auto best_waste = page_size_;
+    for (auto p = 0; p < int(pages_.size()); ++p) {
+        auto const& shelves = pages_[p].shelves;
+        for (auto s = 0; s < int(shelves.size()); ++s) {
+            auto const waste = shelves[s].h - h;
+            if (waste < 0 || waste >= best_waste)
+                continue;
+            auto const& free = shelves[s].free;
+            for (auto i = 0; i < int(free.size()); ++i)
+                if (free[i].w >= w) {
+                    best = placement{p, s, i};
+                    best_waste = waste;
+                    break;
+                }
+        }
+    }
+    if (best.page >= 0)
+        return best;
+
+    auto open_shelf = [&](int p) {
+        auto& pg = pages_[p];
+        pg.shelves.push_back(shelf{.y = pg.bottom, .h = h, .free = {span{0, page_size_}}});
+        pg.bottom += h;
+        return placement{p, int(pg.shelves.size()) - 1, 0};
+    };
+
+    for (auto p = 0; p < int(pages_.size()); ++p)
+        if (pages_[p].bottom + h <= page_size_)
+            return open_shelf(p);
+
+    if (pages_.empty() || (pages_.size() + 1) * page_bytes() <= budget_) {
+        auto const texture = create_texture(*this, page_size_, page_size_);
+        if (!texture)
+            return {}; // no renderer or no memory
+        pages_.emplace_back().texture = texture;
+        return open_shelf(int(pages_.size()) - 1);
+    }
+    return {};
+}
+
+void image_atlas::release(entry const& e)
+{
+    auto& pg = pages_[e.page];
+    --pg.images;
+    if (pg.images == 0) {
+        pg.shelves.clear();
+        pg.bottom = 0;
+        return;
+    }
+
+    auto s = std::find_if(
+        pg.shelves.begin(), pg.shelves.end(), [&](shelf const& s) { return s.y == e.y; });
+    if (s == pg.shelves.end())
+        return;
+
+    // return the span and merge it with adjacent free spans
+    auto& free = s->free;
+    auto pos = std::lower_bound(free.begin(), free.end(), e.x,
+        [](span const& a, int x) { return a.x < x; });
+    pos = free.insert(pos, span{e.x, e.w});
+    if (auto next = pos + 1; next != free.end() && pos->x + pos->w == next->x) {
+        pos->w += next->w;
+        free.erase(next);
+    }
+    if (pos != free.begin()) {
+        if (auto prev = pos - 1; prev->x + prev->w == pos->x) {
+            prev->w += pos->w;
+            free.erase(pos);
+        }
+    }
+
+    // drop empty shelves from the top of the page
+    while (!pg.shelves.empty()) {
+        auto const& top = pg.shelves.back();
+        if (top.free.size() != 1 || top.free.front().w != page_size_)
+            break;
+        pg.bottom = top.y;
+        pg.shelves.pop_back();
+    }
+}
+
+auto image_atlas::evict_one() -> bool
+{
+    auto const frame = ImGui::GetFrameCount();
+    if (lru_.empty())
+        return false;
+
+    auto it = entries_.find(lru_.back());
+    if (it->second.last_frame == frame)
+        return false; // everything else was used more recently
+
+    release(it->second);
+    lru_.pop_back();
+    entries_.erase(it);
+    return true;
+}
+
+auto image_atlas::insert(key const& k, std::uint8_t const* pixels) -> region const*
+{
+    if (k.w <= 0 || k.h <= 0 || k.w > max_image_size() || k.h > max_image_size())
+        return nullptr;
+    if (auto r = find(k))
+        return r;
+
+    auto const w = k.w + 2;
+    auto const h = k.h + 2;
+
+    auto p = place(w, h);
+    while (p.page < 0 && evict_one())
+        p = place(w, h);
+    if (p.page < 0)
+        return nullptr;
+
+    auto& pg = pages_[p.page];
+    auto& sh = pg.shelves[p.shelf];
+    auto& slot = sh.free[p.slot];
+    auto const x = slot.x;
+    slot.x += w;
+    slot.w -= w;
+    if (slot.w == 0)
+        sh.free.erase(sh.free.begin() + p.slot);
+    ++pg.images;
+
+    // upload with a transparent border
+    auto const row = std::size_t(w) * 4;
+    staging_.assign(row * h, 0);
+    for (auto y = 0; y < k.h; ++y)
+        std::memcpy(staging_.data() + (y + 1) * row + 4, pixels + std::size_t(y) * k.w * 4,
+            std::size_t(k.w) * 4);
+    Render::UpdateTexture(pg.texture, x, sh.y, w, h, staging_.data());
+
+    auto const scale = 1.0f / float(page_size_);
+    lru_.push_front(k);
+    auto& e = entries_[k];
+    e = entry{
+        .r =
+            region{
+                .texture = pg.texture,
+                .uv0 = {float(x + 1) * scale, float(sh.y + 1) * scale},
+                .uv1 = {float(x + 1 + k.w) * scale, float(sh.y + 1 + k.h) * scale},
+            },
+        .page = p.page,
+        .y = sh.y,
+        .x = x,
+        .w = w,
+        .last_frame = ImGui::GetFrameCount(),
+        .lru = lru_.begin(),
+    };
+    return &e.r;
+}
+
+void image_atlas::erase(std::uint64_t id)
+{
+    std::erase_if(entries_, [&](auto const& kv) {
+        if (kv.first.id != id)
+            return false;
+        release(kv.second);
+        lru_.erase(kv.second.lru);
+        return true;
+    });
+}
+
+void image_atlas::set_budget(std::size_t bytes)
+{
+    budget_ = bytes;
+    if (memory_usage() > budget_)
+        clear();
+}
+
+void image_atlas::clear()
+{
+    for (auto const& pg : pages_)
+        destroy_texture(pg.texture);
+    textures_released();
+}
+
+void image_atlas::textures_released()
+{
+    pages_.clear();
+    entries_.clear();
+    lru_.clear();
+    staging_.clear();
+    staging_.shrink_to_fit();
+}
+
+auto image_atlas::memory_usage() const -> std::size_t { return pages_.size() * page_bytes(); }
+
+} // namespace ImPlus::internal
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <imgui.h>
+
+#include "texture-pool.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace ImPlus::internal {
+
+// image_atlas packs small RGBA images into shared texture pages of the
+// texture pool
+//
+// - pages are split into shelves (rows of equal height), images are placed
+//   into the best fitting shelf, space of evicted images is reused
+// - the total size of the pages is limited by the memory budget, when an image
+//   does not fit, the least recently used images are evicted; images drawn in
+//   the current frame are never evicted
+// - images are padded with a transparent border so that bilinear filtering
+//   does not pick up neighbouring images
+// - pages are destroyed by clear() and the destructor, and dropped with all
+//   images when the renderer releases its textures; without a renderer no
+//   page can be created and insert returns null, the caller draws uncached
+//
+struct image_atlas : public texture_owner {
+    struct key {
+        std::uint64_t id = 0;
+        int w = 0;
+        int h = 0;
+        friend auto operator==(key const&, key const&) -> bool = default;
+    };
+
+    struct region {
+        ImTextureID texture = {};
+        ImVec2 uv0 = {0, 0};
+        ImVec2 uv1 = {0, 0};
+    };
+
+    image_atlas() = default;
+    image_atlas(int page_size, std::size_t budget);
+    ~image_atlas() override { clear(); }
+
+    // find returns the region of a cached image and marks it as used
+    auto find(key const& k) -> region const*;
+
+    // insert uploads k.w * k.h tightly packed RGBA pixels, returns null if the
+    // image does not fit into the budget
+    auto insert(key const& k, std::uint8_t const* pixels) -> region const*;
+
+    // erase removes all sizes of the image
+    void erase(std::uint64_t id);
+
+    // set_budget changes the memory budget, drops all pages if the current
+    // pages exceed the new budget
+    void set_budget(std::size_t bytes);
+
+    // clear destroys all pages
+    void clear();
+
+    void textures_released() override;
+
+    auto memory_usage() const -> std::size_t;
+    auto size() const -> std::size_t { return entries_.size(); }
+    auto max_image_size() const -> int { return page_size_ - 2; }
+
+private:
+    struct key_hash {
+        auto operator()(key const& k) const noexcept -> std::size_t
+        {
+            auto h = std::hash<std::uint64_t>{}(k.id);
+            h ^= std::size_t(k.w) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            h ^= std::size_t(k.h) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            return h;
+        }
+    };
+
+    struct span {
+        int x = 0;
+        int w = 0;
+    };
+
+    struct shelf {
+        int y = 0;
+        int h = 0;
+        std::vector<span> free;
+    };
+
+    struct page {
+        ImTextureID texture = {};
+        std::vector<shelf> shelves;
+        int bottom = 0;
+        int images = 0;
+    };
+
+    struct entry {
+        region r;
+        int page = 0;
+        int y = 0; // shelf
+        int x = 0;
+        int w = 0; // padded width
+        int last_frame = 0;
+        std::list<key>::iterator lru;
+    };
+
+    struct placement {
+        int page = -1;
+        int shelf = -1;
+        int slot = -1;
+    };
+
+    auto page_bytes() const -> std::size_t { return std::size_t(page_size_) * page_size_ * 4; }
+    auto place(int w, int h) -> placement;
+    void release(entry const& e);
+    auto evict_one() -> bool;
+
+    int page_size_ = 1024;
+    std::size_t budget_ = std::size_t{16} << 20;
+    std::vector<page> pages_;
+    std::unordered_map<key, entry, key_hash> entries_;
+    std::list<key> lru_; // most recently used first
+    std::vector<std::uint8_t> staging_;
+};
+
+} // namespace ImPlus::internal
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <implus/image.hpp>
+
+#include <cstdint>
+#include <span>
+
+namespace ImPlus::internal {
+
+#ifdef IMPLUS_ENABLE_STB_IMAGE
+// decode_stb_image decodes PNG, JPEG, BMP, GIF (first frame), TGA and PSD
+// images with stb_image, returns empty pixels on failure
+auto decode_stb_image(std::span<std::uint8_t const> encoded) -> TextureImage::Pixels;
+#endif
+
+} // namespace ImPlus::internal
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+namespace ImPlus::internal {
+
+// mpsc_queue is an unbounded lock-free queue with many producers and a single
+// consumer (Vyukov's intrusive queue)
+//
+// - push is wait-free: one atomic exchange and one store
+// - pop may briefly see the queue as empty while a producer is between its
+//   exchange and store, the item is returned by a later pop
+//
+template <typename T> class mpsc_queue {
+public:
+    mpsc_queue() = default;
+    mpsc_queue(mpsc_queue const&) = delete;
+    auto operator=(mpsc_queue const&) -> mpsc_queue& = delete;
+
+    ~mpsc_queue()
+    {
+        while (pop())
+            ;
+    }
+
+    // push may be called from any thread
+    void push(T value) { link(new node{{}, std::move(value)}); }
+
+    // pop is called from the consumer thread only
+    auto pop() -> std::optional<T>
+    {
+        auto tail = tail_;
+        auto next = tail->next.load(std::memory_order_acquire);
+        if (tail == &stub_) {
+            if (!next)
+                return std::nullopt;
+            tail_ = next;
+            tail = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+
+        if (!next) {
+            if (tail != head_.load(std::memory_order_acquire))
+                return std::nullopt; // a producer is linking the next node
+            link(&stub_);
+            next = tail->next.load(std::memory_order_acquire);
+            if (!next)
+                return std::nullopt;
+        }
+
+        tail_ = next;
+        auto value = std::move(tail->value);
+        delete tail;
+        return value;
+    }
+
+    // empty is approximate unless called from the consumer thread
+    auto empty() const -> bool
+    {
+        return tail_ == &stub_ && !stub_.next.load(std::memory_order_acquire);
+    }
+
+private:
+    struct node {
+        std::atomic<node*> next = nullptr;
+        T value;
+    };
+
+    void link(node* n)
+    {
+        n->next.store(nullptr, std::memory_order_relaxed);
+        auto prev = head_.exchange(n, std::memory_order_acq_rel);
+        prev->next.store(n, std::memory_order_release);
+    }
+
+    node stub_ = {};
+    std::atomic<node*> head_ = &stub_;
+    node* tail_ = &stub_;
+};
+
+} // namespace ImPlus::internal
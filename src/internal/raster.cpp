@@ -0,0 +1,230 @@
+#include "raster.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace ImPlus::internal {
+
+inline auto edge(ImVec2 const& a, ImVec2 const& b, float px, float py) -> float
+{
+    return (b.x - a.x) * (py - a.y) - (b.y - a.y) * (px - a.x);
+}
+
+// top-left fill rule, makes sure that pixels on edges shared between
+// adjacent triangles are covered only once
+inline auto is_top_left(ImVec2 const& a, ImVec2 const& b) -> bool
+{
+    return (a.y == b.y && b.x < a.x) || b.y > a.y;
+}
+
+// rasterize_command calls shade(x, y, v0, v1, v2, b0, b1, b2) for the pixels
+// covered by the triangles of a draw command, positions are mapped with
+// (p - origin) * scale
+template <typename Shade>
+void rasterize_command(ImDrawList const& dl, ImDrawCmd const& cmd, ImVec2 const& origin,
+    ImVec2 const& scale, int w, int h, Shade&& shade)
+{
+    auto const& vtx = dl.VtxBuffer;
+    auto const& idx = dl.IdxBuffer;
+
+    auto const map = [&](ImVec2 const& p) {
+        return ImVec2{(p.x - origin.x) * scale.x, (p.y - origin.y) * scale.y};
+    };
+
+    auto const clip_min = map({cmd.ClipRect.x, cmd.ClipRect.y});
+    auto const clip_max = map({cmd.ClipRect.z, cmd.ClipRect.w});
+    auto const clip_x0 = std::max(0, int(std::floor(clip_min.x)));
+    auto const clip_y0 = std::max(0, int(std::floor(clip_min.y)));
+    auto const clip_x1 = std::min(w, int(std::ceil(clip_max.x)));
+    auto const clip_y1 = std::min(h, int(std::ceil(clip_max.y)));
+    if (clip_x0 >= clip_x1 || clip_y0 >= clip_y1)
+        return;
+
+    for (unsigned i = 0; i + 2 < cmd.ElemCount; i += 3) {
+        auto const* tri = idx.Data + cmd.IdxOffset + i;
+        ImDrawVert const* v[3] = {
+            &vtx.Data[cmd.VtxOffset + tri[0]],
+            &vtx.Data[cmd.VtxOffset + tri[1]],
+            &vtx.Data[cmd.VtxOffset + tri[2]],
+        };
+
+        ImVec2 p[3] = {map(v[0]->pos), map(v[1]->pos), map(v[2]->pos)};
+        auto area = edge(p[0], p[1], p[2].x, p[2].y);
+        if (area == 0.0f)
+            continue;
+        if (area < 0.0f) {
+            std::swap(v[1], v[2]);
+            std::swap(p[1], p[2]);
+            area = -area;
+        }
+
+        auto const& p0 = p[0];
+        auto const& p1 = p[1];
+        auto const& p2 = p[2];
+
+        auto const x0 = std::max(clip_x0, int(std::floor(std::min({p0.x, p1.x, p2.x}))));
+        auto const y0 = std::max(clip_y0, int(std::floor(std::min({p0.y, p1.y, p2.y}))));
+        auto const x1 = std::min(clip_x1, int(std::ceil(std::max({p0.x, p1.x, p2.x}))));
+        auto const y1 = std::min(clip_y1, int(std::ceil(std::max({p0.y, p1.y, p2.y}))));
+
+        auto const tl0 = is_top_left(p1, p2);
+        auto const tl1 = is_top_left(p2, p0);
+        auto const tl2 = is_top_left(p0, p1);
+        auto const inv_area = 1.0f / area;
+
+        for (auto y = y0; y < y1; ++y) {
+            auto const py = float(y) + 0.5f;
+            for (auto x = x0; x < x1; ++x) {
+                auto const px = float(x) + 0.5f;
+                auto const w0 = edge(p1, p2, px, py);
+                auto const w1 = edge(p2, p0, px, py);
+                auto const w2 = edge(p0, p1, px, py);
+                if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f)
+                    continue;
+                if ((w0 == 0.0f && !tl0) || (w1 == 0.0f && !tl1) || (w2 == 0.0f && !tl2))
+                    continue;
+                shade(x, y, *v[0], *v[1], *v[2], w0 * inv_area, w1 * inv_area, w2 * inv_area);
+            }
+        }
+    }
+}
+
+inline auto channel(ImU32 c, int shift) -> float { return float((c >> shift) & 0xff); }
+
+inline auto alpha_of(ImU32 c) -> float { return channel(c, IM_COL32_A_SHIFT); }
+
+// sample_alpha reads the alpha of tex at (u, v) with bilinear filtering and
+// clamping to the edge, as the GPU backends sample the font atlas
+auto sample_alpha(rgba_texture const& tex, float u, float v) -> float
+{
+    auto const fx = u * float(tex.width) - 0.5f;
+    auto const fy = v * float(tex.height) - 0.5f;
+    auto const x0 = int(std::floor(fx));
+    auto const y0 = int(std::floor(fy));
+    auto const ax = fx - float(x0);
+    auto const ay = fy - float(y0);
+    auto const at = [&](int x, int y) {
+        x = std::clamp(x, 0, tex.width - 1);
+        y = std::clamp(y, 0, tex.height - 1);
+        return float(tex.pixels[std::ptrdiff_t(y) * tex.stride + x * 4 + 3]) / 255.0f;
+    };
+    auto const top = at(x0, y0) * (1.0f - ax) + at(x0 + 1, y0) * ax;
+    auto const bottom = at(x0, y0 + 1) * (1.0f - ax) + at(x0 + 1, y0 + 1) * ax;
+    return top * (1.0f - ay) + bottom * ay;
+}
+
+// distance_coverage turns the distance field of tex at uv into coverage,
+// duv_dx and duv_dy are the texture coordinate steps of one pixel
+auto distance_coverage(
+    rgba_texture const& tex, ImVec2 const& uv, ImVec2 const& duv_dx, ImVec2 const& duv_dy) -> float
+{
+    auto const d = sample_alpha(tex, uv.x, uv.y);
+    auto const fw = std::abs(sample_alpha(tex, uv.x + duv_dx.x, uv.y + duv_dx.y) - d) +
+                    std::abs(sample_alpha(tex, uv.x + duv_dy.x, uv.y + duv_dy.y) - d);
+    return std::clamp((d - 0.5f) / std::max(fw, 1e-5f) + 0.5f, 0.0f, 1.0f);
+}
+
+void rasterize_coverage(ImDrawList const& dl, int w, int h, std::uint8_t* dst, int stride)
+{
+    auto shade = [&](int x, int y, ImDrawVert const& v0, ImDrawVert const& v1,
+                     ImDrawVert const& v2, float b0, float b1, float b2) {
+        auto const a = std::clamp(
+            b0 * alpha_of(v0.col) + b1 * alpha_of(v1.col) + b2 * alpha_of(v2.col), 0.0f, 255.0f);
+        auto& d = dst[y * stride + x];
+        d = std::uint8_t(std::lround(a + d * (255.0f - a) / 255.0f));
+    };
+
+    for (auto const& cmd : dl.CmdBuffer) {
+        if (!cmd.UserCallback && cmd.ElemCount)
+            rasterize_command(dl, cmd, {0.0f, 0.0f}, {1.0f, 1.0f}, w, h, shade);
+    }
+}
+
+void rasterize_overdraw(ImDrawList const& dl, ImVec2 const& origin, ImVec2 const& scale, int w,
+    int h, std::uint8_t* dst, int stride)
+{
+    auto shade = [&](int x, int y, ImDrawVert const&, ImDrawVert const&, ImDrawVert const&, float,
+                     float, float) {
+        auto& d = dst[std::ptrdiff_t(y) * stride + x];
+        if (d != 0xff)
+            ++d;
+    };
+
+    for (auto const& cmd : dl.CmdBuffer) {
+        if (!cmd.UserCallback && cmd.ElemCount)
+            rasterize_command(dl, cmd, origin, scale, w, h, shade);
+    }
+}
+
+void rasterize_rgba(ImDrawList const& dl, ImVec2 const& origin, ImVec2 const& scale, int w, int h,
+    std::uint8_t* dst, int stride, texture_lookup lookup)
+{
+    for (auto const& cmd : dl.CmdBuffer) {
+        if (cmd.UserCallback) {
+            if (cmd.UserCallback != ImDrawCallback_ResetRenderState)
+                cmd.UserCallback(&dl, &cmd);
+            continue;
+        }
+        if (!cmd.ElemCount)
+            continue;
+
+        auto const tex = lookup ? lookup(cmd.GetTexID()) : rgba_texture{};
+        auto const textured = tex.pixels && tex.width > 0 && tex.height > 0;
+
+        // the texture coordinate steps of one pixel are constant per triangle
+        auto const map = [&](ImVec2 const& p) {
+            return ImVec2{(p.x - origin.x) * scale.x, (p.y - origin.y) * scale.y};
+        };
+        auto const uv_steps = [&](ImDrawVert const& v0, ImDrawVert const& v1,
+                                  ImDrawVert const& v2, ImVec2& dx, ImVec2& dy) {
+            auto const p0 = map(v0.pos), p1 = map(v1.pos), p2 = map(v2.pos);
+            auto const e1 = ImVec2{p1.x - p0.x, p1.y - p0.y};
+            auto const e2 = ImVec2{p2.x - p0.x, p2.y - p0.y};
+            auto const t1 = ImVec2{v1.uv.x - v0.uv.x, v1.uv.y - v0.uv.y};
+            auto const t2 = ImVec2{v2.uv.x - v0.uv.x, v2.uv.y - v0.uv.y};
+            auto const inv = 1.0f / (e1.x * e2.y - e2.x * e1.y);
+            dx = {(t1.x * e2.y - t2.x * e1.y) * inv, (t1.y * e2.y - t2.y * e1.y) * inv};
+            dy = {(t2.x * e1.x - t1.x * e2.x) * inv, (t2.y * e1.x - t1.y * e2.x) * inv};
+        };
+
+        rasterize_command(dl, cmd, origin, scale, w, h,
+            [&](int x, int y, ImDrawVert const& v0, ImDrawVert const& v1, ImDrawVert const& v2,
+                float b0, float b1, float b2) {
+                auto interpolate = [&](int shift) {
+                    return b0 * channel(v0.col, shift) + b1 * channel(v1.col, shift) +
+                           b2 * channel(v2.col, shift);
+                };
+                float src[4] = {interpolate(IM_COL32_R_SHIFT), interpolate(IM_COL32_G_SHIFT),
+                    interpolate(IM_COL32_B_SHIFT), interpolate(IM_COL32_A_SHIFT)};
+
+                if (textured && tex.distance_field) {
+                    auto const uv = ImVec2{b0 * v0.uv.x + b1 * v1.uv.x + b2 * v2.uv.x,
+                        b0 * v0.uv.y + b1 * v1.uv.y + b2 * v2.uv.y};
+                    auto dx = ImVec2{}, dy = ImVec2{};
+                    uv_steps(v0, v1, v2, dx, dy);
+                    src[3] *= distance_coverage(tex, uv, dx, dy);
+                }
+                else if (textured) {
+                    auto const u = b0 * v0.uv.x + b1 * v1.uv.x + b2 * v2.uv.x;
+                    auto const v = b0 * v0.uv.y + b1 * v1.uv.y + b2 * v2.uv.y;
+                    auto const tx = std::clamp(int(u * float(tex.width)), 0, tex.width - 1);
+                    auto const ty = std::clamp(int(v * float(tex.height)), 0, tex.height - 1);
+                    auto const texel = tex.pixels + std::ptrdiff_t(ty) * tex.stride + tx * 4;
+                    for (auto c = 0; c < 4; ++c)
+                        src[c] = src[c] * float(texel[c]) / 255.0f;
+                }
+
+                auto const sa = std::clamp(src[3], 0.0f, 255.0f) / 255.0f;
+                auto d = dst + std::ptrdiff_t(y) * stride + x * 4;
+                for (auto c = 0; c < 3; ++c) {
+                    auto const r = src[c] * sa + float(d[c]) * (1.0f - sa);
+                    d[c] = std::uint8_t(std::lround(std::clamp(r, 0.0f, 255.0f)));
+                }
+                auto const a = src[3] + float(d[3]) * (1.0f - sa);
+                d[3] = std::uint8_t(std::lround(std::clamp(a, 0.0f, 255.0f)));
+            });
+    }
+}
+
+} // namespace ImPlus::internal
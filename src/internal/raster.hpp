@@ -0,0 +1,58 @@
+#pragma once
+
+#include <imgui.h>
+
+#include <cstdint>
+
+namespace ImPlus::internal {
+
+// rasterize_coverage renders the triangles of a draw list into an 8-bit
+// coverage mask
+//
+// - vertex positions are relative to the top-left corner of the mask
+// - vertex alpha is interpolated across each triangle (this is what produces
+//   anti-aliased fringes), vertex colors and texture coordinates are ignored
+// - coverage accumulates with "over" compositing, clip rectangles are honored
+//
+void rasterize_coverage(ImDrawList const& dl, int w, int h, std::uint8_t* dst, int stride);
+
+// rasterize_overdraw counts the fragments of each pixel into an 8-bit
+// saturating counter, positions and clip rectangles are mapped as with
+// rasterize_rgba, user callbacks are skipped
+void rasterize_overdraw(ImDrawList const& dl, ImVec2 const& origin, ImVec2 const& scale, int w,
+    int h, std::uint8_t* dst, int stride);
+
+// rgba_texture is a view of 8-bit RGBA pixels with straight alpha
+//
+// - distance_field textures hold signed distances in alpha, like the distance
+//   field font atlas, see Font::SetDistanceFieldAtlas
+//
+struct rgba_texture {
+    int width = 0;
+    int height = 0;
+    std::uint8_t const* pixels = nullptr;
+    int stride = 0; // bytes between rows
+    bool distance_field = false;
+};
+
+// texture_lookup returns the pixels of a texture id, null pixels sample white
+using texture_lookup = rgba_texture (*)(ImTextureID);
+
+// rasterize_rgba renders a draw list into an 8-bit RGBA image the way the GPU
+// backends do
+//
+// - positions and clip rectangles are mapped with (p - origin) * scale, as
+//   with ImDrawData::DisplayPos and FramebufferScale
+// - vertex colors and texture coordinates are interpolated, textures are
+//   sampled with the nearest texel
+// - distance field textures are sampled bilinearly and turn into coverage
+//   the way the distance field shaders do, with fwidth taken from the next
+//   pixels to the right and below
+// - colors are blended with SrcAlpha/OneMinusSrcAlpha, alpha with
+//   One/OneMinusSrcAlpha
+// - user callbacks are invoked, except ImDrawCallback_ResetRenderState
+//
+void rasterize_rgba(ImDrawList const& dl, ImVec2 const& origin, ImVec2 const& scale, int w, int h,
+    std::uint8_t* dst, int stride, texture_lookup lookup);
+
+} // namespace ImPlus::internal
@@ -0,0 +1,1114 @@
+#include "svg.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+namespace ImPlus::internal::svg {
+
+namespace {
+
+constexpr auto pi = 3.14159265358979f;
+constexpr auto kappa = 0.5522847f; // cubic approximation of a quarter circle
+
+struct affine {
+    float a = 1, b = 0, c = 0, d = 1, e = 0, f = 0;
+
+    auto operator()(ImVec2 const& p) const -> ImVec2
+    {
+        return {a * p.x + c * p.y + e, b * p.x + d * p.y + f};
+    }
+
+    // composition, m is applied first
+    auto operator*(affine const& m) const -> affine
+    {
+        return {a * m.a + c * m.b, b * m.a + d * m.b, a * m.c + c * m.d, b * m.c + d * m.d,
+            a * m.e + c * m.f + e, b * m.e + d * m.f + f};
+    }
+
+    auto scale() const -> float { return std::sqrt(std::abs(a * d - b * c)); }
+};
+
+inline auto is_space(char c) -> bool { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+inline auto is_digit(char c) -> bool { return c >= '0' && c <= '9'; }
+inline auto is_alpha(char c) -> bool { return std::isalpha((unsigned char)c) != 0; }
+
+inline auto trim(std::string_view s) -> std::string_view
+{
+    while (!s.empty() && is_space(s.front()))
+        s.remove_prefix(1);
+    while (!s.empty() && is_space(s.back()))
+        s.remove_suffix(1);
+    return s;
+}
+
+// scanner reads numbers from attribute values, locale independent
+struct scanner {
+    std::string_view s;
+    std::size_t pos = 0;
+
+    auto done() const -> bool { return pos >= s.size(); }
+    auto peek() const -> char { return done() ? '\0' : s[pos]; }
+
+    void skip_ws()
+    {
+        while (!done() && is_space(s[pos]))
+            ++pos;
+    }
+
+    void skip_sep()
+    {
+        skip_ws();
+        if (peek() == ',') {
+            ++pos;
+            skip_ws();
+        }
+    }
+
+    auto number(float& v) -> bool
+    {
+        skip_sep();
+        auto p = pos;
+        auto sign = 1.0;
+        if (p < s.size() && (s[p] == '+' || s[p] == '-'))
+            sign = s[p++] == '-' ? -1.0 : 1.0;
+
+        auto mantissa = 0.0;
+        auto digits = 0;
+        for (; p < s.size() && is_digit(s[p]); ++p, ++digits)
+            mantissa = mantissa * 10.0 + (s[p] - '0');
+        if (p < s.size() && s[p] == '.') {
+            auto f = 0.1;
+            for (++p; p < s.size() && is_digit(s[p]); ++p, ++digits, f *= 0.1)
+                mantissa += (s[p] - '0') * f;
+        }
+        if (!digits)
+            return false;
+
+        if (p < s.size() && (s[p] == 'e' || s[p] == 'E')) {
+            auto q = p + 1;
+            auto exp_sign = 1;
+            if (q < s.size() && (s[q] == '+' || s[q] == '-'))
+                exp_sign = s[q++] == '-' ? -1 : 1;
+            if (q < s.size() && is_digit(s[q])) {
+                auto exp = 0;
+                for (; q < s.size() && is_digit(s[q]); ++q)
+                    exp = std::min(exp * 10 + (s[q] - '0'), 300);
+                mantissa *= std::pow(10.0, exp_sign * exp);
+                p = q;
+            }
+        }
+
+        v = float(sign * mantissa);
+        pos = p;
+        return true;
+    }
+
+    // flag reads an arc flag, which may not be followed by a separator
+    auto flag(bool& v) -> bool
+    {
+        skip_sep();
+        if (peek() != '0' && peek() != '1')
+            return false;
+        v = s[pos++] == '1';
+        return true;
+    }
+};
+
+inline auto to_number(std::string_view s, float def) -> float
+{
+    auto sc = scanner{s};
+    auto v = def;
+    return sc.number(v) ? v : def;
+}
+
+struct path_builder {
+    path& out;
+    affine const& xf;
+
+    void move(ImVec2 const& p)
+    {
+        out.verbs.push_back(verb::move);
+        out.points.push_back(xf(p));
+    }
+    void line(ImVec2 const& p)
+    {
+        out.verbs.push_back(verb::line);
+        out.points.push_back(xf(p));
+    }
+    void cubic(ImVec2 const& c1, ImVec2 const& c2, ImVec2 const& p)
+    {
+        out.verbs.push_back(verb::cubic);
+        out.points.push_back(xf(c1));
+        out.points.push_back(xf(c2));
+        out.points.push_back(xf(p));
+    }
+    void close() { out.verbs.push_back(verb::close); }
+
+    void ellipse(float cx, float cy, float rx, float ry)
+    {
+        auto const kx = kappa * rx;
+        auto const ky = kappa * ry;
+        move({cx + rx, cy});
+        cubic({cx + rx, cy + ky}, {cx + kx, cy + ry}, {cx, cy + ry});
+        cubic({cx - kx, cy + ry}, {cx - rx, cy + ky}, {cx - rx, cy});
+        cubic({cx - rx, cy - ky}, {cx - kx, cy - ry}, {cx, cy - ry});
+        cubic({cx + kx, cy - ry}, {cx + rx, cy - ky}, {cx + rx, cy});
+        close();
+    }
+
+    // arc converts an elliptical arc (SVG implementation notes, F.6.5) into
+    // cubic segments of at most 90 degrees
+    void arc(ImVec2 const& p0, float rx, float ry, float angle, bool large, bool sweep,
+        ImVec2 const& p)
+    {
+        if (p0.x == p.x && p0.y == p.y)
+            return;
+        rx = std::abs(rx);
+        ry = std::abs(ry);
+        if (rx == 0.0f || ry == 0.0f) {
+            line(p);
+            return;
+        }
+
+        auto const phi = angle * pi / 180.0f;
+        auto const cos_phi = std::cos(phi);
+        auto const sin_phi = std::sin(phi);
+        auto const dx2 = (p0.x - p.x) * 0.5f;
+        auto const dy2 = (p0.y - p.y) * 0.5f;
+        auto const x1 = cos_phi * dx2 + sin_phi * dy2;
+        auto const y1 = -sin_phi * dx2 + cos_phi * dy2;
+
+        auto const lambda = (x1 * x1) / (rx * rx) + (y1 * y1) / (ry * ry);
+        if (lambda > 1.0f) {
+            rx *= std::sqrt(lambda);
+            ry *= std::sqrt(lambda);
+        }
+
+        auto const num = rx * rx * ry * ry - rx * rx * y1 * y1 - ry * ry * x1 * x1;
+        auto const den = rx * rx * y1 * y1 + ry * ry * x1 * x1;
+        auto coef = den > 0.0f ? std::sqrt(std::max(0.0f, num / den)) : 0.0f;
+        if (large == sweep)
+            coef = -coef;
+        auto const cx1 = coef * rx * y1 / ry;
+        auto const cy1 = -coef * ry * x1 / rx;
+        auto const cx = cos_phi * cx1 - sin_phi * cy1 + (p0.x + p.x) * 0.5f;
+        auto const cy = sin_phi * cx1 + cos_phi * cy1 + (p0.y + p.y) * 0.5f;
+
+        auto vector_angle = [](float ux, float uy, float vx, float vy) {
+            return std::atan2(ux * vy - uy * vx, ux * vx + uy * vy);
+        };
+        auto const ux = (x1 - cx1) / rx;
+        auto const uy = (y1 - cy1) / ry;
+        auto const theta = vector_angle(1.0f, 0.0f, ux, uy);
+        auto delta = vector_angle(ux, uy, (-x1 - cx1) / rx, (-y1 - cy1) / ry);
+        if (!sweep && delta > 0.0f)
+            delta -= 2.0f * pi;
+        else if (sweep && delta < 0.0f)
+            delta += 2.0f * pi;
+
+        auto const n = std::max(1, int(std::ceil(std::abs(delta) / (0.5f * pi) - 1e-3f)));
+        auto const step = delta / float(n);
+        auto const k = 4.0f / 3.0f * std::tan(step * 0.25f);
+
+        auto point = [&](float t) {
+            return ImVec2{cx + rx * std::cos(t) * cos_phi - ry * std::sin(t) * sin_phi,
+                cy + rx * std::cos(t) * sin_phi + ry * std::sin(t) * cos_phi};
+        };
+        auto tangent = [&](float t) {
+            return ImVec2{-rx * std::sin(t) * cos_phi - ry * std::cos(t) * sin_phi,
+                -rx * std::sin(t) * sin_phi + ry * std::cos(t) * cos_phi};
+        };
+
+        for (auto i = 0; i < n; ++i) {
+            auto const t1 = theta + step * float(i);
+            auto const t2 = t1 + step;
+            auto const a = point(t1);
+            auto const da = tangent(t1);
+            auto const b = i + 1 == n ? p : point(t2);
+            auto const db = tangent(t2);
+            cubic({a.x + k * da.x, a.y + k * da.y}, {b.x - k * db.x, b.y - k * db.y}, b);
+        }
+    }
+};
+
+void parse_path_data(std::string_view d, path_builder& pb)
+{
+    auto sc = scanner{d};
+    auto cmd = char{0};
+    auto prev = char{0};
+    auto cur = ImVec2{0, 0};
+    auto start = cur;
+    auto ctrl = cur; // last control point, for the smooth curve commands
+
+    auto reflect = [&](char a, char b) {
+        return prev == a || prev == b ? ImVec2{2 * cur.x - ctrl.x, 2 * cur.y - ctrl.y} : cur;
+    };
+
+    while (true) {
+        sc.skip_sep();
+        if (sc.done())
+            break;
+        if (is_alpha(sc.peek()))
+            cmd = d[sc.pos++];
+        else if (!cmd)
+            break;
+
+        auto const rel = std::islower((unsigned char)cmd) != 0;
+        auto const op = char(std::toupper((unsigned char)cmd));
+        auto const base = rel ? cur : ImVec2{0, 0};
+        auto pt = [&](ImVec2& p) {
+            if (!sc.number(p.x) || !sc.number(p.y))
+                return false;
+            p.x += base.x;
+            p.y += base.y;
+            return true;
+        };
+
+        switch (op) {
+        case 'M': {
+            auto p = ImVec2{};
+            if (!pt(p))
+                return;
+            pb.move(p);
+            cur = start = ctrl = p;
+            cmd = rel ? 'l' : 'L'; // subsequent pairs are lines
+        } break;
+
+        case 'L': {
+            auto p = ImVec2{};
+            if (!pt(p))
+                return;
+            pb.line(p);
+            cur = ctrl = p;
+        } break;
+
+        case 'H':
+        case 'V': {
+            auto v = 0.0f;
+            if (!sc.number(v))
+                return;
+            if (op == 'H')
+                cur.x = rel ? cur.x + v : v;
+            else
+                cur.y = rel ? cur.y + v : v;
+            pb.line(cur);
+            ctrl = cur;
+        } break;
+
+        case 'C':
+        case 'S': {
+            auto c1 = ImVec2{};
+            auto c2 = ImVec2{};
+            auto p = ImVec2{};
+            if (op == 'S')
+                c1 = reflect('C', 'S');
+            else if (!pt(c1))
+                return;
+            if (!pt(c2) || !pt(p))
+                return;
+            pb.cubic(c1, c2, p);
+            ctrl = c2;
+            cur = p;
+        } break;
+
+        case 'Q':
+        case 'T': {
+            auto q = ImVec2{};
+            auto p = ImVec2{};
+            if (op == 'T')
+                q = reflect('Q', 'T');
+            else if (!pt(q))
+                return;
+            if (!pt(p))
+                return;
+            pb.cubic({cur.x + 2.0f / 3.0f * (q.x - cur.x), cur.y + 2.0f / 3.0f * (q.y - cur.y)},
+                {p.x + 2.0f / 3.0f * (q.x - p.x), p.y + 2.0f / 3.0f * (q.y - p.y)}, p);
+            ctrl = q;
+            cur = p;
+        } break;
+
+        case 'A': {
+            auto rx = 0.0f;
+            auto ry = 0.0f;
+            auto angle = 0.0f;
+            auto large = false;
+            auto sweep = false;
+            auto p = ImVec2{};
+            if (!sc.number(rx) || !sc.number(ry) || !sc.number(angle) || !sc.flag(large) ||
+                !sc.flag(sweep) || !pt(p))
+                return;
+            pb.arc(cur, rx, ry, angle, large, sweep, p);
+            cur = ctrl = p;
+        } break;
+
+        case 'Z': {
+            pb.close();
+            cur = ctrl = start;
+            cmd = 0; // numbers after Z are an error
+        } break;
+
+        default: return;
+        }
+        prev = op;
+    }
+}
+
+auto parse_transform(std::string_view v) -> affine
+{
+    auto m = affine{};
+    auto sc = scanner{v};
+    while (true) {
+        sc.skip_sep();
+        auto const name_begin = sc.pos;
+        while (!sc.done() && is_alpha(sc.peek()))
+            ++sc.pos;
+        auto const name = v.substr(name_begin, sc.pos - name_begin);
+        sc.skip_ws();
+        if (name.empty() || sc.peek() != '(')
+            break;
+        ++sc.pos;
+
+        float a[6] = {};
+        auto n = 0;
+        while (n < 6 && sc.number(a[n]))
+            ++n;
+        sc.skip_ws();
+        if (sc.peek() != ')')
+            break;
+        ++sc.pos;
+
+        auto t = affine{};
+        if (name == "matrix" && n == 6)
+            t = affine{a[0], a[1], a[2], a[3], a[4], a[5]};
+        else if (name == "translate" && n >= 1)
+            t = affine{1, 0, 0, 1, a[0], n > 1 ? a[1] : 0.0f};
+        else if (name == "scale" && n >= 1)
+            t = affine{a[0], 0, 0, n > 1 ? a[1] : a[0], 0, 0};
+        else if (name == "rotate" && n >= 1) {
+            auto const r = a[0] * pi / 180.0f;
+            auto const c = std::cos(r);
+            auto const s = std::sin(r);
+            t = affine{c, s, -s, c, 0, 0};
+            if (n == 3)
+                t = affine{1, 0, 0, 1, a[1], a[2]} * t * affine{1, 0, 0, 1, -a[1], -a[2]};
+        }
+        else if (name == "skewX" && n == 1)
+            t.c = std::tan(a[0] * pi / 180.0f);
+        else if (name == "skewY" && n == 1)
+            t.b = std::tan(a[0] * pi / 180.0f);
+        m = m * t;
+    }
+    return m;
+}
+
+struct named_color {
+    std::string_view name;
+    ImU32 rgb;
+};
+
+constexpr auto named_colors = std::array{
+    named_color{"black", 0x000000},
+    named_color{"white", 0xffffff},
+    named_color{"red", 0xff0000},
+    named_color{"lime", 0x00ff00},
+    named_color{"green", 0x008000},
+    named_color{"blue", 0x0000ff},
+    named_color{"yellow", 0xffff00},
+    named_color{"cyan", 0x00ffff},
+    named_color{"aqua", 0x00ffff},
+    named_color{"magenta", 0xff00ff},
+    named_color{"fuchsia", 0xff00ff},
+    named_color{"gray", 0x808080},
+    named_color{"grey", 0x808080},
+    named_color{"silver", 0xc0c0c0},
+    named_color{"orange", 0xffa500},
+};
+
+inline auto from_rgb(ImU32 rgb) -> ImVec4
+{
+    return {float((rgb >> 16) & 0xff) / 255.0f, float((rgb >> 8) & 0xff) / 255.0f,
+        float(rgb & 0xff) / 255.0f, 1.0f};
+}
+
+inline auto hex_digit(char c) -> int
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+auto parse_paint(std::string_view v) -> paint
+{
+    v = trim(v);
+    if (v == "none" || v == "transparent")
+        return paint{paint::none};
+
+    if (v.size() > 1 && v[0] == '#') {
+        auto rgb = ImU32{0};
+        auto const hex = v.substr(1);
+        if (hex.size() != 3 && hex.size() != 6)
+            return paint{paint::current_color};
+        for (auto c : hex) {
+            auto const x = hex_digit(c);
+            if (x < 0)
+                return paint{paint::current_color};
+            rgb = hex.size() == 3 ? (rgb << 8) | ImU32(x * 17) : (rgb << 4) | ImU32(x);
+        }
+        return paint{paint::color, from_rgb(rgb)};
+    }
+
+    if (v.starts_with("rgb(")) {
+        auto sc = scanner{v.substr(4)};
+        float c[3] = {};
+        for (auto& x : c) {
+            if (!sc.number(x))
+                return paint{paint::current_color};
+            if (sc.peek() == '%') {
+                ++sc.pos;
+                x *= 2.55f;
+            }
+        }
+        return paint{paint::color, ImVec4{std::clamp(c[0] / 255.0f, 0.0f, 1.0f),
+                                       std::clamp(c[1] / 255.0f, 0.0f, 1.0f),
+                                       std::clamp(c[2] / 255.0f, 0.0f, 1.0f), 1.0f}};
+    }
+
+    for (auto const& nc : named_colors)
+        if (nc.name == v)
+            return paint{paint::color, from_rgb(nc.rgb)};
+
+    // currentColor, gradients and anything else we don't support
+    return paint{paint::current_color};
+}
+
+struct style {
+    paint fill = {paint::current_color};
+    paint stroke = {paint::none};
+    float opacity = 1.0f;
+    float fill_opacity = 1.0f;
+    float stroke_opacity = 1.0f;
+    float stroke_width = 1.0f;
+    bool even_odd = false;
+    bool hidden = false;
+    affine xf = {};
+};
+
+void apply_property(style& st, std::string_view name, std::string_view value)
+{
+    value = trim(value);
+    if (value == "inherit")
+        return;
+
+    if (name == "fill")
+        st.fill = parse_paint(value);
+    else if (name == "stroke")
+        st.stroke = parse_paint(value);
+    else if (name == "stroke-width")
+        st.stroke_width = std::max(0.0f, to_number(value, st.stroke_width));
+    else if (name == "fill-rule")
+        st.even_odd = value == "evenodd";
+    else if (name == "opacity")
+        st.opacity *= std::clamp(to_number(value, 1.0f), 0.0f, 1.0f);
+    else if (name == "fill-opacity")
+        st.fill_opacity = std::clamp(to_number(value, 1.0f), 0.0f, 1.0f);
+    else if (name == "stroke-opacity")
+        st.stroke_opacity = std::clamp(to_number(value, 1.0f), 0.0f, 1.0f);
+    else if (name == "display")
+        st.hidden = value == "none";
+}
+
+struct element {
+    std::string_view name;
+    std::vector<std::pair<std::string_view, std::string_view>> attributes;
+    bool self_closing = false;
+
+    auto attr(std::string_view n) const -> std::optional<std::string_view>
+    {
+        for (auto const& [k, v] : attributes)
+            if (k == n)
+                return v;
+        return std::nullopt;
+    }
+    auto number(std::string_view n, float def = 0.0f) const -> float
+    {
+        auto v = attr(n);
+        return v ? to_number(*v, def) : def;
+    }
+};
+
+void apply_attributes(element const& e, style& st)
+{
+    // presentation attributes first, style declarations take precedence
+    for (auto const& [k, v] : e.attributes) {
+        if (k == "transform")
+            st.xf = st.xf * parse_transform(v);
+        else if (k != "style")
+            apply_property(st, k, v);
+    }
+
+    if (auto decl = e.attr("style")) {
+        auto s = *decl;
+        while (!s.empty()) {
+            auto const end = s.find(';');
+            auto const item = s.substr(0, end);
+            if (auto const colon = item.find(':'); colon != item.npos)
+                apply_property(st, trim(item.substr(0, colon)), item.substr(colon + 1));
+            s = end == s.npos ? std::string_view{} : s.substr(end + 1);
+        }
+    }
+}
+
+// parse_element reads a start tag at pos (pointing to '<'), returns the
+// position after the tag
+auto parse_element(std::string_view s, std::size_t pos, element& e) -> std::size_t
+{
+    auto p = pos + 1;
+    auto const name_begin = p;
+    while (p < s.size() && !is_space(s[p]) && s[p] != '/' && s[p] != '>')
+        ++p;
+    e.name = s.substr(name_begin, p - name_begin);
+
+    while (p < s.size()) {
+        while (p < s.size() && is_space(s[p]))
+            ++p;
+        if (p >= s.size())
+            break;
+        if (s[p] == '>')
+            return p + 1;
+        if (s[p] == '/') {
+            e.self_closing = true;
+            auto const end = s.find('>', p);
+            return end == s.npos ? s.size() : end + 1;
+        }
+
+        auto const key_begin = p;
+        while (p < s.size() && !is_space(s[p]) && s[p] != '=' && s[p] != '>' && s[p] != '/')
+            ++p;
+        auto const key = s.substr(key_begin, p - key_begin);
+        while (p < s.size() && is_space(s[p]))
+            ++p;
+        if (p >= s.size() || s[p] != '=') {
+            if (key.empty())
+                ++p;
+            continue; // attribute without value
+        }
+        ++p;
+        while (p < s.size() && is_space(s[p]))
+            ++p;
+        if (p >= s.size() || (s[p] != '"' && s[p] != '\''))
+            break;
+        auto const quote = s[p++];
+        auto const end = s.find(quote, p);
+        if (end == s.npos)
+            break;
+        e.attributes.emplace_back(key, s.substr(p, end - p));
+        p = end + 1;
+    }
+    throw std::runtime_error("svg: unterminated element");
+}
+
+inline auto is_skipped_container(std::string_view name) -> bool
+{
+    return name == "defs" || name == "symbol" || name == "clipPath" || name == "mask" ||
+           name == "linearGradient" || name == "radialGradient" || name == "pattern" ||
+           name == "style" || name == "title" || name == "desc" || name == "metadata" ||
+           name == "text";
+}
+
+void emit_shape(element const& e, style const& st, document& doc)
+{
+    if (st.hidden || (st.fill.kind == paint::none && st.stroke.kind == paint::none))
+        return;
+
+    auto sh = shape{};
+    auto pb = path_builder{sh.geometry, st.xf};
+
+    if (e.name == "path") {
+        if (auto d = e.attr("d"))
+            parse_path_data(*d, pb);
+    }
+    else if (e.name == "rect") {
+        auto const x = e.number("x");
+        auto const y = e.number("y");
+        auto const w = e.number("width");
+        auto const h = e.number("height");
+        if (w <= 0.0f || h <= 0.0f)
+            return;
+        auto rx = e.number("rx", -1.0f);
+        auto ry = e.number("ry", -1.0f);
+        if (rx < 0.0f)
+            rx = std::max(ry, 0.0f);
+        if (ry < 0.0f)
+            ry = rx;
+        rx = std::min(rx, w * 0.5f);
+        ry = std::min(ry, h * 0.5f);
+
+        if (rx > 0.0f && ry > 0.0f) {
+            auto const kx = kappa * rx;
+            auto const ky = kappa * ry;
+            pb.move({x + rx, y});
+            pb.line({x + w - rx, y});
+            pb.cubic({x + w - rx + kx, y}, {x + w, y + ry - ky}, {x + w, y + ry});
+            pb.line({x + w, y + h - ry});
+            pb.cubic({x + w, y + h - ry + ky}, {x + w - rx + kx, y + h}, {x + w - rx, y + h});
+            pb.line({x + rx, y + h});
+            pb.cubic({x + rx - kx, y + h}, {x, y + h - ry + ky}, {x, y + h - ry});
+            pb.line({x, y + ry});
+            pb.cubic({x, y + ry - ky}, {x + rx - kx, y}, {x + rx, y});
+        }
+        else {
+            pb.move({x, y});
+            pb.line({x + w, y});
+            pb.line({x + w, y + h});
+            pb.line({x, y + h});
+        }
+        pb.close();
+    }
+    else if (e.name == "circle") {
+        auto const r = e.number("r");
+        if (r <= 0.0f)
+            return;
+        pb.ellipse(e.number("cx"), e.number("cy"), r, r);
+    }
+    else if (e.name == "ellipse") {
+        auto const rx = e.number("rx");
+        auto const ry = e.number("ry");
+        if (rx <= 0.0f || ry <= 0.0f)
+            return;
+        pb.ellipse(e.number("cx"), e.number("cy"), rx, ry);
+    }
+    else if (e.name == "line") {
+        pb.move({e.number("x1"), e.number("y1")});
+        pb.line({e.number("x2"), e.number("y2")});
+    }
+    else if (e.name == "polyline" || e.name == "polygon") {
+        auto sc = scanner{e.attr("points").value_or(std::string_view{})};
+        auto p = ImVec2{};
+        for (auto first = true; sc.number(p.x) && sc.number(p.y); first = false) {
+            if (first)
+                pb.move(p);
+            else
+                pb.line(p);
+        }
+        if (e.name == "polygon" && !sh.geometry.verbs.empty())
+            pb.close();
+    }
+    else {
+        return;
+    }
+
+    if (sh.geometry.verbs.empty())
+        return;
+
+    sh.fill = st.fill;
+    sh.stroke = st.stroke;
+    sh.fill_opacity = st.opacity * st.fill_opacity;
+    sh.stroke_opacity = st.opacity * st.stroke_opacity;
+    sh.stroke_width = st.stroke_width * st.xf.scale();
+    sh.even_odd = st.even_odd;
+    if (sh.fill.kind == paint::color || sh.stroke.kind == paint::color)
+        doc.monochrome = false;
+    doc.shapes.push_back(std::move(sh));
+}
+
+void setup_viewport(element const& e, document& doc)
+{
+    if (auto vb = e.attr("viewBox")) {
+        auto sc = scanner{*vb};
+        float v[4] = {};
+        if (sc.number(v[0]) && sc.number(v[1]) && sc.number(v[2]) && sc.number(v[3])) {
+            doc.origin = {v[0], v[1]};
+            doc.size = {v[2], v[3]};
+        }
+    }
+    if (doc.size.x <= 0.0f || doc.size.y <= 0.0f)
+        doc.size = {e.number("width"), e.number("height")};
+    if (doc.size.x <= 0.0f || doc.size.y <= 0.0f)
+        throw std::runtime_error("svg: missing viewBox or size");
+}
+
+} // namespace
+
+auto parse(std::string_view text) -> document
+{
+    auto doc = document{};
+    auto stack = std::vector<style>{style{}};
+    auto skip_depth = 0;
+    auto found_svg = false;
+    auto pos = std::size_t{0};
+
+    auto skip_past = [&](std::string_view terminator) {
+        auto const end = text.find(terminator, pos);
+        pos = end == text.npos ? text.size() : end + terminator.size();
+    };
+
+    while ((pos = text.find('<', pos)) != text.npos) {
+        auto const rest = text.substr(pos);
+        if (rest.starts_with("<!--"))
+            skip_past("-->");
+        else if (rest.starts_with("<?"))
+            skip_past("?>");
+        else if (rest.starts_with("<![CDATA["))
+            skip_past("]]>");
+        else if (rest.starts_with("<!"))
+            skip_past(">");
+        else if (rest.starts_with("</")) {
+            skip_past(">");
+            if (skip_depth)
+                --skip_depth;
+            else if (stack.size() > 1)
+                stack.pop_back();
+        }
+        else {
+            auto e = element{};
+            pos = parse_element(text, pos, e);
+
+            if (skip_depth) {
+                if (!e.self_closing)
+                    ++skip_depth;
+                continue;
+            }
+            if (is_skipped_container(e.name)) {
+                if (!e.self_closing)
+                    skip_depth = 1;
+                continue;
+            }
+            if (!found_svg && e.name != "svg")
+                throw std::runtime_error("svg: missing svg element");
+
+            auto st = stack.back();
+            apply_attributes(e, st);
+            if (e.name == "svg" && !found_svg) {
+                found_svg = true;
+                setup_viewport(e, doc);
+            }
+            else {
+                emit_shape(e, st, doc);
+            }
+            if (!e.self_closing)
+                stack.push_back(st);
+        }
+    }
+
+    if (!found_svg)
+        throw std::runtime_error("svg: missing svg element");
+    return doc;
+}
+
+namespace {
+
+using contour = std::vector<ImVec2>;
+
+constexpr auto tolerance = 0.2f; // flattening tolerance, in pixels
+constexpr auto subsamples = 4;   // scanlines per pixel row
+
+void flatten_cubic(ImVec2 const& p0, ImVec2 const& p1, ImVec2 const& p2, ImVec2 const& p3,
+    contour& out)
+{
+    // Wang's formula
+    auto const ax = p0.x - 2 * p1.x + p2.x;
+    auto const ay = p0.y - 2 * p1.y + p2.y;
+    auto const bx = p1.x - 2 * p2.x + p3.x;
+    auto const by = p1.y - 2 * p2.y + p3.y;
+    auto const dd = std::sqrt(std::max(ax * ax + ay * ay, bx * bx + by * by));
+    auto const n = std::clamp(int(std::ceil(std::sqrt(0.75f * dd / tolerance))), 1, 100);
+
+    for (auto i = 1; i <= n; ++i) {
+        auto const t = float(i) / float(n);
+        auto const u = 1.0f - t;
+        auto const w0 = u * u * u;
+        auto const w1 = 3 * u * u * t;
+        auto const w2 = 3 * u * t * t;
+        auto const w3 = t * t * t;
+        out.push_back({w0 * p0.x + w1 * p1.x + w2 * p2.x + w3 * p3.x,
+            w0 * p0.y + w1 * p1.y + w2 * p2.y + w3 * p3.y});
+    }
+}
+
+// flatten converts a path into polylines in pixel coordinates
+void flatten(path const& p, affine const& xf, std::vector<contour>& out, std::vector<bool>& closed)
+{
+    out.clear();
+    closed.clear();
+
+    auto pen = ImVec2{};
+    auto start = ImVec2{};
+    auto open = false;
+    auto begin = [&](ImVec2 const& at) {
+        out.emplace_back().push_back(at);
+        closed.push_back(false);
+        start = pen = at;
+        open = true;
+    };
+
+    auto pt = p.points.data();
+    for (auto v : p.verbs) {
+        switch (v) {
+        case verb::move: begin(xf(*pt++)); break;
+
+        case verb::line: {
+            if (!open)
+                begin(pen);
+            pen = xf(*pt++);
+            out.back().push_back(pen);
+        } break;
+
+        case verb::cubic: {
+            if (!open)
+                begin(pen);
+            auto const c1 = xf(pt[0]);
+            auto const c2 = xf(pt[1]);
+            auto const p3 = xf(pt[2]);
+            pt += 3;
+            flatten_cubic(pen, c1, c2, p3, out.back());
+            pen = p3;
+        } break;
+
+        case verb::close: {
+            if (open)
+                closed.back() = true;
+            open = false;
+            pen = start;
+        } break;
+        }
+    }
+}
+
+inline auto signed_area(contour const& c) -> float
+{
+    auto a = 0.0f;
+    for (std::size_t i = 0, n = c.size(); i < n; ++i) {
+        auto const& p = c[i];
+        auto const& q = c[(i + 1) % n];
+        a += p.x * q.y - q.x * p.y;
+    }
+    return a * 0.5f;
+}
+
+// outline_stroke converts polylines into polygons of the same orientation,
+// filled with the nonzero rule their union is the stroke: a quad per segment
+// and a disc at ends and joints
+void outline_stroke(std::vector<contour> const& lines, std::vector<bool> const& closed, float r,
+    std::vector<contour>& out)
+{
+    out.clear();
+    auto add = [&](contour&& c) {
+        if (signed_area(c) < 0.0f)
+            std::reverse(c.begin(), c.end());
+        out.push_back(std::move(c));
+    };
+
+    auto const disc_segments = std::clamp(int(std::ceil(r * 2.0f)), 8, 48);
+    auto disc = [&](ImVec2 const& at) {
+        auto c = contour{};
+        c.reserve(disc_segments);
+        for (auto i = 0; i < disc_segments; ++i) {
+            auto const a = 2.0f * pi * float(i) / float(disc_segments);
+            c.push_back({at.x + r * std::cos(a), at.y + r * std::sin(a)});
+        }
+        add(std::move(c));
+    };
+
+    for (std::size_t l = 0; l < lines.size(); ++l) {
+        auto const& pts = lines[l];
+        auto const n = pts.size();
+        auto const is_closed = closed[l] && n > 2;
+        if (n == 1) {
+            disc(pts[0]);
+            continue;
+        }
+
+        auto const segments = is_closed ? n : n - 1;
+        for (std::size_t i = 0; i < segments; ++i) {
+            auto const& a = pts[i];
+            auto const& b = pts[(i + 1) % n];
+            auto const dx = b.x - a.x;
+            auto const dy = b.y - a.y;
+            auto const len = std::sqrt(dx * dx + dy * dy);
+            if (len == 0.0f)
+                continue;
+            auto const nx = -dy / len * r;
+            auto const ny = dx / len * r;
+            add(contour{{a.x + nx, a.y + ny}, {b.x + nx, b.y + ny}, {b.x - nx, b.y - ny},
+                {a.x - nx, a.y - ny}});
+        }
+
+        // joints with a noticeable turn, and caps
+        for (std::size_t i = 0; i < n; ++i) {
+            auto const is_end = !is_closed && (i == 0 || i + 1 == n);
+            if (!is_end) {
+                auto const& a = pts[(i + n - 1) % n];
+                auto const& b = pts[i];
+                auto const& c = pts[(i + 1) % n];
+                auto const ux = b.x - a.x;
+                auto const uy = b.y - a.y;
+                auto const vx = c.x - b.x;
+                auto const vy = c.y - b.y;
+                auto const lu = std::sqrt(ux * ux + uy * uy);
+                auto const lv = std::sqrt(vx * vx + vy * vy);
+                if (lu > 0.0f && lv > 0.0f && (ux * vx + uy * vy) / (lu * lv) > 0.995f)
+                    continue;
+            }
+            disc(pts[i]);
+        }
+    }
+}
+
+struct edge {
+    float x0, y0, x1, y1;
+    int dir;
+};
+
+// fill_coverage accumulates the coverage of the polygons, with exact
+// horizontal coverage and a number of scanlines per pixel row
+void fill_coverage(
+    std::vector<contour> const& polys, bool even_odd, int w, int h, std::vector<float>& cov)
+{
+    cov.assign(std::size_t(w) * h, 0.0f);
+
+    auto edges = std::vector<edge>{};
+    auto y_min = float(h);
+    auto y_max = 0.0f;
+    for (auto const& c : polys) {
+        for (std::size_t i = 0, n = c.size(); i < n; ++i) {
+            auto a = c[i];
+            auto b = c[(i + 1) % n];
+            if (a.y == b.y)
+                continue;
+            auto dir = 1;
+            if (a.y > b.y) {
+                std::swap(a, b);
+                dir = -1;
+            }
+            edges.push_back(edge{a.x, a.y, b.x, b.y, dir});
+            y_min = std::min(y_min, a.y);
+            y_max = std::max(y_max, b.y);
+        }
+    }
+    if (edges.empty())
+        return;
+    std::sort(edges.begin(), edges.end(), [](edge const& a, edge const& b) { return a.y0 < b.y0; });
+
+    auto active = std::vector<edge const*>{};
+    auto crossings = std::vector<std::pair<float, int>>{};
+    auto next = std::size_t{0};
+    auto const weight = 1.0f / float(subsamples);
+
+    auto add_span = [&](float* row, float xa, float xb) {
+        xa = std::max(xa, 0.0f);
+        xb = std::min(xb, float(w));
+        if (xb <= xa)
+            return;
+        auto const ia = int(xa);
+        auto const ib = int(xb);
+        if (ia == ib) {
+            row[ia] += (xb - xa) * weight;
+            return;
+        }
+        row[ia] += (float(ia + 1) - xa) * weight;
+        for (auto i = ia + 1; i < ib; ++i)
+            row[i] += weight;
+        if (ib < w)
+            row[ib] += (xb - float(ib)) * weight;
+    };
+
+    auto const row_begin = std::max(0, int(std::floor(y_min)));
+    auto const row_end = std::min(h, int(std::ceil(y_max)));
+    for (auto y = row_begin; y < row_end; ++y) {
+        auto row = cov.data() + std::size_t(y) * w;
+        for (auto s = 0; s < subsamples; ++s) {
+            auto const sy = float(y) + (float(s) + 0.5f) * weight;
+            while (next < edges.size() && edges[next].y0 <= sy)
+                active.push_back(&edges[next++]);
+            std::erase_if(active, [sy](edge const* e) { return e->y1 <= sy; });
+
+            crossings.clear();
+            for (auto e : active)
+                crossings.emplace_back(
+                    e->x0 + (sy - e->y0) * (e->x1 - e->x0) / (e->y1 - e->y0), e->dir);
+            std::sort(crossings.begin(), crossings.end());
+
+            auto winding = 0;
+            for (std::size_t i = 0; i + 1 < crossings.size(); ++i) {
+                winding += crossings[i].second;
+                auto const inside = even_odd ? (winding & 1) != 0 : winding != 0;
+                if (inside)
+                    add_span(row, crossings[i].first, crossings[i + 1].first);
+            }
+        }
+    }
+}
+
+// composite blends a solid color with the coverage over premultiplied pixels
+void composite(std::vector<float> const& cov, paint const& p, float opacity, std::vector<ImVec4>& dst)
+{
+    auto const c = p.kind == paint::color ? p.rgba : ImVec4{1, 1, 1, 1};
+    auto const alpha = c.w * opacity;
+    for (std::size_t i = 0; i < dst.size(); ++i) {
+        auto const a = std::min(cov[i], 1.0f) * alpha;
+        if (a <= 0.0f)
+            continue;
+        auto& d = dst[i];
+        auto const k = 1.0f - a;
+        d = ImVec4{c.x * a + d.x * k, c.y * a + d.y * k, c.z * a + d.z * k, a + d.w * k};
+    }
+}
+
+} // namespace
+
+void rasterize(document const& doc, int w, int h, std::uint8_t* rgba, int stride)
+{
+    if (w <= 0 || h <= 0 || doc.size.x <= 0.0f || doc.size.y <= 0.0f)
+        return;
+
+    auto const scale = std::min(float(w) / doc.size.x, float(h) / doc.size.y);
+    auto const to_px = affine{scale, 0, 0, scale,
+        (float(w) - doc.size.x * scale) * 0.5f - doc.origin.x * scale,
+        (float(h) - doc.size.y * scale) * 0.5f - doc.origin.y * scale};
+
+    auto pixels = std::vector<ImVec4>(std::size_t(w) * h, ImVec4{0, 0, 0, 0});
+    auto lines = std::vector<contour>{};
+    auto closed = std::vector<bool>{};
+    auto outline = std::vector<contour>{};
+    auto cov = std::vector<float>{};
+
+    for (auto const& sh : doc.shapes) {
+        flatten(sh.geometry, to_px, lines, closed);
+
+        if (sh.fill.kind != paint::none && sh.fill_opacity > 0.0f) {
+            fill_coverage(lines, sh.even_odd, w, h, cov);
+            composite(cov, sh.fill, sh.fill_opacity, pixels);
+        }
+
+        auto const r = sh.stroke_width * scale * 0.5f;
+        if (sh.stroke.kind != paint::none && sh.stroke_opacity > 0.0f && r > 0.0f) {
+            outline_stroke(lines, closed, r, outline);
+            fill_coverage(outline, false, w, h, cov);
+            composite(cov, sh.stroke, sh.stroke_opacity, pixels);
+        }
+    }
+
+    for (auto y = 0; y < h; ++y) {
+        auto dst = rgba + std::size_t(y) * stride;
+        auto src = pixels.data() + std::size_t(y) * w;
+        for (auto x = 0; x < w; ++x, ++src, dst += 4) {
+            auto const a = src->w;
+            auto const k = a > 0.0f ? 255.0f / a : 0.0f;
+            dst[0] = std::uint8_t(std::lround(std::clamp(src->x * k, 0.0f, 255.0f)));
+            dst[1] = std::uint8_t(std::lround(std::clamp(src->y * k, 0.0f, 255.0f)));
+            dst[2] = std::uint8_t(std::lround(std::clamp(src->z * k, 0.0f, 255.0f)));
+            dst[3] = std::uint8_t(std::lround(std::clamp(a * 255.0f, 0.0f, 255.0f)));
+        }
+    }
+}
+
+} // namespace ImPlus::internal::svg
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <imgui.h>
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace ImPlus::internal::svg {
+
+enum class verb : std::uint8_t {
+    move,  // 1 point
+    line,  // 1 point
+    cubic, // 3 points
+    close,
+};
+
+struct path {
+    std::vector<verb> verbs;
+    std::vector<ImVec2> points;
+};
+
+struct paint {
+    enum kind_type : std::uint8_t {
+        none,
+        current_color,
+        color,
+    };
+    kind_type kind = none;
+    ImVec4 rgba = {1, 1, 1, 1}; // for color
+};
+
+// shape is a path in document (viewBox) coordinates with transforms applied
+struct shape {
+    path geometry;
+    paint fill;
+    paint stroke;
+    float fill_opacity = 1.0f; // includes opacity
+    float stroke_opacity = 1.0f;
+    float stroke_width = 1.0f;
+    bool even_odd = false;
+};
+
+struct document {
+    ImVec2 origin = {0, 0}; // viewBox
+    ImVec2 size = {0, 0};
+    std::vector<shape> shapes;
+    bool monochrome = true; // no explicit colors, only currentColor
+};
+
+// parse reads the supported subset of SVG, throws std::runtime_error if the
+// text is not an SVG document
+//
+// - elements: svg, g, path, rect, circle, ellipse, line, polyline, polygon,
+//   contents of defs, symbol, clipPath, mask and gradients are skipped
+// - presentation attributes and style declarations: fill, stroke,
+//   stroke-width, fill-rule, opacity, fill-opacity, stroke-opacity, display
+// - unspecified fills are currentColor, unsupported paints (gradients) fall
+//   back to currentColor
+//
+auto parse(std::string_view text) -> document;
+
+// rasterize renders the document into w * h RGBA pixels (straight alpha)
+//
+// - the viewBox is centered and scaled to fit (xMidYMid meet)
+// - currentColor is rendered white so that the result can be tinted
+// - strokes use round joins and caps, opacity is applied per shape
+//
+void rasterize(document const& doc, int w, int h, std::uint8_t* rgba, int stride);
+
+} // namespace ImPlus::internal::svg
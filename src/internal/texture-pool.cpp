@@ -0,0 +1,91 @@
+#include "texture-pool.hpp"
+
+#include <implus/render-device.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+namespace ImPlus::internal {
+
+struct texture_pool {
+    struct texture {
+        texture_owner* owner = nullptr;
+        std::size_t bytes = 0;
+    };
+
+    std::unordered_map<ImTextureID, texture> textures;
+    std::vector<texture_owner*> owners;
+    std::size_t bytes = 0;
+
+    void destroy(ImTextureID tex)
+    {
+        auto it = textures.find(tex);
+        if (it == textures.end())
+            return;
+        bytes -= it->second.bytes;
+        textures.erase(it);
+        Render::DestroyTexture(tex);
+    }
+};
+
+// the pool is never destroyed, owners with static storage may release their
+// textures during static destruction
+static auto pool() -> texture_pool&
+{
+    static auto& p = *new texture_pool{};
+    return p;
+}
+
+texture_owner::texture_owner() { pool().owners.push_back(this); }
+
+texture_owner::~texture_owner()
+{
+    auto& p = pool();
+    std::erase(p.owners, this);
+
+    auto left = std::vector<ImTextureID>{};
+    for (auto const& [tex, t] : p.textures)
+        if (t.owner == this)
+            left.push_back(tex);
+    for (auto tex : left)
+        p.destroy(tex);
+}
+
+auto create_texture(texture_owner& owner, int width, int height, void const* pixels)
+    -> ImTextureID
+{
+    auto const tex = Render::CreateTexture(width, height, pixels);
+    if (!tex)
+        return {};
+
+    auto& p = pool();
+    auto const bytes = std::size_t(width) * height * 4;
+    p.textures[tex] = texture_pool::texture{&owner, bytes};
+    p.bytes += bytes;
+    return tex;
+}
+
+void destroy_texture(ImTextureID tex)
+{
+    if (tex)
+        pool().destroy(tex);
+}
+
+void release_device_textures()
+{
+    auto& p = pool();
+    if (p.textures.empty())
+        return;
+
+    for (auto const& [tex, t] : p.textures)
+        Render::DestroyTexture(tex);
+    p.textures.clear();
+    p.bytes = 0;
+
+    for (auto o : p.owners)
+        o->textures_released();
+}
+
+auto device_texture_memory() -> std::size_t { return pool().bytes; }
+
+} // namespace ImPlus::internal
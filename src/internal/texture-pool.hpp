@@ -0,0 +1,44 @@
+#pragma once
+
+#include <imgui.h>
+
+#include <cstddef>
+
+namespace ImPlus::internal {
+
+// texture_owner is a cache that keeps renderer textures (SVG atlas pages,
+// TextureImage textures), all of them are created through create_texture so
+// that they live and die with the renderer
+//
+// - create_texture returns a null texture when there is no renderer or the
+//   texture can't be created, the owner then draws without caching
+// - release_device_textures destroys the textures of all owners, the renderers
+//   call it before they shut down; each owner is told with textures_released
+//   and creates its textures again when they are drawn next
+// - destroy_texture of a texture that was already released is a no-op, and
+//   the textures left by an owner are destroyed with it
+//
+struct texture_owner {
+    texture_owner();
+    virtual ~texture_owner();
+
+    texture_owner(texture_owner const&) = delete;
+    auto operator=(texture_owner const&) -> texture_owner& = delete;
+
+    // textures_released is called after all textures of the owner were
+    // destroyed by release_device_textures
+    virtual void textures_released() = 0;
+};
+
+auto create_texture(texture_owner& owner, int width, int height, void const* pixels = nullptr)
+    -> ImTextureID;
+void destroy_texture(ImTextureID tex);
+
+// release_device_textures is called by the renderers, before their textures
+// are gone
+void release_device_textures();
+
+// device_texture_memory returns the bytes of all textures in the pool
+auto device_texture_memory() -> std::size_t;
+
+} // namespace ImPlus::internal
@@ -3,7 +3,9 @@
 
 #include <imgui.h>
 #include <implus/blocks.hpp>
+#include <implus/draw-stats.hpp>
 #include <implus/menu.hpp>
+#include <implus/profiler.hpp>
 #include <implus/selbox.hpp>
 #include <optional>
 
@@ -84,6 +86,9 @@ void MenuTrailPlacement()
 
 auto BeginMenu(char const* label, bool enabled) -> bool
 {
+    IMPLUS_PROFILE_SCOPE("menu.begin");
+    IMPLUS_DRAW_SCOPE("menu.begin", ImGui::GetWindowDrawList());
+
     auto* ms = GetMenuState();
     if (!ms || ms->level == 0) {
         // outside of main menu bar
@@ -171,6 +176,9 @@ static bool _IsRootOfOpenMenuSet()
 auto MenuItem(ImPlus::ImID const& id, ImPlus::Icon const& icon, std::string_view caption,
     std::string_view shortcut, bool selected, bool enabled) -> bool
 {
+    IMPLUS_PROFILE_SCOPE("menu.item");
+    IMPLUS_DRAW_SCOPE("menu.item", ImGui::GetWindowDrawList());
+
     ImGuiWindow* window = ImGui::GetCurrentWindow();
     if (window->SkipItems)
         return false;
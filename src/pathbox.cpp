@@ -3,6 +3,7 @@
 
 #include "implus/dropdown.hpp"
 #include "implus/pathbox.hpp"
+#include "internal/advance-table.hpp"
 #include "internal/draw-utils.hpp"
 
 #include <cstdint>
@@ -16,7 +17,8 @@ inline auto measure_width(std::string_view s) -> float
 {
     if (s.empty())
         return 0.0f;
-    return ImGui::CalcTextSize(s.data(), s.data() + s.size(), false, 0.0f).x;
+    auto const& g = *GImGui;
+    return std::ceil(internal::measure_advance(*g.Font, g.FontSize, s));
 }
 
 auto DefaultHeightPixels() -> float
@@ -0,0 +1,222 @@
+#include <implus/profiler.hpp>
+
+#include <imgui.h>
+#include <imgui_internal.h>
+
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <cstdio>
+#include <vector>
+
+namespace ImPlus::Profiler {
+
+static constexpr auto history = 240; // frames
+
+template <typename T> using ring = std::array<T, history>;
+
+struct scope_stats {
+    char const* name = nullptr;
+    double frame_ms = 0.0; // accumulated in the current frame
+    int frame_calls = 0;
+    ring<float> ms = {};
+    ring<float> calls = {};
+};
+
+struct frame_stats {
+    ring<float> interval_ms = {};
+    ring<float> vertices = {};
+    ring<float> indices = {};
+    ring<float> draw_calls = {};
+};
+
+static auto scopes = std::vector<scope_stats>{};
+static auto frames = frame_stats{};
+static auto head = 0;   // slot of the next frame
+static auto filled = 0; // recorded frames, up to history
+static auto last_frame = clock::time_point{};
+
+// latency samples, one per frame that handled input
+static auto latency_ms = ring<float>{};
+static auto latency_head = 0;
+static auto latency_filled = 0;
+static auto input_polled = clock::time_point{};
+static auto input_taken = false;
+
+static auto to_ms(clock::duration d) -> double
+{
+    return std::chrono::duration<double, std::milli>(d).count();
+}
+
+auto RegisterScope(char const* name) -> int
+{
+    scopes.push_back({.name = name});
+    return int(scopes.size()) - 1;
+}
+
+void Record(int scope, clock::duration d)
+{
+    auto& s = scopes[scope];
+    s.frame_ms += to_ms(d);
+    ++s.frame_calls;
+}
+
+void PollInput()
+{
+    input_polled = clock::now();
+    input_taken = false;
+}
+
+auto TakeInput() -> std::optional<clock::time_point>
+{
+    auto const g = ImGui::GetCurrentContext();
+    if (input_taken || input_polled == clock::time_point{} || !g || g->InputEventsTrail.Size == 0)
+        return std::nullopt;
+    input_taken = true;
+    return input_polled;
+}
+
+void RecordLatency(clock::duration d)
+{
+    latency_ms[latency_head] = float(to_ms(d));
+    latency_head = (latency_head + 1) % history;
+    latency_filled = std::min(latency_filled + 1, history);
+}
+
+void EndFrame()
+{
+    auto const now = clock::now();
+    if (auto const polled = TakeInput())
+        RecordLatency(now - *polled);
+    auto const first = last_frame == clock::time_point{};
+    frames.interval_ms[head] = first ? 0.0f : float(to_ms(now - last_frame));
+    last_frame = now;
+
+    auto draw_calls = 0;
+    auto const dd = ImGui::GetDrawData();
+    if (dd && dd->Valid) {
+        for (auto i = 0; i < dd->CmdListsCount; ++i)
+            for (auto const& cmd : dd->CmdLists[i]->CmdBuffer)
+                if (cmd.ElemCount || cmd.UserCallback)
+                    ++draw_calls;
+    }
+    frames.vertices[head] = dd && dd->Valid ? float(dd->TotalVtxCount) : 0.0f;
+    frames.indices[head] = dd && dd->Valid ? float(dd->TotalIdxCount) : 0.0f;
+    frames.draw_calls[head] = float(draw_calls);
+
+    for (auto& s : scopes) {
+        s.ms[head] = float(s.frame_ms);
+        s.calls[head] = float(s.frame_calls);
+        s.frame_ms = 0.0;
+        s.frame_calls = 0;
+    }
+
+    head = (head + 1) % history;
+    filled = std::min(filled + 1, history);
+}
+
+void Reset()
+{
+    for (auto& s : scopes) {
+        s.frame_ms = 0.0;
+        s.frame_calls = 0;
+    }
+    head = 0;
+    filled = 0;
+    last_frame = {};
+    latency_head = 0;
+    latency_filled = 0;
+}
+
+struct summary {
+    float avg = 0.0f;
+    float p99 = 0.0f;
+    float max = 0.0f;
+};
+
+static auto summarize(ring<float> const& values, int count = filled) -> summary
+{
+    if (!count)
+        return {};
+
+    static auto scratch = std::vector<float>{};
+    scratch.assign(values.begin(), values.begin() + count);
+
+    auto ret = summary{};
+    auto sum = 0.0;
+    for (auto v : scratch) {
+        sum += v;
+        ret.max = std::max(ret.max, v);
+    }
+    ret.avg = float(sum / count);
+
+    auto const nth = scratch.begin() + std::ptrdiff_t(0.99 * (count - 1));
+    std::nth_element(scratch.begin(), nth, scratch.end());
+    ret.p99 = *nth;
+    return ret;
+}
+
+void ShowWindow(bool* p_open)
+{
+    ImGui::SetNextWindowSize({480, 420}, ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("ImPlus Profiler##implus-profiler", p_open)) {
+        ImGui::End();
+        return;
+    }
+
+    if (ImGui::Button("Reset"))
+        Reset();
+    ImGui::SameLine();
+    ImGui::Text("%d frames", filled);
+
+    auto const frame = summarize(frames.interval_ms);
+    char overlay[64];
+    snprintf(overlay, sizeof(overlay), "avg %.2f ms, p99 %.2f ms", frame.avg, frame.p99);
+    ImGui::PlotLines("##frame-ms", frames.interval_ms.data(), filled,
+        filled < history ? 0 : head, overlay, 0.0f, std::max(frame.max, 1.0f) * 1.1f,
+        ImVec2{-FLT_MIN, 80.0f});
+
+    auto const last = (head + history - 1) % history;
+    if (filled) {
+        ImGui::Text("vertices %.0f, indices %.0f, draw calls %.0f", frames.vertices[last],
+            frames.indices[last], frames.draw_calls[last]);
+    }
+    if (latency_filled) {
+        auto const lat = summarize(latency_ms, latency_filled);
+        ImGui::Text("input to render latency avg %.2f ms, p99 %.2f ms, max %.2f ms (%d frames)",
+            lat.avg, lat.p99, lat.max, latency_filled);
+    }
+
+    auto const flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg |
+                       ImGuiTableFlags_SizingStretchProp | ImGuiTableFlags_ScrollY;
+    if (ImGui::BeginTable("##scopes", 5, flags)) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Scope", ImGuiTableColumnFlags_WidthStretch, 3.0f);
+        ImGui::TableSetupColumn("Calls");
+        ImGui::TableSetupColumn("Avg ms");
+        ImGui::TableSetupColumn("p99 ms");
+        ImGui::TableSetupColumn("Max ms");
+        ImGui::TableHeadersRow();
+
+        for (auto const& s : scopes) {
+            auto const t = summarize(s.ms);
+            auto const c = summarize(s.calls);
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(s.name);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", c.avg);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", t.avg);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", t.p99);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", t.max);
+        }
+        ImGui::EndTable();
+    }
+
+    ImGui::End();
+}
+
+} // namespace ImPlus::Profiler
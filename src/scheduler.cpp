@@ -0,0 +1,74 @@
+#include <implus/application.hpp>
+#include <implus/scheduler.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <deque>
+#include <memory>
+
+namespace ImPlus::Scheduler {
+
+static auto queues = std::array<std::deque<Work>, 3>{}; // indexed by Priority
+static auto frame_budget = 0.004;
+
+void Schedule(Work work, Priority priority)
+{
+    if (work)
+        queues[std::size_t(priority)].push_back(std::move(work));
+}
+
+void Schedule(Task task, Priority priority)
+{
+    // std::function requires a copyable target
+    auto t = std::make_shared<Task>(std::move(task));
+    Schedule(
+        [t]() -> bool {
+            t->handle.resume();
+            if (!t->handle.done())
+                return false;
+            if (auto e = t->handle.promise().exception)
+                std::rethrow_exception(e);
+            return true;
+        },
+        priority);
+}
+
+void SetFrameBudget(double seconds) { frame_budget = std::max(seconds, 0.0); }
+
+auto GetFrameBudget() -> double { return frame_budget; }
+
+auto Pending() -> std::size_t
+{
+    auto n = std::size_t{0};
+    for (auto const& q : queues)
+        n += q.size();
+    return n;
+}
+
+auto Pending(Priority priority) -> std::size_t { return queues[std::size_t(priority)].size(); }
+
+void RunFrameSlice()
+{
+    using clock = std::chrono::steady_clock;
+    auto const end = clock::now() + std::chrono::duration<double>(frame_budget);
+
+    auto first = true;
+    for (auto& q : queues) {
+        while (!q.empty()) {
+            if (!first && clock::now() >= end)
+                break;
+            first = false;
+
+            auto work = std::move(q.front());
+            q.pop_front();
+            if (!work())
+                q.push_back(std::move(work));
+        }
+    }
+
+    if (Pending())
+        Application::RequestAnimationFrame(ImGui::GetTime());
+}
+
+} // namespace ImPlus::Scheduler
@@ -1,6 +1,7 @@
 #define IMGUI_DEFINE_MATH_OPERATORS
 #include <imgui_internal.h>
 
+#include "implus/draw-stats.hpp"
 #include "implus/selbox.hpp"
 
 #include <algorithm>
@@ -17,6 +18,8 @@ auto SelectableBox(ImID id, char const* name, bool selected, ImGuiSelectableFlag
     if (window->SkipItems)
         return state;
 
+    IMPLUS_DRAW_SCOPE("selectable.box", window->DrawList);
+
     auto& g = *GImGui;
     auto const& style = g.Style;
 
@@ -0,0 +1,185 @@
+#include <implus/svg.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <future>
+#include <unordered_map>
+#include <vector>
+
+#include "internal/image-atlas.hpp"
+#include "internal/svg.hpp"
+
+namespace ImPlus {
+
+// rasters of all SVG images, produced on the calling thread for the first
+// size of an image and on worker threads for later sizes; the atlas pages are
+// released when resources are reset
+struct svg_cache : public ResettableResource {
+    using key = internal::image_atlas::key;
+    using document_ptr = std::shared_ptr<internal::svg::document const>;
+
+    static constexpr int retry_frames = 60; // after an image did not fit into the atlas
+
+    struct job {
+        key k;
+        std::future<std::vector<std::uint8_t>> pixels;
+        bool abandoned = false; // the image is gone, the raster is dropped
+    };
+
+    internal::image_atlas atlas;
+    std::vector<job> jobs;
+    std::unordered_map<std::uint64_t, int> retry_after; // image id, frame
+    std::uint64_t next_id = 1;
+    int last_collect_frame = -1;
+
+    static auto rasterize(internal::svg::document const& doc, int w, int h)
+        -> std::vector<std::uint8_t>
+    {
+        auto pixels = std::vector<std::uint8_t>(std::size_t(w) * h * 4);
+        internal::svg::rasterize(doc, w, h, pixels.data(), w * 4);
+        return pixels;
+    }
+
+    auto can_insert(key const& k) -> bool
+    {
+        if (k.w > atlas.max_image_size() || k.h > atlas.max_image_size())
+            return false;
+        auto it = retry_after.find(k.id);
+        return it == retry_after.end() || ImGui::GetFrameCount() >= it->second;
+    }
+
+    auto insert(key const& k, std::vector<std::uint8_t> const& pixels)
+        -> internal::image_atlas::region const*
+    {
+        auto r = atlas.insert(k, pixels.data());
+        if (r)
+            retry_after.erase(k.id);
+        else
+            retry_after[k.id] = ImGui::GetFrameCount() + retry_frames;
+        return r;
+    }
+
+    // collect uploads the rasters finished by workers and drops finished
+    // jobs of destroyed images, once per frame
+    void collect()
+    {
+        auto const frame = ImGui::GetFrameCount();
+        if (frame == last_collect_frame)
+            return;
+        last_collect_frame = frame;
+
+        std::erase_if(jobs, [&](job& j) {
+            if (j.pixels.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+                return false;
+            if (!j.abandoned)
+                insert(j.k, j.pixels.get());
+            return true;
+        });
+    }
+
+    // request starts rasterizing on a worker, one size per image at a time
+    void request(key const& k, document_ptr const& doc)
+    {
+        if (!can_insert(k) || std::any_of(jobs.begin(), jobs.end(),
+                                  [&](job const& j) { return j.k.id == k.id && !j.abandoned; }))
+            return;
+        jobs.push_back(job{k, std::async(std::launch::async, [doc, w = k.w, h = k.h] {
+            return rasterize(*doc, w, h);
+        })});
+    }
+
+    // forget drops the rasters of an image, a running job is left to finish
+    // on its worker (it holds the document) rather than waited for
+    void forget(std::uint64_t id)
+    {
+        atlas.erase(id);
+        for (auto& j : jobs)
+            if (j.k.id == id)
+                j.abandoned = true;
+        retry_after.erase(id);
+    }
+
+    void Reset() override
+    {
+        atlas.clear();
+        retry_after.clear();
+    }
+};
+
+// the cache is created on first use and never destroyed, SvgImage objects with
+// static storage may be created before and destroyed after it
+static auto rasters() -> svg_cache&
+{
+    static auto& cache = *new svg_cache{};
+    return cache;
+}
+
+SvgImage::SvgImage(std::string_view svg, length width, length height)
+    : doc_{std::make_shared<internal::svg::document const>(internal::svg::parse(svg))}
+    , id_{rasters().next_id++}
+    , width_{width}
+    , height_{height}
+{
+}
+
+SvgImage::~SvgImage() { rasters().forget(id_); }
+
+auto SvgImage::GetSize() -> ImVec2
+{
+    auto w = to_pt(width_);
+    auto h = to_pt(height_);
+    auto const& size = doc_->size;
+    if (w <= 0.0f && h <= 0.0f)
+        return size;
+    if ((w <= 0.0f || h <= 0.0f) && (size.x <= 0.0f || size.y <= 0.0f))
+        return {0, 0}; // no aspect ratio to follow
+    if (w <= 0.0f)
+        w = h * size.x / size.y;
+    else if (h <= 0.0f)
+        h = w * size.y / size.x;
+    return {w, h};
+}
+
+void SvgImage::Render(ImDrawList* dl, ImVec2 const& xy, ImU32 clr)
+{
+    auto const sz = GetSize();
+    auto const fb_scale = ImGui::GetIO().DisplayFramebufferScale;
+    auto const k = svg_cache::key{
+        id_, int(std::ceil(sz.x * fb_scale.x)), int(std::ceil(sz.y * fb_scale.y))};
+    if (k.w <= 0 || k.h <= 0)
+        return;
+
+    auto& cache = rasters();
+    cache.collect();
+
+    auto r = cache.atlas.find(k);
+    auto exact = r != nullptr;
+    if (!r && shown_w_ > 0) {
+        // keep drawing the previous size until the new one is ready
+        r = cache.atlas.find(svg_cache::key{id_, shown_w_, shown_h_});
+        if (r)
+            cache.request(k, doc_);
+    }
+    if (!r && cache.can_insert(k)) {
+        r = cache.insert(k, svg_cache::rasterize(*doc_, k.w, k.h));
+        exact = r != nullptr;
+    }
+    if (!r)
+        return;
+
+    if (exact) {
+        shown_w_ = k.w;
+        shown_h_ = k.h;
+    }
+
+    auto const tint =
+        doc_->monochrome ? clr : (clr & IM_COL32_A_MASK) | (IM_COL32_WHITE & ~IM_COL32_A_MASK);
+    dl->AddImage(r->texture, xy, {xy.x + sz.x, xy.y + sz.y}, r->uv0, r->uv1, tint);
+}
+
+void SvgImage::SetCacheBudget(std::size_t bytes) { rasters().atlas.set_budget(bytes); }
+
+auto SvgImage::CacheMemoryUsage() -> std::size_t { return rasters().atlas.memory_usage(); }
+
+} // namespace ImPlus
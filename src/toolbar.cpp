@@ -1,9 +1,12 @@
 #define IMGUI_DEFINE_MATH_OPERATORS
 #include <imgui_internal.h>
 
+#include "implus/alloc-tracker.hpp"
 #include "implus/blocks.hpp"
 #include "implus/button.hpp"
+#include "implus/draw-stats.hpp"
 #include "implus/dropdown.hpp"
+#include "implus/profiler.hpp"
 #include "implus/toolbar.hpp"
 
 namespace ImPlus::Toolbar {
@@ -89,6 +92,7 @@ auto calc_effective_padding(Options const& opts) -> ImVec2
 
 auto BeginEx(ImID id, ImVec2 const& size, Axis item_stacking, Options const& opts) -> bool
 {
+    IMPLUS_ALLOC_SCOPE("toolbar.state");
     IM_ASSERT(id != 0);
 
     auto& ts = get_toolbar_state();
@@ -211,6 +215,7 @@ auto Begin(ImID id, Axis item_stacking, Options const& opts) -> bool
 
 void End(bool remove_spacing)
 {
+    IMPLUS_ALLOC_SCOPE("toolbar.state");
     auto& ts = get_toolbar_state();
     IM_ASSERT_USER_ERROR(
         ts.placement != placement_not_in_toolbar, "Calling Toolbar::End() too many times");
@@ -458,6 +463,10 @@ auto make_button(ImPlus::ICD_view const& content, bool selected, bool enabled,
     ImGuiButtonFlags flags, ButtonOptions const& opts, bool as_dropdown,
     bool with_dropdown_arrow = true) -> bool
 {
+    IMPLUS_PROFILE_SCOPE("toolbar.button");
+    IMPLUS_ALLOC_SCOPE("toolbar.state");
+    IMPLUS_DRAW_SCOPE("toolbar.button", ImGui::GetWindowDrawList());
+
     // normally this function returns true if the button was pressed.
     //
     // however, if the button is placed into an overflow menu, and as_dropdown =
@@ -2,6 +2,7 @@
 #include <imgui_internal.h>
 
 #include <cmath>
+#include <implus/application.hpp>
 #include <implus/touchscroll.hpp>
 
 /*
@@ -246,6 +247,8 @@ void UpdateTouchScrolling()
         drag_delta = TouchScroller.UpdateScrollOffset();
         if (!drag_delta.x && !drag_delta.y)
             StopTouchScrolling();
+        else if (TouchScroller.IsKinetic())
+            Application::RequestAnimationFrame(g.Time);
     }
 
     if (TouchScrollingWindow) {
@@ -98,7 +98,9 @@ auto SetupFrame(Host::Window::Scale const& scale) -> bool
         Theme::current.apply(sty);
         sty.ScaleAllSizes(zoom_factor * scale.dpi * scale.fb_scale / 96.0f);
         ImPlus::ResettableResource::ResetAll();
-        ImPlus::Host::InvalidateDeviceObjects();
+        // a rescaled distance field atlas keeps its texture
+        if (!rebuild || !ImPlus::Font::GetSetupTimings().Rescaled)
+            ImPlus::Host::InvalidateDeviceObjects();
     }
     return rebuild;
 }